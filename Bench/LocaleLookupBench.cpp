@@ -0,0 +1,163 @@
+// Compares LocalisationManager's flattened locale pack lookups against the original
+// per-call DOM walk (split on '.', HasMember/operator[] at every level).
+//
+// Usage: CosmicCitiesLocaleBench [locale.json]
+// Without an argument a synthetic locale shaped like Content/locales is generated.
+
+#include "managers/LocalisationManager.h"
+#include "rapidjson/istreamwrapper.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr size_t LOOKUPS = 1'000'000;
+
+// The lookup LocalisationManager::get used before the flattened index existed
+std::string legacyGet(const rapidjson::Document& doc, const std::string& key, const std::string& fallback) {
+    if (doc.IsNull() || !doc.IsObject())
+        return fallback;
+
+    const rapidjson::Value* current = &doc;
+
+    std::stringstream ss(key);
+    std::string token;
+
+    while (std::getline(ss, token, '.')) {
+        if (!current->IsObject() || !current->HasMember(token.c_str()))
+            return fallback;
+        current = &(*current)[token.c_str()];
+    }
+
+    if (current->IsString())
+        return current->GetString();
+
+    return fallback;
+}
+
+void collectKeys(const rapidjson::Value& node, const std::string& prefix, std::vector<std::string>& out) {
+    for (auto it = node.MemberBegin(); it != node.MemberEnd(); ++it) {
+        std::string key = prefix.empty() ? it->name.GetString() : prefix + "." + it->name.GetString();
+        if (it->value.IsObject())
+            collectKeys(it->value, key, out);
+        else if (it->value.IsString())
+            out.push_back(std::move(key));
+    }
+}
+
+std::filesystem::path writeSyntheticLocale() {
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+
+    // ui.<group>.<item> plus story.chapter.c<n>.{number,name}, mirroring the shipped layout
+    writer.StartObject();
+    writer.Key("ui");
+    writer.StartObject();
+    for (int g = 0; g < 40; ++g) {
+        writer.Key(fmt::format("group-{:02d}", g).c_str());
+        writer.StartObject();
+        for (int i = 0; i < 50; ++i) {
+            writer.Key(fmt::format("item-{:03d}", i).c_str());
+            writer.String(fmt::format("Localised text for group {} item {}", g, i).c_str());
+        }
+        writer.EndObject();
+    }
+    writer.EndObject();
+    writer.Key("story");
+    writer.StartObject();
+    writer.Key("chapter");
+    writer.StartObject();
+    for (int c = 1; c <= 30; ++c) {
+        writer.Key(fmt::format("c{}", c).c_str());
+        writer.StartObject();
+        writer.Key("number");
+        writer.String(fmt::format("Chapter {}", c).c_str());
+        writer.Key("name");
+        writer.String(fmt::format("The {}th Orbit", c).c_str());
+        writer.EndObject();
+    }
+    writer.EndObject();
+    writer.EndObject();
+    writer.EndObject();
+
+    auto path = std::filesystem::temp_directory_path() / "cc-locale-bench.json";
+    std::ofstream(path, std::ios::binary) << buffer.GetString();
+    return path;
+}
+
+template <typename Fn>
+double timeLookups(const char* name, const std::vector<const std::string*>& order, Fn&& fn) {
+    size_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto* key : order) {
+        checksum += fn(*key);
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("%-24s %10.2f ms  %8.1f ns/lookup  (checksum %zu)\n", name, elapsed / 1e6, elapsed / order.size(),
+                checksum);
+    return elapsed;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::filesystem::path localePath = argc > 1 ? std::filesystem::path(argv[1]) : writeSyntheticLocale();
+
+    auto& lm = LocalisationManager::instance();
+    if (!lm.setLanguage(localePath.string())) {
+        std::fprintf(stderr, "failed to load %s\n", localePath.string().c_str());
+        return 1;
+    }
+
+    rapidjson::Document legacyDoc;
+    {
+        std::ifstream file(localePath);
+        rapidjson::IStreamWrapper isw(file);
+        legacyDoc.ParseStream(isw);
+    }
+
+    std::vector<std::string> keys;
+    collectKeys(legacyDoc, "", keys);
+    if (keys.empty()) {
+        std::fprintf(stderr, "no string keys in %s\n", localePath.string().c_str());
+        return 1;
+    }
+    keys.push_back("ui.missing.key");
+
+    std::mt19937 rng(1337);
+    std::uniform_int_distribution<size_t> pick(0, keys.size() - 1);
+    std::vector<const std::string*> order(LOOKUPS);
+    for (auto& k : order) {
+        k = &keys[pick(rng)];
+    }
+
+    std::printf("%zu keys, %zu lookups\n", keys.size(), LOOKUPS);
+
+    const double legacy = timeLookups("legacy DOM walk", order, [&](const std::string& key) {
+        return legacyGet(legacyDoc, key, "").size();
+    });
+    const double flatGet = timeLookups("flat get()", order, [&](const std::string& key) {
+        return lm.get(key).size();
+    });
+    const double flatView = timeLookups("flat view()", order, [&](const std::string& key) {
+        return lm.view(LocaleKey(key)).size();
+    });
+
+    constexpr auto literal = "ui.group-00.item-000"_lk;
+    timeLookups("flat view() literal", order, [&](const std::string&) {
+        return lm.view(literal).size();
+    });
+
+    std::printf("speedup: get() %.1fx, view() %.1fx\n", legacy / flatGet, legacy / flatView);
+    return 0;
+}
@@ -0,0 +1,321 @@
+// Latency and allocation baseline for the game-side managers at production scale:
+// SaveManager with 100k keys, LocalisationManager with a 50k string locale and
+// DialogManager with a 10k node script. No window or rendering context is needed.
+//
+// Usage: CosmicCitiesManagerBench [--out file.json]
+// Every operation is timed on its own; the table goes to stderr and the JSON report
+// (percentiles in nanoseconds, heap allocations per operation) to stdout or --out.
+
+#include "managers/SaveManager.h"
+#include "managers/LocalisationManager.h"
+#include "dialog/DialogManager.h"
+#include "base/FrameArena.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr size_t SAVE_KEYS = 100'000;
+constexpr size_t LOCALE_GROUPS = 500;
+constexpr size_t LOCALE_ITEMS = 100; // 50k strings
+constexpr size_t DIALOG_NODES = 10'000;
+constexpr size_t LOOKUPS = 1'000'000;
+constexpr uint32_t SEED = 1337;
+
+#if !AX_ENABLE_HEAP_ALLOCATION_COUNTER
+std::atomic<uint64_t> s_allocations{0};
+#endif
+
+uint64_t allocationCount() {
+#if AX_ENABLE_HEAP_ALLOCATION_COUNTER
+    return ax::FrameArena::getHeapAllocationCount();
+#else
+    return s_allocations.load(std::memory_order_relaxed);
+#endif
+}
+
+struct Result {
+    std::string name;
+    size_t ops{0};
+    double p50{0}, p95{0}, p99{0}, max{0}, mean{0};
+    double allocsPerOp{0};
+};
+
+std::vector<Result> g_results;
+
+// Runs fn(i) for i in [0, ops) and records the latency of every call
+template <typename Fn>
+void measure(const std::string& name, size_t ops, Fn&& fn) {
+    std::vector<uint64_t> samples(ops);
+
+    auto allocations = allocationCount();
+    for (size_t i = 0; i < ops; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        fn(i);
+        samples[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+                         .count();
+    }
+    allocations = allocationCount() - allocations;
+
+    std::sort(samples.begin(), samples.end());
+    auto rank = [&](double p) {
+        return (double)samples[std::min(ops - 1, (size_t)(p * ops + 0.999999) - 1)];
+    };
+    double total = 0;
+    for (auto s : samples)
+        total += s;
+
+    Result r;
+    r.name = name;
+    r.ops = ops;
+    r.p50 = rank(0.50);
+    r.p95 = rank(0.95);
+    r.p99 = rank(0.99);
+    r.max = (double)samples.back();
+    r.mean = total / ops;
+    r.allocsPerOp = (double)allocations / ops;
+
+    std::fprintf(stderr, "%-36s %9zu ops %12.0f %12.0f %12.0f %14.0f %10.2f\n", r.name.c_str(), r.ops, r.p50, r.p95,
+                 r.p99, r.max, r.allocsPerOp);
+    g_results.push_back(std::move(r));
+}
+
+std::filesystem::path scratchDir() {
+    auto dir = std::filesystem::temp_directory_path() / "cc-manager-bench";
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+void benchSave() {
+    using cosmiccities::SaveManager;
+    auto& save = SaveManager::instance();
+
+    auto dir = scratchDir() / "saves";
+    std::filesystem::remove_all(dir);
+    save.initialize(dir.string());
+    if (!save.createNewSlot(0, "Bench")) {
+        std::fprintf(stderr, "SaveManager: could not create a slot in %s\n", dir.string().c_str());
+        return;
+    }
+
+    std::vector<std::string> keys(SAVE_KEYS);
+    for (size_t i = 0; i < SAVE_KEYS; ++i)
+        keys[i] = fmt::format("world.region-{:03d}.entity-{:05d}.state", i % 500, i);
+
+    save.beginTransaction();
+    measure("save.setString (transaction)", SAVE_KEYS, [&](size_t i) { save.setString(keys[i], "visited"); });
+    save.commitTransaction();
+
+    save.beginTransaction();
+    measure("save.setInt (transaction)", SAVE_KEYS, [&](size_t i) { save.setInt(keys[i], (int64_t)i); });
+    save.commitTransaction();
+
+    measure("save.setFloat (autocommit)", 10'000, [&](size_t i) { save.setFloat(keys[i], i * 0.5); });
+
+    std::mt19937 rng(SEED);
+    std::uniform_int_distribution<size_t> pick(0, SAVE_KEYS - 1);
+    std::vector<size_t> order(SAVE_KEYS);
+    for (auto& k : order)
+        k = pick(rng);
+
+    measure("save.getString", SAVE_KEYS, [&](size_t i) { save.getString(keys[order[i]]); });
+    measure("save.getInt", SAVE_KEYS, [&](size_t i) { save.getInt(keys[order[i]]); });
+    measure("save.getInt (missing)", SAVE_KEYS, [&](size_t i) { save.getInt("missing.key", -1); });
+
+    measure("save.saveSlot", 10, [&](size_t) { save.saveSlot(0); });
+    measure("save.loadSlot", 10, [&](size_t) { save.loadSlot(0); });
+
+    save.closeCurrentSlot();
+    save.deleteSlot(0);
+}
+
+std::filesystem::path writeLocale() {
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    writer.StartObject();
+    writer.Key("ui");
+    writer.StartObject();
+    for (size_t g = 0; g < LOCALE_GROUPS; ++g) {
+        writer.Key(fmt::format("group-{:03d}", g).c_str());
+        writer.StartObject();
+        for (size_t i = 0; i < LOCALE_ITEMS; ++i) {
+            writer.Key(fmt::format("item-{:03d}", i).c_str());
+            writer.String(fmt::format("Localised text {} for group {}, {{}} collected", i, g).c_str());
+        }
+        writer.EndObject();
+    }
+    writer.EndObject();
+    writer.EndObject();
+
+    auto path = scratchDir() / "cc-bench-locale.json";
+    std::ofstream(path, std::ios::binary) << buffer.GetString();
+    return path;
+}
+
+void benchLocale() {
+    auto& lm = LocalisationManager::instance();
+    auto path = writeLocale();
+    auto writable = ax::FileUtils::getInstance()->getWritablePath();
+    auto cachedPack = std::filesystem::path(writable) / "locales" / (path.stem().string() + LocalePack::EXTENSION);
+
+    measure("locale.setLanguage (compile pack)", 3, [&](size_t) {
+        std::error_code ec;
+        std::filesystem::remove(cachedPack, ec);
+        lm.setLanguage(path.string());
+    });
+    measure("locale.setLanguage (cached pack)", 20, [&](size_t) { lm.setLanguage(path.string()); });
+
+    std::vector<std::string> keys;
+    keys.reserve(LOCALE_GROUPS * LOCALE_ITEMS);
+    for (size_t g = 0; g < LOCALE_GROUPS; ++g)
+        for (size_t i = 0; i < LOCALE_ITEMS; ++i)
+            keys.push_back(fmt::format("ui.group-{:03d}.item-{:03d}", g, i));
+
+    std::mt19937 rng(SEED);
+    std::uniform_int_distribution<size_t> pick(0, keys.size() - 1);
+    std::vector<uint32_t> order(LOOKUPS);
+    for (auto& k : order)
+        k = (uint32_t)pick(rng);
+
+    measure("locale.get", LOOKUPS, [&](size_t i) { lm.get(keys[order[i]]); });
+    measure("locale.get (missing)", LOOKUPS / 10, [&](size_t) { lm.get("ui.missing.key", "fallback"); });
+    measure("locale.view", LOOKUPS, [&](size_t i) { lm.view(LocaleKey(keys[order[i]])); });
+    // createLabel needs a rendering context; this is the text preparation it does before building the label
+    measure("locale.get formatted", LOOKUPS / 10, [&](size_t i) {
+        int count = (int)i;
+        lm.get(keys[order[i]], "", count);
+    });
+}
+
+std::filesystem::path writeDialog() {
+    auto path = scratchDir() / "cc-bench-dialog.lua";
+    std::ofstream out(path, std::ios::binary);
+    out << "return {\n";
+    for (size_t i = 1; i <= DIALOG_NODES; ++i) {
+        out << fmt::format("  {{ id = {}, speaker = \"Speaker {}\", text = \"Line {} of the benchmark dialog.\"", i,
+                           i % 8, i);
+        // every tenth node branches; both branches rejoin the sequence
+        if (i % 10 == 0 && i + 2 <= DIALOG_NODES)
+            out << fmt::format(", choices = {{ {{ text = \"Go on\", next = {} }}, {{ text = \"Skip\", next = {} }} }}",
+                               i + 1, i + 2);
+        out << " },\n";
+    }
+    out << "}\n";
+    return path;
+}
+
+void benchDialog() {
+    using cosmiccities::DialogGraph;
+    auto& dm = cosmiccities::DialogManager::get();
+    auto path = writeDialog();
+    auto cache = DialogGraph::cachePathFor(path);
+
+    measure("dialog.startDialogue (compile)", 3, [&](size_t) {
+        std::error_code ec;
+        std::filesystem::remove(cache, ec);
+        dm.startDialogue(path);
+    });
+    measure("dialog.startDialogue (cached)", 20, [&](size_t) { dm.startDialogue(path); });
+
+    dm.startDialogue(path);
+    measure("dialog.advance", DIALOG_NODES * 10, [&](size_t i) {
+        if (!dm.isActive())
+            dm.startDialogue(path);
+        dm.advance(dm.hasChoices() ? (int)(i & 1) : -1);
+    });
+    dm.endDialogue();
+}
+
+std::string toJson() {
+    std::string out = "{\"benchmarks\":[\n";
+    for (size_t i = 0; i < g_results.size(); ++i) {
+        const auto& r = g_results[i];
+        out += fmt::format("{{\"name\":\"{}\",\"ops\":{},\"p50Ns\":{:.0f},\"p95Ns\":{:.0f},\"p99Ns\":{:.0f},"
+                           "\"maxNs\":{:.0f},\"meanNs\":{:.1f},\"allocsPerOp\":{:.3f}}}{}\n",
+                           r.name, r.ops, r.p50, r.p95, r.p99, r.max, r.mean, r.allocsPerOp,
+                           i + 1 < g_results.size() ? "," : "");
+    }
+    out += "]}\n";
+    return out;
+}
+
+} // namespace
+
+#if !AX_ENABLE_HEAP_ALLOCATION_COUNTER
+// The engine counts allocations itself when built with AX_ENABLE_HEAP_ALLOCATION_COUNTER
+void* operator new(std::size_t size) {
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return ::operator new(size, tag);
+}
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+#endif
+
+int main(int argc, char** argv) {
+    std::string outPath;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "--out" && i + 1 < argc) {
+            outPath = argv[++i];
+        } else {
+            std::fprintf(stderr, "usage: %s [--out file.json]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::fprintf(stderr, "%-36s %13s %12s %12s %12s %14s %10s\n", "benchmark (ns)", "", "p50", "p95", "p99", "max",
+                 "allocs/op");
+
+    benchSave();
+    benchLocale();
+    benchDialog();
+
+    auto json = toJson();
+    if (outPath.empty()) {
+        std::fputs(json.c_str(), stdout);
+    } else if (!(std::ofstream(outPath, std::ios::binary) << json)) {
+        std::fprintf(stderr, "failed to write %s\n", outPath.c_str());
+        return 1;
+    }
+    return 0;
+}
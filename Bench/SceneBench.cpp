@@ -0,0 +1,505 @@
+// Headless frame cost benchmark for the game scenes.
+//
+// Boots the Director behind a hidden, vsync-less window, steps every scenario with a fixed
+// delta time and a fixed random seed, and reports the per-phase CPU time collected by
+// ax::FrameStats as JSON. Without a GPU, run it under a virtual X server with Mesa's software
+// rasteriser:
+//
+//   LIBGL_ALWAYS_SOFTWARE=1 xvfb-run -s "-screen 0 1280x1024x24" ./CosmicCitiesBench --out bench.json
+//
+// Usage: CosmicCitiesBench [--frames N] [--warmup N] [--seed N] [--only name[,name...]]
+//                          [--root dir] [--out file] [--list]
+//
+// Scenarios are run in order in the same process; compare the output of two builds on the same
+// machine rather than absolute numbers across machines.
+
+#include "Includes.hpp"
+#include "layers/SavePickerLayer.h"
+
+#if defined(AX_ENABLE_EXT_PARTICLE3D)
+#include "Particle3D/PU/PUColorAffector.h"
+#include "Particle3D/PU/PUDynamicAttribute.h"
+#include "Particle3D/PU/PUGravityAffector.h"
+#include "Particle3D/PU/PULinearForceAffector.h"
+#include "Particle3D/PU/PUParticleSystem3D.h"
+#include "Particle3D/PU/PUPointEmitter.h"
+#include "Particle3D/PU/PURender.h"
+#include "Particle3D/PU/PUScaleAffector.h"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef COSMIC_CITIES_ROOT
+#define COSMIC_CITIES_ROOT "."
+#endif
+
+using namespace ax;
+
+namespace {
+
+constexpr float FIXED_DT = 1.0f / 60.0f;
+const Size DESIGN_SIZE(480, 360);
+
+struct Options {
+    int frames{600};
+    int warmup{60};
+    uint32_t seed{1337};
+    std::string only;
+    std::string out;
+    std::string root{COSMIC_CITIES_ROOT};
+    bool list{false};
+};
+
+struct Scenario {
+    const char* name;
+    std::function<Scene*()> create;
+    // Loading advances on its own and then leaves for the save picker, so it is measured
+    // from the first frame until the scene changes (or the frame budget runs out)
+    bool untilSceneChange{false};
+};
+
+std::mt19937& rng() {
+    static std::mt19937 engine;
+    return engine;
+}
+
+float randomReal(float min, float max) {
+    return std::uniform_real_distribution<float>(min, max)(rng());
+}
+
+// Moves plain sprites around the screen, wrapping at the edges
+class SpriteStress : public Node {
+public:
+    static SpriteStress* create(int count) {
+        auto node = new SpriteStress();
+        node->init(count);
+        node->autorelease();
+        return node;
+    }
+
+    void update(float dt) override {
+        auto size = Director::getInstance()->getWinSize();
+        for (size_t i = 0; i < _sprites.size(); ++i) {
+            auto pos = _sprites[i]->getPosition() + _velocities[i] * dt;
+            if (pos.x < 0.f) pos.x += size.width;
+            if (pos.x > size.width) pos.x -= size.width;
+            if (pos.y < 0.f) pos.y += size.height;
+            if (pos.y > size.height) pos.y -= size.height;
+            _sprites[i]->setPosition(pos);
+            _sprites[i]->setRotation(_sprites[i]->getRotation() + 90.f * dt);
+        }
+    }
+
+private:
+    void init(int count) {
+        Node::init();
+        auto size = Director::getInstance()->getWinSize();
+        _sprites.reserve(count);
+        _velocities.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            auto sprite = Sprite::create();
+            sprite->setTextureRect(Rect(0, 0, 4, 4));
+            sprite->setColor(Color3B(static_cast<uint8_t>(randomReal(64.f, 255.f)), 200, 255));
+            sprite->setPosition(randomReal(0.f, size.width), randomReal(0.f, size.height));
+            addChild(sprite);
+            _sprites.push_back(sprite);
+            _velocities.emplace_back(randomReal(-60.f, 60.f), randomReal(-60.f, 60.f));
+        }
+        scheduleUpdate();
+    }
+
+    std::vector<Sprite*> _sprites;
+    std::vector<Vec2> _velocities;
+};
+
+// Labels whose text changes every few frames, exercising layout and glyph lookups
+class LabelStress : public Node {
+public:
+    static LabelStress* create(int count) {
+        auto node = new LabelStress();
+        node->init(count);
+        node->autorelease();
+        return node;
+    }
+
+    void update(float) override {
+        // a tenth of the labels relayout every frame
+        for (size_t i = _frame % 10; i < _labels.size(); i += 10)
+            _labels[i]->setString(fmt::format("{}:{}", i, _frame));
+        ++_frame;
+    }
+
+private:
+    void init(int count) {
+        Node::init();
+        auto size = Director::getInstance()->getWinSize();
+        const char* bmfont = "fonts/pixel_operator/pixel_operator.fnt";
+        bool useBMFont = FileUtils::getInstance()->isFileExist(bmfont);
+
+        _labels.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            auto text = std::to_string(i);
+            auto label = useBMFont ? Label::createWithBMFont(bmfont, text) : Label::createWithSystemFont(text, "", 10);
+            if (!label)
+                break;
+            label->setScale(0.5f);
+            label->setPosition(randomReal(0.f, size.width), randomReal(0.f, size.height));
+            addChild(label);
+            _labels.push_back(label);
+        }
+        scheduleUpdate();
+    }
+
+    std::vector<Label*> _labels;
+    uint32_t _frame{0};
+};
+
+Scene* createSpriteStress() {
+    auto scene = Scene::create();
+    scene->addChild(SpriteStress::create(10'000));
+    return scene;
+}
+
+Scene* createEmitterStress() {
+    auto scene = Scene::create();
+    auto size = Director::getInstance()->getWinSize();
+    for (int i = 0; i < 100; ++i) {
+        ParticleSystemQuad* emitter = (i % 2) ? static_cast<ParticleSystemQuad*>(ParticleFire::create())
+                                              : static_cast<ParticleSystemQuad*>(ParticleGalaxy::create());
+        emitter->setPosition((i % 10 + 0.5f) * size.width / 10, (i / 10 + 0.5f) * size.height / 10);
+        scene->addChild(emitter);
+    }
+    return scene;
+}
+
+Scene* createLabelStress() {
+    auto scene = Scene::create();
+    scene->addChild(LabelStress::create(5'000));
+    return scene;
+}
+
+#if defined(AX_ENABLE_PHYSICS)
+Scene* createPhysicsStress() {
+    auto scene = Scene::createWithPhysics();
+    auto size = Director::getInstance()->getWinSize();
+
+    auto bounds = Node::create();
+    bounds->setPosition(size.width * 0.5f, size.height * 0.5f);
+    bounds->setPhysicsBody(PhysicsBody::createEdgeBox(size));
+    scene->addChild(bounds);
+
+    for (int i = 0; i < 5'000; ++i) {
+        auto body = Sprite::create();
+        body->setTextureRect(Rect(0, 0, 3, 3));
+        body->setPosition(randomReal(4.f, size.width - 4.f), randomReal(4.f, size.height - 4.f));
+        body->setPhysicsBody(PhysicsBody::createCircle(1.5f));
+        scene->addChild(body);
+    }
+    return scene;
+}
+#endif
+
+#if defined(AX_ENABLE_EXT_PARTICLE3D)
+PUDynamicAttribute* fixedAttribute(float value) {
+    auto attribute = new PUDynamicAttributeFixed();
+    attribute->setValue(value);
+    return attribute;
+}
+
+PUDynamicAttribute* randomAttribute(float min, float max) {
+    auto attribute = new PUDynamicAttributeRandom();
+    attribute->setMinMax(min, max);
+    return attribute;
+}
+
+// A fountain that settles at 15k live quads, run through the gravity, force, scale and colour affectors
+PUParticleSystem3D* createParticleFountain(bool batched) {
+    auto system = PUParticleSystem3D::create();
+    system->setParticleQuota(15'000);
+    system->setDefaultWidth(3.f);
+    system->setDefaultHeight(3.f);
+    system->setAffectorBatchingEnabled(batched);
+
+    auto emitter = PUPointEmitter::create();
+    emitter->setDynEmissionRate(fixedAttribute(7'500.f));
+    emitter->setDynTotalTimeToLive(fixedAttribute(2.f));
+    emitter->setDynVelocity(randomAttribute(40.f, 80.f));
+    emitter->setDynAngle(fixedAttribute(30.f));
+    emitter->setParticleDirection(Vec3(0.f, 1.f, 0.f));
+    system->addEmitter(emitter);
+
+    auto gravity = PUGravityAffector::create();
+    gravity->setGravity(2'000.f);
+    gravity->setLocalPosition(Vec3(0.f, -120.f, 0.f));
+    system->addAffector(gravity);
+
+    auto wind = PULinearForceAffector::create();
+    wind->setForceVector(Vec3(15.f, -30.f, 0.f));
+    system->addAffector(wind);
+
+    auto scale = PUScaleAffector::create();
+    scale->setDynScaleXYZ(fixedAttribute(2.f));
+    system->addAffector(scale);
+
+    auto color = PUColorAffector::create();
+    color->addColor(0.f, Vec4(1.f, 0.9f, 0.4f, 1.f));
+    color->addColor(0.5f, Vec4(1.f, 0.4f, 0.1f, 0.8f));
+    color->addColor(1.f, Vec4(0.2f, 0.2f, 0.2f, 0.f));
+    system->addAffector(color);
+
+    system->setRender(PUParticle3DQuadRender::create());
+    return system;
+}
+
+Scene* createParticle3DStress(bool batched) {
+    auto scene = Scene::create();
+    auto size = Director::getInstance()->getWinSize();
+    for (int i = 0; i < 4; ++i) {
+        auto system = createParticleFountain(batched);
+        system->setPosition((i + 0.5f) * size.width / 4, size.height * 0.25f);
+        scene->addChild(system);
+        system->startParticleSystem();
+    }
+    return scene;
+}
+
+// Every .pu template under Content/particles3d, side by side; an empty scene when none ship
+Scene* createParticle3DTemplates() {
+    auto scene = Scene::create();
+    auto size = Director::getInstance()->getWinSize();
+
+    std::vector<std::string> scripts;
+    std::error_code ec;
+    for (std::filesystem::recursive_directory_iterator it("Content/particles3d", ec), end; !ec && it != end;
+         it.increment(ec)) {
+        if (it->is_regular_file() && it->path().extension() == ".pu")
+            scripts.push_back(it->path().generic_string());
+    }
+    std::sort(scripts.begin(), scripts.end());
+
+    for (size_t i = 0; i < scripts.size(); ++i) {
+        auto system = PUParticleSystem3D::create(scripts[i]);
+        if (!system)
+            continue;
+        system->setPosition((i % 8 + 0.5f) * size.width / 8, (i / 8 % 6 + 0.5f) * size.height / 6);
+        scene->addChild(system);
+        system->startParticleSystem();
+    }
+    return scene;
+}
+#endif
+
+std::vector<Scenario> scenarios() {
+    std::vector<Scenario> list = {
+        {"LoadingLayer", [] { return cosmiccities::LoadingLayer::scene(); }, true},
+        {"MenuLayer", [] { return cosmiccities::MenuLayer::scene(); }},
+        {"SavePickerLayer", [] { return cosmiccities::SavePickerLayer::scene(); }},
+        {"Stress.Sprites10k", createSpriteStress},
+        {"Stress.Emitters100", createEmitterStress},
+        {"Stress.Labels5k", createLabelStress},
+#if defined(AX_ENABLE_PHYSICS)
+        {"Stress.PhysicsBodies5k", createPhysicsStress},
+#endif
+#if defined(AX_ENABLE_EXT_PARTICLE3D)
+        {"Stress.PU60k", [] { return createParticle3DStress(true); }},
+        {"Stress.PU60k.Scalar", [] { return createParticle3DStress(false); }},
+        {"PU.Templates", createParticle3DTemplates},
+#endif
+    };
+    return list;
+}
+
+bool selected(const Options& options, std::string_view name) {
+    if (options.only.empty())
+        return true;
+    std::string_view only = options.only;
+    while (!only.empty()) {
+        auto comma = only.find(',');
+        if (only.substr(0, comma) == name)
+            return true;
+        if (comma == std::string_view::npos)
+            break;
+        only.remove_prefix(comma + 1);
+    }
+    return false;
+}
+
+void seed(uint32_t value) {
+    rng().seed(value);
+    RandomHelper::seed(value);
+    std::srand(value);
+}
+
+std::string runScenario(const Scenario& scenario, const Options& options) {
+    auto director = Director::getInstance();
+    auto stats = director->getFrameStats();
+
+    seed(options.seed);
+    auto scene = scenario.create();
+    if (director->getRunningScene())
+        director->replaceScene(scene);
+    else
+        director->runWithScene(scene);
+
+    // the scene becomes the running one during the next frame
+    director->mainLoop(FIXED_DT);
+
+    if (!scenario.untilSceneChange) {
+        for (int i = 0; i < options.warmup; ++i)
+            director->mainLoop(FIXED_DT);
+    }
+
+    stats->setWindowSize(options.frames);
+
+    auto cpuStart = std::clock();
+    auto wallStart = std::chrono::steady_clock::now();
+    int frames = 0;
+    while (frames < options.frames) {
+        director->mainLoop(FIXED_DT);
+        ++frames;
+        if (scenario.untilSceneChange && director->getRunningScene() != scene)
+            break;
+    }
+    auto wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wallStart).count();
+    auto cpuMs = 1000.0 * (std::clock() - cpuStart) / CLOCKS_PER_SEC;
+
+    auto json = stats->toJson();
+    while (!json.empty() && json.back() == '\n')
+        json.pop_back();
+
+    std::fprintf(stderr, "%-24s %5d frames  %9.2f ms wall  %9.2f ms process cpu\n", scenario.name, frames, wallMs,
+                 cpuMs);
+
+    return fmt::format("{{\"name\":\"{}\",\"frames\":{},\"wallMs\":{:.3f},\"processCpuMs\":{:.3f},\"stats\":{}}}",
+                       scenario.name, frames, wallMs, cpuMs, json);
+}
+
+class BenchApp : private Application {
+public:
+    explicit BenchApp(Options options) : _options(std::move(options)) {}
+
+    int exitCode() const { return _exitCode; }
+
+    void initGfxContextAttrs() override {
+        GfxContextAttrs attrs = {8, 8, 8, 8, 24, 8, 0};
+        attrs.visible = false;
+        attrs.vsync = false;
+        RenderView::setGfxContextAttrs(attrs);
+    }
+
+    bool applicationDidFinishLaunching() override {
+        auto director = Director::getInstance();
+        auto renderView = RenderViewImpl::createWithRect("CosmicCitiesBench", Rect(0, 0, 960, 720), 1.0f, false);
+        if (!renderView) {
+            std::fprintf(stderr, "could not create a rendering context; is DISPLAY set (xvfb-run)?\n");
+            _exitCode = 1;
+            return false;
+        }
+        director->setRenderView(renderView);
+        director->setStatsDisplay(false);
+        director->setAnimationInterval(FIXED_DT);
+        renderView->setDesignResolutionSize(DESIGN_SIZE.width, DESIGN_SIZE.height, ResolutionPolicy::SHOW_ALL);
+
+        InputManager::get().initialize();
+
+        std::string results;
+        for (const auto& scenario : scenarios()) {
+            if (!selected(_options, scenario.name))
+                continue;
+            if (!results.empty())
+                results += ",\n";
+            results += runScenario(scenario, _options);
+        }
+
+        auto report = fmt::format("{{\"fixedDt\":{:.6f},\"seed\":{},\"warmupFrames\":{},\"frames\":{},"
+                                  "\"scenarios\":[\n{}\n]}}\n",
+                                  FIXED_DT, _options.seed, _options.warmup, _options.frames, results);
+        if (_options.out.empty()) {
+            std::fputs(report.c_str(), stdout);
+        } else if (!(std::ofstream(_options.out, std::ios::binary) << report)) {
+            std::fprintf(stderr, "failed to write %s\n", _options.out.c_str());
+            _exitCode = 1;
+        }
+
+        director->end();
+        director->mainLoop();
+
+        // nothing left to run; returning false skips the interactive loop
+        return false;
+    }
+
+    void applicationDidEnterBackground() override {}
+    void applicationWillEnterForeground() override {}
+
+private:
+    Options _options;
+    int _exitCode{0};
+};
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        auto value = [&]() -> const char* { return i + 1 < argc ? argv[++i] : nullptr; };
+
+        const char* v = nullptr;
+        if (arg == "--list") {
+            options.list = true;
+        } else if (arg == "--frames" && (v = value())) {
+            options.frames = std::max(1, std::atoi(v));
+        } else if (arg == "--warmup" && (v = value())) {
+            options.warmup = std::max(0, std::atoi(v));
+        } else if (arg == "--seed" && (v = value())) {
+            options.seed = static_cast<uint32_t>(std::strtoul(v, nullptr, 10));
+        } else if (arg == "--only" && (v = value())) {
+            options.only = v;
+        } else if (arg == "--root" && (v = value())) {
+            options.root = v;
+        } else if (arg == "--out" && (v = value())) {
+            options.out = v;
+        } else {
+            std::fprintf(stderr,
+                         "usage: %s [--frames N] [--warmup N] [--seed N] [--only name[,name...]] [--root dir] "
+                         "[--out file] [--list]\n",
+                         argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options))
+        return 2;
+
+    if (options.list) {
+        for (const auto& scenario : scenarios())
+            std::printf("%s\n", scenario.name);
+        return 0;
+    }
+
+    // the game opens Content/... relative to the working directory
+    std::error_code ec;
+    std::filesystem::current_path(options.root, ec);
+    if (ec) {
+        std::fprintf(stderr, "cannot enter %s: %s\n", options.root.c_str(), ec.message().c_str());
+        return 1;
+    }
+
+    BenchApp app(std::move(options));
+    Application::getInstance()->run();
+    return app.exitCode();
+}
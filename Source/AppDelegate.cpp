@@ -33,6 +33,7 @@
 
 #include "utils/ModToggleManager.h"
 #include "managers/DiscordManager.h"
+#include "dialog/DialogManager.h"
 
 using namespace ax;
 
@@ -72,6 +73,9 @@ bool AppDelegate::applicationDidFinishLaunching() {
 
     InputManager::get().initialize();
 
+    // Compile the shipped dialogues in the background so starting one is instant
+    cosmiccities::DialogManager::get().preloadDirectory("Content/dialogs");
+
     // Discover mods and write a handshake for MinHook-driven loaders
     cosmiccities::ModToggleManager::get().initialize("mods");
     
@@ -0,0 +1,250 @@
+#include "DialogGraph.h"
+#include "xxhash.h"
+#include <spdlog/spdlog.h>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+namespace cosmiccities {
+
+void DialogGraph::Builder::addNode(int id, std::string_view speaker, std::string_view text, std::string_view dialog) {
+    uint32_t speakerIndex = 0;
+    auto it = _speakerIndex.find(std::string(speaker));
+    if (it != _speakerIndex.end()) {
+        speakerIndex = it->second;
+    } else {
+        speakerIndex = static_cast<uint32_t>(_speakers.size());
+        _speakers.push_back({addString(speaker), static_cast<uint32_t>(speaker.size())});
+        _speakerIndex.emplace(std::string(speaker), speakerIndex);
+    }
+
+    NodeRecord node;
+    node.id = id;
+    node.speaker = speakerIndex;
+    node.textOffset = addString(text);
+    node.textLength = static_cast<uint32_t>(text.size());
+    node.firstChoice = static_cast<uint32_t>(_choices.size());
+    node.choiceCount = 0;
+    node.dialogOffset = addString(dialog);
+    node.dialogLength = static_cast<uint32_t>(dialog.size());
+    _nodes.push_back(node);
+}
+
+void DialogGraph::Builder::addChoice(std::string_view text, int nextId, std::string_view dialog) {
+    if (_nodes.empty()) return;
+
+    ChoiceRecord choice;
+    choice.textOffset = addString(text);
+    choice.textLength = static_cast<uint32_t>(text.size());
+    choice.nextId = nextId;
+    choice.nextIndex = DIALOG_END;
+    choice.dialogOffset = addString(dialog);
+    choice.dialogLength = static_cast<uint32_t>(dialog.size());
+    _choices.push_back(choice);
+    _nodes.back().choiceCount++;
+}
+
+uint32_t DialogGraph::Builder::addString(std::string_view s) {
+    auto offset = static_cast<uint32_t>(_strings.size());
+    _strings.append(s);
+    return offset;
+}
+
+std::vector<uint8_t> DialogGraph::Builder::finish(const SourceStamp& source) {
+    // Dense id remapping; the last node with a given id wins, as the old lookup did
+    std::unordered_map<int, uint32_t> idToIndex;
+    idToIndex.reserve(_nodes.size());
+    for (uint32_t i = 0; i < _nodes.size(); ++i) {
+        if (!idToIndex.insert_or_assign(_nodes[i].id, i).second) {
+            spdlog::warn("DialogManager: warning: duplicate node id {}, the later node is used", _nodes[i].id);
+        }
+    }
+    for (auto& c : _choices) {
+        if (c.nextId == 0 || c.dialogLength != 0) continue;
+        auto it = idToIndex.find(c.nextId);
+        if (it != idToIndex.end()) {
+            c.nextIndex = it->second;
+        } else {
+            spdlog::warn("DialogManager: warning: next id {} not found", c.nextId);
+        }
+    }
+
+    Header header;
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.source = source;
+    header.nodeCount = static_cast<uint32_t>(_nodes.size());
+    header.choiceCount = static_cast<uint32_t>(_choices.size());
+    header.speakerCount = static_cast<uint32_t>(_speakers.size());
+    header.nodesOffset = sizeof(Header);
+    header.choicesOffset = header.nodesOffset + header.nodeCount * sizeof(NodeRecord);
+    header.speakersOffset = header.choicesOffset + header.choiceCount * sizeof(ChoiceRecord);
+    header.stringsOffset = header.speakersOffset + header.speakerCount * sizeof(SpeakerRecord);
+    header.stringsSize = static_cast<uint32_t>(_strings.size());
+
+    std::vector<uint8_t> bytes(header.stringsOffset + _strings.size());
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    std::memcpy(bytes.data() + header.nodesOffset, _nodes.data(), _nodes.size() * sizeof(NodeRecord));
+    std::memcpy(bytes.data() + header.choicesOffset, _choices.data(), _choices.size() * sizeof(ChoiceRecord));
+    std::memcpy(bytes.data() + header.speakersOffset, _speakers.data(), _speakers.size() * sizeof(SpeakerRecord));
+    std::memcpy(bytes.data() + header.stringsOffset, _strings.data(), _strings.size());
+    return bytes;
+}
+
+bool DialogGraph::stampOf(const std::filesystem::path& source, SourceStamp& out, bool withHash) {
+    std::error_code ec;
+    out.size = std::filesystem::file_size(source, ec);
+    if (ec) return false;
+    out.time = std::filesystem::last_write_time(source, ec).time_since_epoch().count();
+    if (ec) return false;
+
+    out.hash = 0;
+    if (!withHash) return true;
+
+    std::ifstream file(source, std::ios::binary);
+    if (!file) return false;
+    std::string contents(out.size, '\0');
+    file.read(contents.data(), static_cast<std::streamsize>(contents.size()));
+    out.hash = XXH64(contents.data(), contents.size(), 0);
+    return true;
+}
+
+bool DialogGraph::matchesSource(const SourceStamp& recorded, const std::filesystem::path& source) {
+    SourceStamp current;
+    if (!stampOf(source, current, false)) return false;
+
+    if (recorded.size != current.size) return false;
+    if (recorded.time == current.time) return true;
+    return stampOf(source, current, true) && recorded.hash == current.hash;
+}
+
+std::filesystem::path DialogGraph::cachePathFor(const std::filesystem::path& source) {
+    auto* fu = ax::FileUtils::getInstance();
+    std::string writable = fu ? fu->getWritablePath() : std::string();
+    if (writable.empty()) return {};
+
+    // Same-named scripts in different folders must not share a cache entry
+    std::error_code ec;
+    auto absolute = std::filesystem::absolute(source, ec).generic_string();
+    auto pathHash = XXH64(absolute.data(), absolute.size(), 0);
+
+    return std::filesystem::path(writable) / "dialogs" /
+           fmt::format("{}-{:016x}{}", source.stem().string(), pathHash, EXTENSION);
+}
+
+bool DialogGraph::writeFile(const std::filesystem::path& path, const std::vector<uint8_t>& bytes) {
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+
+    // Main thread and preload workers may compile the same script at once
+    auto tmpPath = path;
+    tmpPath += fmt::format(".{:x}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!file) return false;
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!file.good()) return false;
+    }
+
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool DialogGraph::openCached(const std::filesystem::path& cachePath, const std::filesystem::path& source) {
+    clear();
+    if (cachePath.empty()) return false;
+
+    std::error_code ec;
+    _mapping.map(cachePath.string(), ec);
+    if (ec) return false;
+
+    const auto* data = reinterpret_cast<const uint8_t*>(_mapping.data());
+    if (_mapping.size() < sizeof(Header)) {
+        clear();
+        return false;
+    }
+
+    Header header;
+    std::memcpy(&header, data, sizeof(header));
+
+    if (!matchesSource(header.source, source) || !bind(data, _mapping.size())) {
+        clear();
+        return false;
+    }
+    return true;
+}
+
+bool DialogGraph::adopt(std::vector<uint8_t>&& bytes) {
+    clear();
+    _owned = std::move(bytes);
+    if (!bind(_owned.data(), _owned.size())) {
+        clear();
+        return false;
+    }
+    return true;
+}
+
+void DialogGraph::clear() {
+    _nodes.clear();
+    _choices.clear();
+    _mapping.unmap();
+    _owned.clear();
+    _source = SourceStamp{};
+}
+
+bool DialogGraph::bind(const uint8_t* data, size_t size) {
+    if (!data || size < sizeof(Header)) return false;
+
+    const auto* header = reinterpret_cast<const Header*>(data);
+    if (header->magic != MAGIC || header->version != VERSION) return false;
+    _source = header->source;
+
+    const uint64_t nodesEnd = header->nodesOffset + uint64_t(header->nodeCount) * sizeof(NodeRecord);
+    const uint64_t choicesEnd = header->choicesOffset + uint64_t(header->choiceCount) * sizeof(ChoiceRecord);
+    const uint64_t speakersEnd = header->speakersOffset + uint64_t(header->speakerCount) * sizeof(SpeakerRecord);
+    if (nodesEnd > header->choicesOffset || choicesEnd > header->speakersOffset ||
+        speakersEnd > header->stringsOffset || uint64_t(header->stringsOffset) + header->stringsSize > size)
+        return false;
+
+    const auto* nodes = reinterpret_cast<const NodeRecord*>(data + header->nodesOffset);
+    const auto* choices = reinterpret_cast<const ChoiceRecord*>(data + header->choicesOffset);
+    const auto* speakers = reinterpret_cast<const SpeakerRecord*>(data + header->speakersOffset);
+    const char* strings = reinterpret_cast<const char*>(data + header->stringsOffset);
+
+    auto str = [&](uint32_t offset, uint32_t length, std::string_view& out) {
+        if (uint64_t(offset) + length > header->stringsSize) return false;
+        out = std::string_view(strings + offset, length);
+        return true;
+    };
+
+    _choices.resize(header->choiceCount);
+    for (uint32_t i = 0; i < header->choiceCount; ++i) {
+        const auto& rec = choices[i];
+        auto& c = _choices[i];
+        if (!str(rec.textOffset, rec.textLength, c.text)) return false;
+        if (!str(rec.dialogOffset, rec.dialogLength, c.dialog)) return false;
+        if (rec.nextIndex != DIALOG_END && rec.nextIndex >= header->nodeCount) return false;
+        c.nextId = rec.nextId;
+        c.nextIndex = rec.nextIndex;
+    }
+
+    _nodes.resize(header->nodeCount);
+    for (uint32_t i = 0; i < header->nodeCount; ++i) {
+        const auto& rec = nodes[i];
+        auto& n = _nodes[i];
+        if (rec.speaker >= header->speakerCount) return false;
+        if (uint64_t(rec.firstChoice) + rec.choiceCount > header->choiceCount) return false;
+        if (!str(speakers[rec.speaker].offset, speakers[rec.speaker].length, n.speaker)) return false;
+        if (!str(rec.textOffset, rec.textLength, n.text)) return false;
+        if (!str(rec.dialogOffset, rec.dialogLength, n.dialog)) return false;
+        n.id = rec.id;
+        n.choices = std::span<const DialogChoice>(_choices.data() + rec.firstChoice, rec.choiceCount);
+    }
+    return true;
+}
+
+} // namespace cosmiccities
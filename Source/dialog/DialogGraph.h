@@ -0,0 +1,121 @@
+#pragma once
+
+#include "DialogTypes.h"
+#include "mio/mio.hpp"
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cosmiccities {
+
+// Flat, compiled form of a dialog script (.ccdlg).
+//
+// Nodes and choices are stored contiguously, speaker names are interned, and every
+// choice's next id is remapped to a dense node index at compile time, so loading is
+// one mmap plus a linear pass that points DialogNode/DialogChoice at the mapping.
+// The header records the source script's size, timestamp and content hash; the cache
+// is rebuilt when the size differs, or when the timestamp differs and the hash does too.
+class DialogGraph {
+public:
+    static constexpr uint32_t MAGIC = 0x47444343; // "CCDG"
+    static constexpr uint32_t VERSION = 2;
+    static constexpr const char* EXTENSION = ".ccdlg";
+
+    struct SourceStamp {
+        uint64_t size{0};
+        int64_t time{0};
+        uint64_t hash{0};
+    };
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        SourceStamp source;
+        uint32_t nodeCount;
+        uint32_t choiceCount;
+        uint32_t speakerCount;
+        uint32_t nodesOffset;
+        uint32_t choicesOffset;
+        uint32_t speakersOffset;
+        uint32_t stringsOffset;
+        uint32_t stringsSize;
+    };
+
+    struct NodeRecord {
+        int32_t id;
+        uint32_t speaker;     // index into the speaker table
+        uint32_t textOffset;
+        uint32_t textLength;
+        uint32_t firstChoice;
+        uint32_t choiceCount;
+        uint32_t dialogOffset;
+        uint32_t dialogLength;
+    };
+
+    struct ChoiceRecord {
+        uint32_t textOffset;
+        uint32_t textLength;
+        int32_t nextId;
+        uint32_t nextIndex;   // DIALOG_END when the choice ends the dialog
+        uint32_t dialogOffset;
+        uint32_t dialogLength;
+    };
+
+    struct SpeakerRecord {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    // Collects nodes in script order and serialises them into graph bytes
+    class Builder {
+    public:
+        void addNode(int id, std::string_view speaker, std::string_view text, std::string_view dialog = {});
+        // Belongs to the last added node
+        void addChoice(std::string_view text, int nextId, std::string_view dialog = {});
+
+        size_t nodeCount() const { return _nodes.size(); }
+        std::vector<uint8_t> finish(const SourceStamp& source);
+
+    private:
+        uint32_t addString(std::string_view s);
+
+        std::string _strings;
+        std::vector<NodeRecord> _nodes;
+        std::vector<ChoiceRecord> _choices;
+        std::vector<SpeakerRecord> _speakers;
+        std::unordered_map<std::string, uint32_t> _speakerIndex;
+    };
+
+    // Size and timestamp are cheap; the content hash is only read when asked for
+    static bool stampOf(const std::filesystem::path& source, SourceStamp& out, bool withHash);
+    // True while the script still matches a recorded stamp; a touched-but-unchanged script still matches
+    static bool matchesSource(const SourceStamp& recorded, const std::filesystem::path& source);
+    static std::filesystem::path cachePathFor(const std::filesystem::path& source);
+    static bool writeFile(const std::filesystem::path& path, const std::vector<uint8_t>& bytes);
+
+    // Maps a cache file and accepts it only if it still matches the source script
+    bool openCached(const std::filesystem::path& cachePath, const std::filesystem::path& source);
+    bool adopt(std::vector<uint8_t>&& bytes);
+    void clear();
+
+    bool empty() const { return _nodes.empty(); }
+    // Stamp of the script this graph was compiled from
+    const SourceStamp& source() const { return _source; }
+    size_t size() const { return _nodes.size(); }
+    const DialogNode& node(uint32_t index) const { return _nodes[index]; }
+
+    const std::vector<DialogNode>& nodes() const { return _nodes; }
+
+private:
+    bool bind(const uint8_t* data, size_t size);
+
+    mio::mmap_source _mapping;
+    std::vector<uint8_t> _owned;
+    SourceStamp _source;
+
+    std::vector<DialogNode> _nodes;
+    std::vector<DialogChoice> _choices;
+};
+
+} // namespace cosmiccities
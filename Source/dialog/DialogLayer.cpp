@@ -1,5 +1,6 @@
 #include "DialogLayer.h"
 #include "../extras/MenuItemExtra.h"
+#include <fmt/format.h>
 
 using namespace ax;
 
@@ -77,7 +78,7 @@ void DialogLayer::clearChoices() {
     }
 }
 
-void DialogLayer::buildChoices(const std::vector<DialogChoice>& choices) {
+void DialogLayer::buildChoices(std::span<const DialogChoice> choices) {
     clearChoices();
     if (!_menu) return;
 
@@ -85,7 +86,7 @@ void DialogLayer::buildChoices(const std::vector<DialogChoice>& choices) {
     float y = 50.0f;
     int i = 0;
     for (const auto& ch : choices) {
-        std::string labelText = std::to_string(i + 1) + ") " + ch.text;
+        std::string labelText = fmt::format("{}) {}", i + 1, ch.text);
         auto lbl = Label::createWithTTF(labelText, "fonts/arial.ttf", 20);
         if (!lbl) lbl = Label::createWithSystemFont(labelText, "Arial", 20);
 
@@ -113,7 +114,7 @@ void DialogLayer::refresh() {
     const auto* n = dm.current();
     if (!n) { removeFromParent(); return; }
 
-    std::string text = n->speaker.empty() ? n->text : (n->speaker + ": " + n->text);
+    std::string text = n->speaker.empty() ? std::string(n->text) : fmt::format("{}: {}", n->speaker, n->text);
     if (_label) {
         _label->setString(text);
     }
@@ -20,7 +20,7 @@ private:
     ax::Menu* _menu{nullptr};
 
     void clearChoices();
-    void buildChoices(const std::vector<DialogChoice>& choices);
+    void buildChoices(std::span<const DialogChoice> choices);
 };
 
 } // namespace cosmiccities
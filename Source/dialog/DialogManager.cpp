@@ -19,35 +19,36 @@ DialogManager& DialogManager::get() {
 }
 
 bool DialogManager::startDialogue(const std::filesystem::path& luaFile) {
-    if (!_lua) {
-        _lua = std::make_unique<sol::state>();
-        _lua->open_libraries(sol::lib::base, sol::lib::package, sol::lib::string, sol::lib::table);
-    }
-
-    if (!loadFromLua(luaFile)) {
+    auto key = preloadKey(luaFile);
+    auto preloaded = dropStalePreload(key, luaFile) ? _preloaded.end() : _preloaded.find(key);
+    if (preloaded != _preloaded.end()) {
+        _graph = std::move(*preloaded->second);
+        _preloaded.erase(preloaded);
+    } else if (!loadGraph(luaFile, DialogGraph::cachePathFor(luaFile), _graph, _lua)) {
         spdlog::error("DialogManager: Failed to load '{}'", luaFile.string());
+        _graph.clear();
+        _active = false;
+        _currentIndex = DIALOG_END;
         return false;
     }
 
-    _active = !_nodes.empty();
+    _active = !_graph.empty();
+    _currentIndex = _active ? 0 : DIALOG_END;
     if (_active) {
-        _currentId = _nodes.front().id;
-    } else {
-        _currentId = 0;
+        prefetchReachable();
     }
     return _active;
 }
 
 void DialogManager::endDialogue() {
-    _nodes.clear();
-    _idToIndex.clear();
-    _currentId = 0;
+    _graph.clear();
+    _currentIndex = DIALOG_END;
     _active = false;
 }
 
 const DialogNode* DialogManager::current() const {
-    if (!_active || _currentId == 0) return nullptr;
-    return nodeById(_currentId);
+    if (!_active || _currentIndex >= _graph.size()) return nullptr;
+    return &_graph.node(_currentIndex);
 }
 
 bool DialogManager::hasChoices() const {
@@ -55,48 +56,176 @@ bool DialogManager::hasChoices() const {
     return n && !n->choices.empty();
 }
 
-const std::vector<DialogChoice>& DialogManager::choices() const {
-    static std::vector<DialogChoice> empty;
+std::span<const DialogChoice> DialogManager::choices() const {
     const auto* n = current();
-    return n ? n->choices : empty;
+    return n ? n->choices : std::span<const DialogChoice>();
 }
 
 bool DialogManager::advance(int choiceIndex) {
     const auto* n = current();
     if (!n) return false;
 
-    int nextId = 0;
+    uint32_t nextIndex = DIALOG_END;
+    std::string_view nextDialog;
     if (!n->choices.empty()) {
         if (choiceIndex < 0 || choiceIndex >= static_cast<int>(n->choices.size())) return false;
-        nextId = n->choices[choiceIndex].nextId;
+        nextIndex = n->choices[choiceIndex].nextIndex;
+        nextDialog = n->choices[choiceIndex].dialog;
     } else {
-        // No choices: advance sequentially if contiguous id exists
-        auto it = _idToIndex.find(n->id);
-        if (it != _idToIndex.end()) {
-            size_t idx = it->second;
-            if (idx + 1 < _nodes.size()) nextId = _nodes[idx + 1].id;
-        }
+        // No choices: hand off to another script, or advance sequentially through the script order
+        nextDialog = n->dialog;
+        if (nextDialog.empty() && _currentIndex + 1 < _graph.size()) nextIndex = _currentIndex + 1;
     }
 
-    if (nextId == 0) {
+    if (!nextDialog.empty()) {
+        // The view points into the graph we are about to replace
+        std::filesystem::path target(nextDialog);
+        return startDialogue(target);
+    }
+
+    if (nextIndex == DIALOG_END) {
         endDialogue();
         return false;
     }
-    _currentId = nextId;
+    _currentIndex = nextIndex;
+    return true;
+}
+
+void DialogManager::preload(const std::filesystem::path& luaFile, std::function<void(bool)> onReady) {
+    auto key = preloadKey(luaFile);
+    if (!dropStalePreload(key, luaFile) && _preloaded.count(key)) {
+        if (onReady) onReady(true);
+        return;
+    }
+
+    auto pending = _pending.find(key);
+    if (pending != _pending.end()) {
+        if (onReady) pending->second.push_back(std::move(onReady));
+        return;
+    }
+
+    auto& waiters = _pending[key];
+    if (onReady) waiters.push_back(std::move(onReady));
+
+    struct PreloadJob {
+        DialogGraph graph;
+        bool ok{false};
+    };
+    auto job = std::make_shared<PreloadJob>();
+    auto cachePath = DialogGraph::cachePathFor(luaFile);
+
+    ax::Director::getInstance()->getJobSystem()->enqueue(
+        [job, luaFile, cachePath]() {
+            // Each worker keeps its own Lua state; sol/Lua states are not thread-safe
+            thread_local std::unique_ptr<sol::state> workerLua;
+            job->ok = loadGraph(luaFile, cachePath, job->graph, workerLua);
+        },
+        [this, job, key]() {
+            auto waiting = std::move(_pending[key]);
+            _pending.erase(key);
+
+            if (job->ok) {
+                _preloaded[key] = std::make_unique<DialogGraph>(std::move(job->graph));
+            } else {
+                spdlog::warn("DialogManager: preload of '{}' failed", key);
+            }
+            for (auto& cb : waiting) {
+                cb(job->ok);
+            }
+        });
+}
+
+void DialogManager::prefetchReachable() {
+    if (!_active || _currentIndex >= _graph.size()) return;
+
+    // Breadth-first over everything the player can still reach in this script
+    std::vector<bool> seen(_graph.size(), false);
+    std::vector<uint32_t> queue{_currentIndex};
+    seen[_currentIndex] = true;
+
+    auto visit = [&](uint32_t index) {
+        if (index < _graph.size() && !seen[index]) {
+            seen[index] = true;
+            queue.push_back(index);
+        }
+    };
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        const auto& n = _graph.node(queue[head]);
+        if (!n.choices.empty()) {
+            for (const auto& c : n.choices) {
+                if (!c.dialog.empty()) preload(std::filesystem::path(c.dialog));
+                else visit(c.nextIndex);
+            }
+        } else if (!n.dialog.empty()) {
+            preload(std::filesystem::path(n.dialog));
+        } else {
+            visit(queue[head] + 1);
+        }
+    }
+}
+
+void DialogManager::preloadDirectory(const std::filesystem::path& directory) {
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        if (entry.is_regular_file(ec) && entry.path().extension() == ".lua")
+            preload(entry.path());
+    }
+}
+
+bool DialogManager::isPreloaded(const std::filesystem::path& luaFile) const {
+    return _preloaded.count(preloadKey(luaFile)) > 0;
+}
+
+void DialogManager::clearPreloaded() {
+    _preloaded.clear();
+}
+
+bool DialogManager::dropStalePreload(const std::string& key, const std::filesystem::path& luaFile) {
+    auto it = _preloaded.find(key);
+    if (it == _preloaded.end() || DialogGraph::matchesSource(it->second->source(), luaFile))
+        return false;
+
+    spdlog::info("DialogManager: '{}' changed since it was preloaded", key);
+    _preloaded.erase(it);
     return true;
 }
 
-const DialogNode* DialogManager::nodeById(int id) const {
-    auto it = _idToIndex.find(id);
-    if (it == _idToIndex.end()) return nullptr;
-    return &_nodes[it->second];
+std::string DialogManager::preloadKey(const std::filesystem::path& luaFile) {
+    return luaFile.lexically_normal().generic_string();
 }
 
-bool DialogManager::loadFromLua(const std::filesystem::path& luaFile) {
-    _nodes.clear();
-    _idToIndex.clear();
+bool DialogManager::loadGraph(const std::filesystem::path& luaFile, const std::filesystem::path& cachePath,
+                              DialogGraph& graph, std::unique_ptr<sol::state>& lua) {
+    if (graph.openCached(cachePath, luaFile)) {
+        return true;
+    }
+
+    DialogGraph::SourceStamp stamp;
+    if (!DialogGraph::stampOf(luaFile, stamp, true)) {
+        spdlog::error("DialogManager: cannot read '{}'", luaFile.string());
+        return false;
+    }
+
+    if (!lua) {
+        lua = std::make_unique<sol::state>();
+        lua->open_libraries(sol::lib::base, sol::lib::package, sol::lib::string, sol::lib::table);
+    }
+
+    DialogGraph::Builder builder;
+    if (!compileLua(*lua, luaFile, builder)) {
+        return false;
+    }
+
+    auto bytes = builder.finish(stamp);
+    if (!cachePath.empty() && !DialogGraph::writeFile(cachePath, bytes)) {
+        spdlog::warn("DialogManager: could not write cache '{}'", cachePath.string());
+    }
+    return graph.adopt(std::move(bytes)) && !graph.empty();
+}
 
-    sol::load_result lr = _lua->load_file(luaFile.string());
+bool DialogManager::compileLua(sol::state& lua, const std::filesystem::path& luaFile, DialogGraph::Builder& builder) {
+    sol::load_result lr = lua.load_file(luaFile.string());
     if (!lr.valid()) {
         sol::error err = lr;
         spdlog::error("DialogManager: load error: {}", err.what());
@@ -119,28 +248,34 @@ bool DialogManager::loadFromLua(const std::filesystem::path& luaFile) {
 
     int autoId = 1;
     for (auto& kv : tbl) {
-        sol::object key = kv.first;
         sol::object val = kv.second;
         if (!val.is<sol::table>()) continue;
 
-        DialogNode node;
         sol::table nt = val.as<sol::table>();
 
         // id (optional) or auto-increment
+        int id = autoId;
         {
             sol::object idv = nt["id"];
-            if (idv.valid() && idv.is<int>()) node.id = idv.as<int>();
-            else node.id = autoId;
+            if (idv.valid() && idv.is<int>()) id = idv.as<int>();
         }
 
+        std::string_view speaker;
+        std::string_view text;
+        std::string_view dialog;
         {
             sol::object spv = nt["speaker"];
-            node.speaker = (spv.valid() && spv.is<std::string>()) ? spv.as<std::string>() : std::string();
+            if (spv.valid() && spv.is<std::string_view>()) speaker = spv.as<std::string_view>();
         }
         {
             sol::object txv = nt["text"];
-            node.text = (txv.valid() && txv.is<std::string>()) ? txv.as<std::string>() : std::string();
+            if (txv.valid() && txv.is<std::string_view>()) text = txv.as<std::string_view>();
+        }
+        {
+            sol::object dlv = nt["dialog"];
+            if (dlv.valid() && dlv.is<std::string_view>()) dialog = dlv.as<std::string_view>();
         }
+        builder.addNode(id, speaker, text, dialog);
 
         // choices (optional array)
         sol::object chobj = nt["choices"];
@@ -150,30 +285,20 @@ bool DialogManager::loadFromLua(const std::filesystem::path& luaFile) {
                 sol::object v = ck.second;
                 if (!v.is<sol::table>()) continue;
                 sol::table ct = v.as<sol::table>();
-                DialogChoice c;
-                c.text = ct.get_or<std::string>("text", "");
+                std::string choiceText = ct.get_or<std::string>("text", "");
                 // next can be a number id or absent (treated as 0)
                 sol::object nv = ct["next"];
-                c.nextId = (nv.valid() && nv.get_type() == sol::type::number) ? nv.as<int>() : 0;
-                node.choices.push_back(std::move(c));
+                int nextId = (nv.valid() && nv.get_type() == sol::type::number) ? nv.as<int>() : 0;
+                // dialog hands the conversation off to another script
+                std::string choiceDialog = ct.get_or<std::string>("dialog", "");
+                builder.addChoice(choiceText, nextId, choiceDialog);
             }
         }
 
-        _idToIndex[node.id] = _nodes.size();
-        _nodes.push_back(std::move(node));
         ++autoId;
     }
 
-    // Validate nextId references
-    for (const auto& n : _nodes) {
-        for (const auto& c : n.choices) {
-            if (c.nextId != 0 && _idToIndex.find(c.nextId) == _idToIndex.end()) {
-                spdlog::warn("DialogManager: warning: next id {} not found", c.nextId);
-            }
-        }
-    }
-
-    return !_nodes.empty();
+    return builder.nodeCount() > 0;
 }
 
 } // namespace cosmiccities
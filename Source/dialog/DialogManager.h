@@ -1,8 +1,11 @@
 #pragma once
 
 #include "DialogTypes.h"
+#include "DialogGraph.h"
 #include <memory>
 #include <filesystem>
+#include <functional>
+#include <unordered_map>
 
 // Forward declare sol in the global namespace to avoid shadowing
 namespace sol { class state; }
@@ -15,16 +18,27 @@ class DialogManager {
 public:
     static DialogManager& get();
 
-    // Load a Lua file that returns a table describing the dialog graph
+    // Load a Lua file that returns a table describing the dialog graph. The compiled
+    // graph is cached in the writable path and reused until the script changes.
     bool startDialogue(const std::filesystem::path& luaFile);
     bool isActive() const { return _active; }
     void endDialogue();
 
     const DialogNode* current() const;
     bool hasChoices() const;
-    const std::vector<DialogChoice>& choices() const;
+    std::span<const DialogChoice> choices() const;
     bool advance(int choiceIndex = -1); // -1 = next
 
+    // Compile or map a dialog on a worker thread, with its own Lua state, so that a later
+    // startDialogue for the same file is instant. onReady runs on the main thread.
+    void preload(const std::filesystem::path& luaFile, std::function<void(bool)> onReady = nullptr);
+    // Preload every .lua script in a directory; a missing directory preloads nothing
+    void preloadDirectory(const std::filesystem::path& directory);
+    // Preload every script the current conversation can hand off to via `dialog`
+    void prefetchReachable();
+    bool isPreloaded(const std::filesystem::path& luaFile) const;
+    void clearPreloaded();
+
     // Optional: attach a UI layer (created externally)
     void attachLayer(DialogLayer* layer) { _layer = layer; }
     void detachLayer(DialogLayer* layer) { if (_layer == layer) _layer = nullptr; }
@@ -32,16 +46,24 @@ public:
 private:
     DialogManager() = default;
 
-    bool loadFromLua(const std::filesystem::path& luaFile);
-    const DialogNode* nodeById(int id) const;
+    static std::string preloadKey(const std::filesystem::path& luaFile);
+    // cachePath comes from DialogGraph::cachePathFor, resolved on the main thread since it goes through FileUtils
+    static bool loadGraph(const std::filesystem::path& luaFile, const std::filesystem::path& cachePath,
+                          DialogGraph& graph, std::unique_ptr<::sol::state>& lua);
+    // Drops a preloaded graph whose script changed since it was compiled
+    bool dropStalePreload(const std::string& key, const std::filesystem::path& luaFile);
+    static bool compileLua(::sol::state& lua, const std::filesystem::path& luaFile, DialogGraph::Builder& builder);
 
     std::unique_ptr<::sol::state> _lua;
 
-    std::vector<DialogNode> _nodes;
-    std::unordered_map<int, size_t> _idToIndex;
-    int _currentId{0};
+    DialogGraph _graph;
+    uint32_t _currentIndex{DIALOG_END};
     bool _active{false};
 
+    // Both maps are only touched on the main thread; workers hand results back through the scheduler
+    std::unordered_map<std::string, std::unique_ptr<DialogGraph>> _preloaded;
+    std::unordered_map<std::string, std::vector<std::function<void(bool)>>> _pending;
+
     DialogLayer* _layer{nullptr};
 };
 
@@ -1,22 +1,29 @@
 #pragma once
 
 #include "../Includes.hpp"
-#include <string>
-#include <vector>
-#include <unordered_map>
+#include <cstdint>
+#include <span>
+#include <string_view>
 
 namespace cosmiccities {
 
+// Dense node index used once a dialog is compiled; marks the end of a conversation
+constexpr uint32_t DIALOG_END = UINT32_MAX;
+
+// Strings and choice lists point into the owning DialogGraph
 struct DialogChoice {
-    std::string text;
+    std::string_view text;
     int nextId{0}; // 0 = end
+    uint32_t nextIndex{DIALOG_END};
+    std::string_view dialog; // optional script to continue in instead of nextId
 };
 
 struct DialogNode {
     int id{0};
-    std::string speaker;
-    std::string text;
-    std::vector<DialogChoice> choices;
+    std::string_view speaker;
+    std::string_view text;
+    std::span<const DialogChoice> choices;
+    std::string_view dialog; // optional script to continue in when advancing past this node
 };
 
 } // namespace cosmiccities
@@ -29,8 +29,8 @@ LayoutMenu* LayoutMenu::setIgnoreInvisibleChildren(bool ignore) { _ignoreInvisib
 LayoutMenu* LayoutMenu::setGrowCrossAxis(bool grow) { _growCross = grow; return this; }
 LayoutMenu* LayoutMenu::setAutoGrowAxis(std::optional<float> minLength) { _autoGrowAxis = minLength; return this; }
 
-std::vector<ax::Node*> LayoutMenu::collectChildren() const {
-    std::vector<ax::Node*> items;
+ax::FrameVector<ax::Node*> LayoutMenu::collectChildren() const {
+    ax::FrameVector<ax::Node*> items{_director->getFrameArena()};
     const auto& children = this->getChildren();
     items.reserve(children.size());
     for (auto* n : children) {
@@ -45,7 +45,7 @@ std::vector<ax::Node*> LayoutMenu::collectChildren() const {
     return items;
 }
 
-void LayoutMenu::sortChildren(std::vector<ax::Node*>& items) const {
+void LayoutMenu::sortChildren(ax::FrameVector<ax::Node*>& items) const {
     switch (_order) {
         case Order::Natural: break;
         case Order::NameAsc:
@@ -92,15 +92,11 @@ ax::Size LayoutMenu::getCalculatedLayoutSize() const {
     auto items = collectChildren();
     if (items.empty()) return ax::Size::ZERO;
     
-    std::vector<ax::Size> sizes(items.size());
-    for (size_t i = 0; i < items.size(); ++i) {
-        sizes[i] = nodeSize(items[i]);
-    }
-    
     if (_dir == Direction::Row) {
         float totalWidth = 0.f;
         float maxHeight = 0.f;
-        for (const auto& s : sizes) {
+        for (auto* item : items) {
+            auto s = nodeSize(item);
             totalWidth += s.width;
             maxHeight = std::max(maxHeight, s.height);
         }
@@ -109,7 +105,8 @@ ax::Size LayoutMenu::getCalculatedLayoutSize() const {
     } else {
         float totalHeight = 0.f;
         float maxWidth = 0.f;
-        for (const auto& s : sizes) {
+        for (auto* item : items) {
+            auto s = nodeSize(item);
             totalHeight += s.height;
             maxWidth = std::max(maxWidth, s.width);
         }
@@ -118,10 +115,10 @@ ax::Size LayoutMenu::getCalculatedLayoutSize() const {
     }
 }
 
-void LayoutMenu::layoutRow(std::vector<ax::Node*>& items, const Size& area) {
+void LayoutMenu::layoutRow(ax::FrameVector<ax::Node*>& items, const Size& area) {
     if (items.empty()) return;
 
-    std::vector<Size> sizes(items.size());
+    ax::FrameVector<Size> sizes(items.size(), _director->getFrameArena());
     float contentWidth = 0.f;
     float maxHeight = 0.f;
 
@@ -177,10 +174,10 @@ void LayoutMenu::layoutRow(std::vector<ax::Node*>& items, const Size& area) {
     }
 }
 
-void LayoutMenu::layoutColumn(std::vector<ax::Node*>& items, const Size& area) {
+void LayoutMenu::layoutColumn(ax::FrameVector<ax::Node*>& items, const Size& area) {
     if (items.empty()) return;
 
-    std::vector<Size> sizes(items.size());
+    ax::FrameVector<Size> sizes(items.size(), _director->getFrameArena());
     float contentHeight = 0.f;
     float maxWidth = 0.f;
 
@@ -53,11 +53,11 @@ public:
     }
 
 protected:
-    // Helpers
-    std::vector<ax::Node*> collectChildren() const;
-    void sortChildren(std::vector<ax::Node*>& items) const;
-    void layoutRow(std::vector<ax::Node*>& items, const ax::Size& area);
-    void layoutColumn(std::vector<ax::Node*>& items, const ax::Size& area);
+    // Helpers; scratch lists live in the frame arena since layouts run every frame while animating
+    ax::FrameVector<ax::Node*> collectChildren() const;
+    void sortChildren(ax::FrameVector<ax::Node*>& items) const;
+    void layoutRow(ax::FrameVector<ax::Node*>& items, const ax::Size& area);
+    void layoutColumn(ax::FrameVector<ax::Node*>& items, const ax::Size& area);
 
 private:
     Direction _dir{Direction::Row};
@@ -3,7 +3,12 @@
 #include "../utils/Starfield.h"
 #include "../managers/DiscordManager.h"
 #include "SavePickerLayer.h"
+#include "../utils/AssetManifest.h"
+#include <xxhash.h>
+#include <spdlog/spdlog.h>
 #include <algorithm>
+#include <functional>
+#include <numeric>
 
 using namespace ax;
 using namespace cosmiccities;
@@ -80,7 +85,8 @@ Scene* LoadingLayer::scene() {
     return scene;
 }
 
-static void listFilesByExt(const std::string& root, const std::vector<std::string>& exts, std::vector<std::string>& out) {
+template <typename Item>
+static void listFilesByExt(const std::string& root, const std::vector<std::string>& exts, std::vector<Item>& out) {
     auto* fu = FileUtils::getInstance();
     std::vector<std::string> files;
     fu->listFilesRecursively(root, &files);
@@ -90,7 +96,7 @@ static void listFilesByExt(const std::string& root, const std::vector<std::strin
         std::string ext = f.substr(dot + 1);
         std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
         for (auto& e : exts) {
-            if (ext == e) { out.push_back(f); break; }
+            if (ext == e) { out.push_back({f}); break; }
         }
     }
 }
@@ -99,9 +105,13 @@ void LoadingLayer::beginLoading() {
     _texturesToLoad.clear();
     _soundsToLoad.clear();
     _fontsToLoad.clear();
+    _loadedTextures.clear();
 
     _loadedCount = 0;
     _totalCount = 0;
+    _loadedBytes = 0;
+    _totalBytes = 0;
+    _fromManifest = false;
     _loadStep = 0;
     _stepsDone = false;
 
@@ -130,7 +140,7 @@ void LoadingLayer::tickLoad(float dt) {
 bool LoadingLayer::advanceLoadStep() {
     switch (_loadStep) {
     case 0: {
-        if (_stepText) _stepText->setString(LocalisationManager::instance().get("ui.loading.init-discord-rpc", "Initialising Discord RPC..."));
+        if (_stepText) _stepText->setString(LocalisationManager::instance().view("ui.loading.init-discord-rpc"_lk, "Initialising Discord RPC..."));
         
         // Initialize Discord Rich Presence
         DiscordManager::instance().initialize("1392251941349757110");
@@ -140,35 +150,46 @@ bool LoadingLayer::advanceLoadStep() {
         return true;
     }
     case 1: {
-        if (_stepText) _stepText->setString(LocalisationManager::instance().get("ui.loading.assets.scan", "Scanning assets..."));
+        // The build ships a manifest; crawling the folders is only a fallback for dev trees without one
+        _fromManifest = loadFromManifest();
+        if (!_fromManifest) {
+            if (_stepText) _stepText->setString(LocalisationManager::instance().view("ui.loading.assets.scan"_lk, "Scanning assets..."));
 
-        listFilesByExt("sprites", {"png","jpg","jpeg"}, _texturesToLoad);
-        listFilesByExt("sounds", {"mp3","ogg","wav"}, _soundsToLoad);
-        listFilesByExt("fonts",  {"fnt"}, _fontsToLoad);
+            listFilesByExt("sprites", {"png","jpg","jpeg"}, _texturesToLoad);
+            listFilesByExt("sounds", {"mp3","ogg","wav"}, _soundsToLoad);
+            listFilesByExt("fonts",  {"fnt"}, _fontsToLoad);
+        }
 
         _loadStep++;
         return true;
     }
     case 2: {
-        if (_stepText) _stepText->setString(LocalisationManager::instance().get("ui.loading.assets.index", "Indexing and preparing..."));
-        auto dedup = [](std::vector<std::string>& v) {
-            std::sort(v.begin(), v.end());
-            v.erase(std::unique(v.begin(), v.end()), v.end());
-        };
-        dedup(_texturesToLoad);
-        dedup(_soundsToLoad);
-        dedup(_fontsToLoad);
+        if (_stepText) _stepText->setString(LocalisationManager::instance().view("ui.loading.assets.index"_lk, "Indexing and preparing..."));
+        if (!_fromManifest) {
+            auto dedup = [](std::vector<LoadItem>& v) {
+                std::sort(v.begin(), v.end(), [](const LoadItem& a, const LoadItem& b) { return a.path < b.path; });
+                v.erase(std::unique(v.begin(), v.end(), [](const LoadItem& a, const LoadItem& b) { return a.path == b.path; }), v.end());
+            };
+            dedup(_texturesToLoad);
+            dedup(_soundsToLoad);
+            dedup(_fontsToLoad);
+        }
 
         _totalCount = static_cast<int>(_texturesToLoad.size() + _soundsToLoad.size() + _fontsToLoad.size());
+        _totalBytes = 0;
+        for (auto* list : {&_texturesToLoad, &_soundsToLoad, &_fontsToLoad}) {
+            for (const auto& item : *list) _totalBytes += item.bytes;
+        }
         _loadStep++;
         return true;
     }
     case 3: {
-        if (_stepText) _stepText->setString(LocalisationManager::instance().get("ui.loading.assets.textures", "Loading textures..."));
+        if (_stepText) _stepText->setString(LocalisationManager::instance().view("ui.loading.assets.textures"_lk, "Loading textures..."));
         auto* cache = Director::getInstance()->getTextureCache();
-        for (const auto& path : _texturesToLoad) {
-            cache->addImageAsync(path, [this](Texture2D*) {
-                _loadedCount++;
+        for (const auto& item : _texturesToLoad) {
+            cache->addImageAsync(item.path, [this, path = item.path, bytes = item.bytes](Texture2D*) {
+                _loadedTextures.insert(path);
+                markLoaded(bytes);
                 updateProgress();
             });
         }
@@ -176,10 +197,10 @@ bool LoadingLayer::advanceLoadStep() {
         return true;
     }
     case 4: {
-        if (_stepText) _stepText->setString(LocalisationManager::instance().get("ui.loading.assets.audio", "Preloading audio..."));
-        for (const auto& path : _soundsToLoad) {
-            ax::AudioEngine::preload(path, [this](bool){
-                _loadedCount++;
+        if (_stepText) _stepText->setString(LocalisationManager::instance().view("ui.loading.assets.audio"_lk, "Preloading audio..."));
+        for (const auto& item : _soundsToLoad) {
+            ax::AudioEngine::preload(item.path, [this, bytes = item.bytes](bool){
+                markLoaded(bytes);
                 updateProgress();
             });
         }
@@ -187,22 +208,17 @@ bool LoadingLayer::advanceLoadStep() {
         return true;
     }
     case 5: {
-        if (_stepText) _stepText->setString(LocalisationManager::instance().get("ui.loading.assets.fonts", "Priming fonts..."));
-        for (const auto& f : _fontsToLoad) {
-            auto lbl = Label::createWithBMFont(f, " ");
-            (void)lbl;
-            _loadedCount++;
-        }
-        _loadStep++;
+        if (_stepText) _stepText->setString(LocalisationManager::instance().view("ui.loading.assets.fonts"_lk, "Priming fonts..."));
+        if (primeReadyFonts()) _loadStep++;
         return true;
     }
     case 6: {
-        if (_stepText) _stepText->setString(LocalisationManager::instance().get("ui.loading.systems-warmup", "Warming up systems..."));
+        if (_stepText) _stepText->setString(LocalisationManager::instance().view("ui.loading.systems-warmup"_lk, "Warming up systems..."));
         _loadStep++;
         return true;
     }
     case 7: {
-        if (_stepText) _stepText->setString(LocalisationManager::instance().get("ui.loading.finalize", "Finalising..."));
+        if (_stepText) _stepText->setString(LocalisationManager::instance().view("ui.loading.finalize"_lk, "Finalising..."));
         if (_loadedCount < _totalCount) {
             return true;
         }
@@ -210,13 +226,105 @@ bool LoadingLayer::advanceLoadStep() {
         return true;
     }
     default:
-        if (_stepText) _stepText->setString(LocalisationManager::instance().get("ui.loading.ready", "Ready"));
+        if (_stepText) _stepText->setString(LocalisationManager::instance().view("ui.loading.ready"_lk, "Ready"));
         return false;
     }
 }
 
+bool LoadingLayer::loadFromManifest() {
+    auto data = FileUtils::getInstance()->getDataFromFile(AssetManifest::FILENAME);
+    if (data.isNull()) return false;
+
+    AssetManifest manifest;
+    if (!manifest.parse(data.getBytes(), static_cast<size_t>(data.getSize())) || manifest.empty()) return false;
+
+    // Lower groups first (fonts and their page textures, then sprites, then sounds), every entry
+    // after the entries it depends on; the manifest is already path-ordered within a group
+    const auto& entries = manifest.entries();
+    std::vector<uint32_t> byGroup(entries.size());
+    std::iota(byGroup.begin(), byGroup.end(), 0u);
+    std::stable_sort(byGroup.begin(), byGroup.end(),
+                     [&entries](uint32_t a, uint32_t b) { return entries[a].group < entries[b].group; });
+
+    std::vector<uint32_t> ordered;
+    ordered.reserve(entries.size());
+    std::vector<bool> visited(entries.size(), false);
+    std::function<void(uint32_t)> visit = [&](uint32_t index) {
+        if (visited[index]) return;
+        visited[index] = true;
+        for (auto dep : entries[index].deps) {
+            if (dep < entries.size()) visit(dep);
+        }
+        ordered.push_back(index);
+    };
+    for (auto index : byGroup) visit(index);
+
+#if _AX_DEBUG
+    std::vector<std::pair<std::string, uint64_t>> hashes;
+#endif
+    for (auto index : ordered) {
+        const auto* e = &entries[index];
+        LoadItem item{std::string(e->path), std::max<uint64_t>(e->size, 1)};
+        for (auto dep : e->deps) {
+            if (dep < entries.size()) item.deps.emplace_back(entries[dep].path);
+        }
+#if _AX_DEBUG
+        hashes.emplace_back(item.path, e->hash);
+#endif
+        switch (e->type) {
+        case AssetManifest::Type::Texture: _texturesToLoad.push_back(std::move(item)); break;
+        case AssetManifest::Type::Sound: _soundsToLoad.push_back(std::move(item)); break;
+        case AssetManifest::Type::Font: _fontsToLoad.push_back(std::move(item)); break;
+        }
+    }
+
+#if _AX_DEBUG
+    // Content edited after the build is still loaded, but its manifest entry (and bar weight) is stale
+    struct HashCheck {
+        std::vector<std::pair<std::string, uint64_t>> entries;
+        std::vector<std::string> stale;
+    };
+    auto check = std::make_shared<HashCheck>();
+    check->entries = std::move(hashes);
+    Director::getInstance()->getJobSystem()->enqueue(
+        [check]() {
+            auto* fu = FileUtils::getInstance();
+            for (const auto& [path, hash] : check->entries) {
+                auto file = fu->getDataFromFile(path);
+                if (file.isNull() || XXH64(file.getBytes(), static_cast<size_t>(file.getSize()), 0) != hash)
+                    check->stale.push_back(path);
+            }
+        },
+        [check]() {
+            for (const auto& path : check->stale)
+                spdlog::warn("LoadingLayer: '{}' changed since {} was built", path, AssetManifest::FILENAME);
+        });
+#endif
+    return true;
+}
+
+bool LoadingLayer::primeReadyFonts() {
+    // A font whose page textures are still loading would load them again, synchronously
+    std::erase_if(_fontsToLoad, [this](const LoadItem& font) {
+        for (const auto& page : font.deps) {
+            if (!_loadedTextures.contains(page)) return false;
+        }
+        auto lbl = Label::createWithBMFont(font.path, " ");
+        (void)lbl;
+        markLoaded(font.bytes);
+        return true;
+    });
+    return _fontsToLoad.empty();
+}
+
+void LoadingLayer::markLoaded(uint64_t bytes) {
+    _loadedCount++;
+    _loadedBytes += bytes;
+}
+
 void LoadingLayer::updateProgress() {
-    float p = (_totalCount > 0) ? (static_cast<float>(_loadedCount) / _totalCount) : 1.f;
+    // Weighted by bytes so one large atlas does not count the same as a tiny icon
+    float p = (_totalBytes > 0) ? static_cast<float>(static_cast<double>(_loadedBytes) / _totalBytes) : 1.f;
     p = std::max(0.f, std::min(1.f, p));
 
     auto win = Director::getInstance()->getWinSize();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../Includes.hpp"
+#include <unordered_set>
 
 namespace cosmiccities {
 
@@ -16,17 +17,32 @@ private:
     bool advanceLoadStep();
     void updateProgress();
     void onFinishedLoading();
+    bool loadFromManifest();
+    bool primeReadyFonts();
+    void markLoaded(uint64_t bytes);
+
+    // bytes weights progress; it is 1 per item when assets come from a directory scan
+    struct LoadItem {
+        std::string path;
+        uint64_t bytes{1};
+        // textures that must be in the cache first (a font's pages), only known from the manifest
+        std::vector<std::string> deps;
+    };
 
     ax::DrawNode* _barBg{nullptr};
     ax::DrawNode* _barFill{nullptr};
     ax::Label* _progressText{nullptr};
     ax::Label* _stepText{nullptr};
 
-    std::vector<std::string> _texturesToLoad;
-    std::vector<std::string> _soundsToLoad;
-    std::vector<std::string> _fontsToLoad;
+    std::vector<LoadItem> _texturesToLoad;
+    std::vector<LoadItem> _soundsToLoad;
+    std::vector<LoadItem> _fontsToLoad;
+    std::unordered_set<std::string> _loadedTextures;
     int _totalCount{0};
     int _loadedCount{0};
+    uint64_t _totalBytes{0};
+    uint64_t _loadedBytes{0};
+    bool _fromManifest{false};
 
     int _loadStep{0};
     bool _stepsDone{false};
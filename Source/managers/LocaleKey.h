@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Dotted locale key ("ui.menu.start") paired with its FNV-1a hash. Literals written
+// with the _lk suffix are hashed at compile time, everything else at lookup time.
+struct LocaleKey {
+    std::string_view text;
+    uint64_t hash;
+
+    static constexpr uint64_t hashOf(std::string_view s) {
+        uint64_t h = 0xcbf29ce484222325ull;
+        for (char c : s) {
+            h ^= static_cast<uint8_t>(c);
+            h *= 0x100000001b3ull;
+        }
+        return h;
+    }
+
+    constexpr explicit LocaleKey(std::string_view s) : text(s), hash(hashOf(s)) {}
+};
+
+consteval LocaleKey operator""_lk(const char* str, size_t len) {
+    return LocaleKey(std::string_view(str, len));
+}
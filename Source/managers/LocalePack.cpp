@@ -0,0 +1,209 @@
+#include "LocalePack.h"
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace {
+    struct PendingEntry {
+        uint64_t hash;
+        uint32_t keyOffset;
+        uint32_t keyLength;
+        uint32_t valueOffset;
+        uint32_t valueLength;
+    };
+
+    void flatten(const rapidjson::Value& node, std::string& prefix, std::string& strings,
+                 std::vector<PendingEntry>& entries) {
+        for (auto it = node.MemberBegin(); it != node.MemberEnd(); ++it) {
+            const size_t mark = prefix.size();
+            if (mark != 0)
+                prefix.push_back('.');
+            prefix.append(it->name.GetString(), it->name.GetStringLength());
+
+            if (it->value.IsObject()) {
+                flatten(it->value, prefix, strings, entries);
+            } else if (it->value.IsString() && !prefix.empty()) {
+                PendingEntry e;
+                e.hash = LocaleKey::hashOf(prefix);
+                e.keyOffset = static_cast<uint32_t>(strings.size());
+                e.keyLength = static_cast<uint32_t>(prefix.size());
+                strings.append(prefix);
+                e.valueOffset = static_cast<uint32_t>(strings.size());
+                e.valueLength = it->value.GetStringLength();
+                strings.append(it->value.GetString(), it->value.GetStringLength());
+                entries.push_back(e);
+            }
+
+            prefix.resize(mark);
+        }
+    }
+}
+
+std::vector<uint8_t> LocalePack::compile(const rapidjson::Value& root, uint64_t sourceHash) {
+    std::string strings;
+    std::vector<PendingEntry> entries;
+    if (root.IsObject()) {
+        std::string prefix;
+        prefix.reserve(128);
+        flatten(root, prefix, strings, entries);
+    }
+
+    // Keep the table at most 3/4 full so probe chains stay short
+    const uint32_t slotCount = std::bit_ceil(static_cast<uint32_t>(entries.size() * 4 / 3 + 1));
+    std::vector<Slot> slots(slotCount, Slot{0, 0, 0, 0, 0});
+
+    uint32_t stored = 0;
+    for (const auto& e : entries) {
+        uint32_t idx = static_cast<uint32_t>(e.hash) & (slotCount - 1);
+        bool duplicate = false;
+        while (slots[idx].keyLength != 0) {
+            // First occurrence wins, matching rapidjson's member lookup
+            if (slots[idx].hash == e.hash && slots[idx].keyLength == e.keyLength &&
+                std::memcmp(strings.data() + slots[idx].keyOffset, strings.data() + e.keyOffset, e.keyLength) == 0) {
+                duplicate = true;
+                break;
+            }
+            idx = (idx + 1) & (slotCount - 1);
+        }
+        if (duplicate)
+            continue;
+
+        slots[idx] = Slot{e.hash, e.keyOffset, e.keyLength, e.valueOffset, e.valueLength};
+        ++stored;
+    }
+
+    Header header;
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.entryCount = stored;
+    header.slotCount = slotCount;
+    header.slotsOffset = sizeof(Header);
+    header.stringsOffset = header.slotsOffset + slotCount * sizeof(Slot);
+    header.stringsSize = static_cast<uint32_t>(strings.size());
+    header.reserved = 0;
+    header.sourceHash = sourceHash;
+
+    std::vector<uint8_t> bytes(header.stringsOffset + strings.size());
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    std::memcpy(bytes.data() + header.slotsOffset, slots.data(), slotCount * sizeof(Slot));
+    std::memcpy(bytes.data() + header.stringsOffset, strings.data(), strings.size());
+    return bytes;
+}
+
+bool LocalePack::compileFile(const std::string& jsonPath, const std::string& outPath) {
+    std::ifstream file(jsonPath, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    std::string json{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    rapidjson::Document doc;
+    doc.Parse(json.data(), json.size());
+    if (doc.HasParseError())
+        return false;
+
+    return writeFile(outPath, compile(doc, hashSource(json)));
+}
+
+bool LocalePack::writeFile(const std::string& outPath, const std::vector<uint8_t>& bytes) {
+    std::error_code ec;
+    auto parent = std::filesystem::path(outPath).parent_path();
+    if (!parent.empty())
+        std::filesystem::create_directories(parent, ec);
+
+    // Write beside the target and rename so a mapped pack is never truncated under a reader
+    const std::string tmpPath = outPath + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!file)
+            return false;
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!file.good())
+            return false;
+    }
+
+    std::filesystem::rename(tmpPath, outPath, ec);
+    if (ec) {
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool LocalePack::openFile(const std::string& path) {
+    close();
+
+    std::error_code ec;
+    _mapping.map(path, ec);
+    if (ec)
+        return false;
+
+    if (!bind(reinterpret_cast<const uint8_t*>(_mapping.data()), _mapping.size())) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void LocalePack::adopt(std::vector<uint8_t>&& bytes) {
+    close();
+    _owned = std::move(bytes);
+    if (!bind(_owned.data(), _owned.size()))
+        close();
+}
+
+void LocalePack::close() {
+    _mapping.unmap();
+    _owned.clear();
+    _header = nullptr;
+    _slots = nullptr;
+    _strings = nullptr;
+}
+
+bool LocalePack::bind(const uint8_t* data, size_t size) {
+    if (!data || size < sizeof(Header))
+        return false;
+
+    const auto* header = reinterpret_cast<const Header*>(data);
+    if (header->magic != MAGIC || header->version != VERSION)
+        return false;
+    if (header->slotCount == 0 || !std::has_single_bit(header->slotCount))
+        return false;
+    if (header->slotsOffset < sizeof(Header) || header->slotsOffset % alignof(Slot) != 0)
+        return false;
+    if (static_cast<uint64_t>(header->slotsOffset) + static_cast<uint64_t>(header->slotCount) * sizeof(Slot) >
+        header->stringsOffset)
+        return false;
+    if (static_cast<uint64_t>(header->stringsOffset) + header->stringsSize > size)
+        return false;
+
+    _header = header;
+    _slots = reinterpret_cast<const Slot*>(data + header->slotsOffset);
+    _strings = reinterpret_cast<const char*>(data + header->stringsOffset);
+    return true;
+}
+
+bool LocalePack::find(uint64_t hash, std::string_view key, std::string_view& out) const {
+    if (!_header)
+        return false;
+
+    const uint32_t mask = _header->slotCount - 1;
+    uint32_t idx = static_cast<uint32_t>(hash) & mask;
+    for (uint32_t probes = 0; probes <= mask; ++probes) {
+        const Slot& slot = _slots[idx];
+        if (slot.keyLength == 0)
+            return false;
+
+        if (slot.hash == hash && slot.keyLength == key.size() &&
+            static_cast<uint64_t>(slot.keyOffset) + slot.keyLength <= _header->stringsSize &&
+            std::memcmp(_strings + slot.keyOffset, key.data(), key.size()) == 0) {
+            if (static_cast<uint64_t>(slot.valueOffset) + slot.valueLength > _header->stringsSize)
+                return false;
+            out = std::string_view(_strings + slot.valueOffset, slot.valueLength);
+            return true;
+        }
+        idx = (idx + 1) & mask;
+    }
+    return false;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "LocaleKey.h"
+#include "rapidjson/document.h"
+#include "mio/mio.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Compact binary form of a locale JSON file (.ccloc).
+//
+// Layout: a Header, then slotCount Slots forming an open-addressed
+// hash table keyed by the FNV-1a hash of the dotted key (see LocaleKey), then a string
+// table holding every key and value. Packs are memory-mapped and served in place, so
+// switching language costs one mmap no matter how many strings the locale has.
+//
+// Packs are produced at build time by CosmicCitiesLocalePack, or on first run into the
+// writable path when only the JSON ships (e.g. when cross-compiling). Each pack records a
+// hash of the JSON bytes it was compiled from; a pack whose hash no longer matches its
+// source is stale. Timestamps are not used since they cannot be read inside an APK.
+class LocalePack {
+public:
+    static constexpr uint32_t MAGIC = 0x504C4343; // "CCLP"
+    static constexpr uint32_t VERSION = 2;
+    static constexpr const char* EXTENSION = ".ccloc";
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t slotCount;   // power of two
+        uint32_t slotsOffset;
+        uint32_t stringsOffset;
+        uint32_t stringsSize;
+        uint32_t reserved;
+        uint64_t sourceHash;  // hashSource() of the JSON the pack was compiled from
+    };
+
+    struct Slot {
+        uint64_t hash;
+        uint32_t keyOffset;
+        uint32_t keyLength;   // 0 marks an empty slot
+        uint32_t valueOffset;
+        uint32_t valueLength;
+    };
+
+    static uint64_t hashSource(std::string_view json) { return LocaleKey::hashOf(json); }
+
+    // Flatten a parsed locale document into pack bytes
+    static std::vector<uint8_t> compile(const rapidjson::Value& root, uint64_t sourceHash = 0);
+    // Parse a locale JSON file and write its pack to outPath
+    static bool compileFile(const std::string& jsonPath, const std::string& outPath);
+    static bool writeFile(const std::string& outPath, const std::vector<uint8_t>& bytes);
+
+    bool openFile(const std::string& path);
+    void adopt(std::vector<uint8_t>&& bytes);
+    void close();
+
+    bool isOpen() const { return _header != nullptr; }
+    uint32_t size() const { return _header ? _header->entryCount : 0; }
+    uint64_t sourceHash() const { return _header ? _header->sourceHash : 0; }
+
+    // Returns false when the key is absent; never allocates
+    bool find(uint64_t hash, std::string_view key, std::string_view& out) const;
+
+private:
+    bool bind(const uint8_t* data, size_t size);
+
+    mio::mmap_source _mapping;
+    std::vector<uint8_t> _owned;
+
+    const Header* _header{nullptr};
+    const Slot* _slots{nullptr};
+    const char* _strings{nullptr};
+};
@@ -1,6 +1,25 @@
 #include "LocalisationManager.h"
 #include "rapidjson/istreamwrapper.h"
 #include "rapidjson/error/en.h"
+#include <filesystem>
+#include <iterator>
+
+namespace {
+    // Through FileUtils when it is up, so the JSON is also found inside an APK
+    bool readSource(const std::string& path, std::string& out) {
+        if (auto* fu = ax::FileUtils::getInstance()) {
+            out = fu->getStringFromFile(path);
+            if (!out.empty())
+                return true;
+        }
+
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+            return false;
+        out.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+}
 
 LocalisationManager& LocalisationManager::instance() {
     static LocalisationManager inst;
@@ -8,20 +27,39 @@ LocalisationManager& LocalisationManager::instance() {
 }
 
 bool LocalisationManager::loadLanguage(const std::string& path) {
-    std::ifstream file(path);
-    if (!file.is_open()) {
+    // The source hash tells whether a pack is still current; after the first load of a language
+    // it is reused, so switching back to it only opens the pack
+    std::string json;
+    uint64_t sourceHash = 0;
+    const bool hasSource = sourceHashFor(path, sourceHash, json);
+
+    // Prefer the pack shipped beside the JSON, then the one cached on a previous run
+    const std::string shippedPack = std::filesystem::path(path).replace_extension(LocalePack::EXTENSION).string();
+    const std::string cachedPack = cachedPackPath(path);
+    if (openPack(shippedPack, hasSource, sourceHash) || (hasSource && openPack(cachedPack, true, sourceHash))) {
+        m_currentPath = path;
+        return true;
+    }
+
+    if (!hasSource || (json.empty() && !readSource(path, json))) {
         return false;
     }
 
-    rapidjson::IStreamWrapper isw(file);
-    m_languageData.ParseStream(isw);
+    rapidjson::Document languageData;
+    languageData.Parse(json.data(), json.size());
     
-    if (m_languageData.HasParseError()) {
+    if (languageData.HasParseError()) {
         return false;
     }
+
+    auto bytes = LocalePack::compile(languageData, sourceHash);
+    if (!cachedPack.empty()) {
+        LocalePack::writeFile(cachedPack, bytes);
+    }
+    m_pack.adopt(std::move(bytes));
     
     m_currentPath = path;
-    return true;
+    return m_pack.isOpen();
 }
 
 bool LocalisationManager::setLanguage(const std::string& path) {
@@ -35,28 +73,65 @@ bool LocalisationManager::setLanguage(const std::string& path) {
     }
 
     loadIndex();
+    cacheLocaleInfo();
     return true;
 }
 
-std::string LocalisationManager::get(const std::string& key, const std::string& fallback) const {
-    if (m_languageData.IsNull() || !m_languageData.IsObject())
-        return fallback;
-
-    const rapidjson::Value* current = &m_languageData;
+bool LocalisationManager::openPack(const std::string& packPath, bool checkSource, uint64_t sourceHash) {
+    if (packPath.empty() || !m_pack.openFile(packPath))
+        return false;
 
-    std::stringstream ss(key);
-    std::string token;
+    // Without a readable source the shipped pack is all there is, so it is trusted as is
+    if (checkSource && m_pack.sourceHash() != sourceHash) {
+        m_pack.close();
+        return false;
+    }
+    return true;
+}
 
-    while (std::getline(ss, token, '.')) {
-        if (!current->IsObject() || !current->HasMember(token.c_str()))
-            return fallback;
-        current = &(*current)[token.c_str()];
+bool LocalisationManager::sourceHashFor(const std::string& path, uint64_t& hash, std::string& json) {
+    // A size check through FileUtils is a stat (or an APK directory lookup), unlike reading the file
+    auto* fu = ax::FileUtils::getInstance();
+    const int64_t size = fu ? fu->getFileSize(path) : -1;
+    auto known = m_sourceHashes.find(path);
+    if (known != m_sourceHashes.end() && size >= 0 && known->second.size == size) {
+        hash = known->second.hash;
+        return true;
     }
 
-    if (current->IsString())
-        return current->GetString();
+    if (!readSource(path, json))
+        return false;
 
-    return fallback;
+    hash = LocalePack::hashSource(json);
+    m_sourceHashes[path] = {static_cast<int64_t>(json.size()), hash};
+    return true;
+}
+
+std::string LocalisationManager::cachedPackPath(const std::string& jsonPath) const {
+    auto* fu = ax::FileUtils::getInstance();
+    std::string writable = fu ? fu->getWritablePath() : std::string();
+    if (writable.empty())
+        return {};
+
+    // The source path is part of the name so same-named JSON files in different folders do not collide
+    auto stem = std::filesystem::path(jsonPath).stem().string();
+    return fmt::format("{}locales/{}-{:016x}{}", writable, stem, LocaleKey::hashOf(jsonPath), LocalePack::EXTENSION);
+}
+
+std::string LocalisationManager::get(const std::string& key, const std::string& fallback) const {
+    std::string_view value;
+    if (!m_pack.find(LocaleKey::hashOf(key), key, value))
+        return fallback;
+
+    return std::string(value);
+}
+
+std::string_view LocalisationManager::view(const LocaleKey& key, std::string_view fallback) const {
+    std::string_view value;
+    if (!m_pack.find(key.hash, key.text, value))
+        return fallback;
+
+    return value;
 }
 
 const std::string& LocalisationManager::currentPath() const {
@@ -67,46 +142,23 @@ const std::string& LocalisationManager::currentLocale() const {
     return m_currentLocale;
 }
 
-std::string LocalisationManager::getFontPath() const {
-    if (!m_indexData.IsNull() && m_indexData.IsObject() && !m_currentLocale.empty()) {
-        if (m_indexData.HasMember(m_currentLocale.c_str())) {
-            const auto& localeObj = m_indexData[m_currentLocale.c_str()];
-            if (localeObj.IsObject() && localeObj.HasMember("font") && localeObj["font"].IsString()) {
-                return localeObj["font"].GetString();
-            }
-        }
-    }
-    
-    return "fonts/seven_fifteen/seven_fifteen.fnt";
+const std::string& LocalisationManager::getFontPath() const {
+    return m_currentInfo.font;
 }
 
-std::string LocalisationManager::getLanguageName() const {
-    if (!m_indexData.IsNull() && m_indexData.IsObject() && !m_currentLocale.empty()) {
-        if (m_indexData.HasMember(m_currentLocale.c_str())) {
-            const auto& localeObj = m_indexData[m_currentLocale.c_str()];
-            if (localeObj.IsObject() && localeObj.HasMember("language") && localeObj["language"].IsString()) {
-                return localeObj["language"].GetString();
-            }
-        }
-    }
-    
-    return "";
+const std::string& LocalisationManager::getLanguageName() const {
+    return m_currentInfo.language;
 }
 
-std::string LocalisationManager::getRegion() const {
-    if (!m_indexData.IsNull() && m_indexData.IsObject() && !m_currentLocale.empty()) {
-        if (m_indexData.HasMember(m_currentLocale.c_str())) {
-            const auto& localeObj = m_indexData[m_currentLocale.c_str()];
-            if (localeObj.IsObject() && localeObj.HasMember("region") && localeObj["region"].IsString()) {
-                return localeObj["region"].GetString();
-            }
-        }
-    }
-    
-    return "";
+const std::string& LocalisationManager::getRegion() const {
+    return m_currentInfo.region;
 }
 
 bool LocalisationManager::loadIndex() {
+    // The index lists every locale; parse it once rather than on each language switch
+    if (m_indexLoaded)
+        return true;
+
     std::ifstream file("Content/locales/index.json");
     if (!file.is_open())
         return false;
@@ -118,26 +170,34 @@ bool LocalisationManager::loadIndex() {
         return false;
     }
     
+    m_indexLoaded = true;
     return true;
 }
 
-ax::Label* LocalisationManager::createLabel(const std::string& key, const std::string& fallback) const {
-    std::string text = get(key, fallback);
-    std::string fontPath;
-
-    if (!m_indexData.IsNull() && m_indexData.IsObject() && !m_currentLocale.empty()) {
-        if (m_indexData.HasMember(m_currentLocale.c_str())) {
-            const auto& localeObj = m_indexData[m_currentLocale.c_str()];
-            if (localeObj.IsObject() && localeObj.HasMember("font") && localeObj["font"].IsString()) {
-                fontPath = localeObj["font"].GetString();
-            }
-        }
-    }
+void LocalisationManager::cacheLocaleInfo() {
+    m_currentInfo = LocaleInfo{};
+
+    if (!m_indexLoaded || !m_indexData.IsObject() || m_currentLocale.empty())
+        return;
 
-    if (fontPath.empty()) {
-        fontPath = "fonts/seven_fifteen/seven_fifteen.fnt";
+    auto it = m_indexData.FindMember(m_currentLocale.c_str());
+    if (it == m_indexData.MemberEnd() || !it->value.IsObject())
+        return;
+
+    const auto& localeObj = it->value;
+    if (localeObj.HasMember("font") && localeObj["font"].IsString()) {
+        m_currentInfo.font = localeObj["font"].GetString();
+    }
+    if (localeObj.HasMember("language") && localeObj["language"].IsString()) {
+        m_currentInfo.language = localeObj["language"].GetString();
+    }
+    if (localeObj.HasMember("region") && localeObj["region"].IsString()) {
+        m_currentInfo.region = localeObj["region"].GetString();
     }
+}
 
-    auto* label = ax::Label::createWithBMFont(fontPath, text);
+ax::Label* LocalisationManager::createLabel(const std::string& key, const std::string& fallback) const {
+    std::string text = get(key, fallback);
+    auto* label = ax::Label::createWithBMFont(getFontPath(), text);
     return label;
 }
@@ -1,8 +1,11 @@
 #pragma once
 
 #include "../Includes.hpp"
+#include "LocaleKey.h"
+#include "LocalePack.h"
 #include "rapidjson/document.h"
 #include <fmt/format.h>
+#include <string_view>
 
 class LocalisationManager {
 public:
@@ -12,6 +15,9 @@ public:
     bool setLanguage(const std::string& path);
 
     std::string get(const std::string& key, const std::string& fallback = "") const;
+
+    // Allocation-free lookup; the returned view stays valid until the next language load
+    std::string_view view(const LocaleKey& key, std::string_view fallback = {}) const;
     
     template<typename... Args>
     std::string get(const std::string& key, const std::string& fallback, Args&&... args) const {
@@ -32,37 +38,44 @@ public:
             text = fmt::vformat(text, fmt::make_format_args(std::forward<Args>(args)...));
         } catch (const std::exception&) {}
         
-        std::string fontPath;
-        if (!m_indexData.IsNull() && m_indexData.IsObject() && !m_currentLocale.empty()) {
-            if (m_indexData.HasMember(m_currentLocale.c_str())) {
-                const auto& localeObj = m_indexData[m_currentLocale.c_str()];
-                if (localeObj.IsObject() && localeObj.HasMember("font") && localeObj["font"].IsString()) {
-                    fontPath = localeObj["font"].GetString();
-                }
-            }
-        }
-        
-        if (fontPath.empty()) {
-            fontPath = "fonts/seven_fifteen/seven_fifteen.fnt";
-        }
-        
-        auto* label = ax::Label::createWithBMFont(fontPath, text);
+        auto* label = ax::Label::createWithBMFont(getFontPath(), text);
         return label;
     }
     
-    std::string getFontPath() const;
-    std::string getLanguageName() const;
-    std::string getRegion() const;
+    // Cached from Content/locales/index.json for the current locale
+    const std::string& getFontPath() const;
+    const std::string& getLanguageName() const;
+    const std::string& getRegion() const;
 
     const std::string& currentPath() const;
     const std::string& currentLocale() const;
 
 private:
     LocalisationManager() = default;
+
+    struct LocaleInfo {
+        std::string font{"fonts/seven_fifteen/seven_fifteen.fnt"};
+        std::string language;
+        std::string region;
+    };
+
     bool loadIndex();
+    void cacheLocaleInfo();
+    bool openPack(const std::string& packPath, bool checkSource, uint64_t sourceHash);
+    std::string cachedPackPath(const std::string& jsonPath) const;
+    // Reads (into json) and hashes the source only when its size changed since it was last hashed
+    bool sourceHashFor(const std::string& path, uint64_t& hash, std::string& json);
+
+    struct SourceHash {
+        int64_t size;
+        uint64_t hash;
+    };
 
-    rapidjson::Document m_languageData;
+    LocalePack m_pack;
     rapidjson::Document m_indexData;
+    bool m_indexLoaded = false;
+    LocaleInfo m_currentInfo;
     std::string m_currentPath;
     std::string m_currentLocale;
+    std::unordered_map<std::string, SourceHash> m_sourceHashes;
 };
@@ -0,0 +1,144 @@
+#include "AssetManifest.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace cosmiccities {
+
+uint32_t AssetManifest::Builder::add(std::string_view path, Type type, uint8_t group, uint64_t size, uint64_t hash) {
+    _entries.push_back({std::string(path), type, group, size, hash, {}});
+    return static_cast<uint32_t>(_entries.size() - 1);
+}
+
+void AssetManifest::Builder::addDependency(uint32_t entry, uint32_t dependsOn) {
+    if (entry >= _entries.size() || dependsOn >= _entries.size() || entry == dependsOn) return;
+
+    auto& deps = _entries[entry].deps;
+    if (std::find(deps.begin(), deps.end(), dependsOn) == deps.end()) {
+        deps.push_back(dependsOn);
+    }
+}
+
+void AssetManifest::Builder::propagateGroups() {
+    // Dependency chains are shallow (font -> page textures), so relax until stable
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (const auto& e : _entries) {
+            for (auto dep : e.deps) {
+                if (_entries[dep].group > e.group) {
+                    _entries[dep].group = e.group;
+                    changed = true;
+                }
+            }
+        }
+    }
+}
+
+std::vector<uint8_t> AssetManifest::Builder::finish() const {
+    std::vector<EntryRecord> records;
+    std::vector<uint32_t> deps;
+    std::string strings;
+    uint64_t totalBytes = 0;
+
+    records.reserve(_entries.size());
+    for (const auto& e : _entries) {
+        EntryRecord rec{};
+        rec.size = e.size;
+        rec.hash = e.hash;
+        rec.pathOffset = static_cast<uint32_t>(strings.size());
+        rec.pathLength = static_cast<uint32_t>(e.path.size());
+        rec.firstDep = static_cast<uint32_t>(deps.size());
+        rec.depCount = static_cast<uint32_t>(e.deps.size());
+        rec.type = e.type;
+        rec.group = e.group;
+        records.push_back(rec);
+
+        strings.append(e.path);
+        deps.insert(deps.end(), e.deps.begin(), e.deps.end());
+        totalBytes += e.size;
+    }
+
+    Header header{};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.entryCount = static_cast<uint32_t>(records.size());
+    header.depCount = static_cast<uint32_t>(deps.size());
+    header.totalBytes = totalBytes;
+    header.entriesOffset = sizeof(Header);
+    header.depsOffset = header.entriesOffset + header.entryCount * sizeof(EntryRecord);
+    header.stringsOffset = header.depsOffset + header.depCount * sizeof(uint32_t);
+    header.stringsSize = static_cast<uint32_t>(strings.size());
+
+    std::vector<uint8_t> bytes(header.stringsOffset + strings.size());
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    std::memcpy(bytes.data() + header.entriesOffset, records.data(), records.size() * sizeof(EntryRecord));
+    std::memcpy(bytes.data() + header.depsOffset, deps.data(), deps.size() * sizeof(uint32_t));
+    std::memcpy(bytes.data() + header.stringsOffset, strings.data(), strings.size());
+    return bytes;
+}
+
+bool AssetManifest::typeForExtension(std::string_view ext, Type& out) {
+    std::string lower(ext);
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return std::tolower(c); });
+
+    if (lower == "png" || lower == "jpg" || lower == "jpeg") {
+        out = Type::Texture;
+    } else if (lower == "mp3" || lower == "ogg" || lower == "wav") {
+        out = Type::Sound;
+    } else if (lower == "fnt") {
+        out = Type::Font;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool AssetManifest::parse(const uint8_t* data, size_t size) {
+    _entries.clear();
+    _owned.clear();
+    _totalBytes = 0;
+
+    if (!data || size < sizeof(Header)) return false;
+
+    // Copy so the records are suitably aligned whatever buffer the caller read into
+    _owned.assign(data, data + size);
+    const auto* bytes = _owned.data();
+
+    Header header;
+    std::memcpy(&header, bytes, sizeof(header));
+    if (header.magic != MAGIC || header.version != VERSION) return false;
+
+    const uint64_t entriesEnd = header.entriesOffset + uint64_t(header.entryCount) * sizeof(EntryRecord);
+    const uint64_t depsEnd = header.depsOffset + uint64_t(header.depCount) * sizeof(uint32_t);
+    if (header.entriesOffset < sizeof(Header) || entriesEnd > header.depsOffset || depsEnd > header.stringsOffset ||
+        uint64_t(header.stringsOffset) + header.stringsSize > size)
+        return false;
+
+    const auto* records = reinterpret_cast<const EntryRecord*>(bytes + header.entriesOffset);
+    const auto* deps = reinterpret_cast<const uint32_t*>(bytes + header.depsOffset);
+    const char* strings = reinterpret_cast<const char*>(bytes + header.stringsOffset);
+
+    _entries.resize(header.entryCount);
+    for (uint32_t i = 0; i < header.entryCount; ++i) {
+        const auto& rec = records[i];
+        if (uint64_t(rec.pathOffset) + rec.pathLength > header.stringsSize ||
+            uint64_t(rec.firstDep) + rec.depCount > header.depCount) {
+            _entries.clear();
+            return false;
+        }
+
+        auto& e = _entries[i];
+        e.path = std::string_view(strings + rec.pathOffset, rec.pathLength);
+        e.type = rec.type;
+        e.group = rec.group;
+        e.size = rec.size;
+        e.hash = rec.hash;
+        e.deps = std::span<const uint32_t>(deps + rec.firstDep, rec.depCount);
+    }
+
+    _totalBytes = header.totalBytes;
+    return true;
+}
+
+} // namespace cosmiccities
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cosmiccities {
+
+// Prebuilt list of preloadable assets (assets.ccman at the content root).
+//
+// Written at build time by CosmicCitiesAssetManifest so LoadingLayer does not have to
+// crawl the content folders on boot. Each entry records its path relative to the
+// content root, asset type, size (which weights the loading bar), XXH64 content hash (debug
+// builds check it to report entries that went stale), priority group (lower loads first)
+// and the entries it depends on (e.g. a bitmap font's page textures).
+class AssetManifest {
+public:
+    static constexpr uint32_t MAGIC = 0x4D414343; // "CCAM"
+    static constexpr uint32_t VERSION = 3;
+    static constexpr const char* FILENAME = "assets.ccman";
+
+    enum class Type : uint8_t {
+        Texture,
+        Sound,
+        Font,
+    };
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t depCount;
+        uint64_t totalBytes;
+        uint32_t entriesOffset;
+        uint32_t depsOffset;
+        uint32_t stringsOffset;
+        uint32_t stringsSize;
+    };
+
+    struct EntryRecord {
+        uint64_t size;
+        uint64_t hash;
+        uint32_t pathOffset;
+        uint32_t pathLength;
+        uint32_t firstDep;
+        uint32_t depCount;
+        Type type;
+        uint8_t group;
+        uint16_t reserved;
+        uint32_t padding;
+    };
+
+    struct Entry {
+        std::string_view path;
+        Type type{Type::Texture};
+        uint8_t group{0};
+        uint64_t size{0};
+        uint64_t hash{0};
+        std::span<const uint32_t> deps;
+    };
+
+    class Builder {
+    public:
+        uint32_t add(std::string_view path, Type type, uint8_t group, uint64_t size, uint64_t hash);
+        void addDependency(uint32_t entry, uint32_t dependsOn);
+        // Pulls dependencies into the earliest group of anything that needs them
+        void propagateGroups();
+        std::vector<uint8_t> finish() const;
+
+    private:
+        struct Pending {
+            std::string path;
+            Type type;
+            uint8_t group;
+            uint64_t size;
+            uint64_t hash;
+            std::vector<uint32_t> deps;
+        };
+        std::vector<Pending> _entries;
+    };
+
+    static bool typeForExtension(std::string_view ext, Type& out);
+
+    bool parse(const uint8_t* data, size_t size);
+
+    bool empty() const { return _entries.empty(); }
+    const std::vector<Entry>& entries() const { return _entries; }
+    uint64_t totalBytes() const { return _totalBytes; }
+
+private:
+    std::vector<uint8_t> _owned;
+    std::vector<Entry> _entries;
+    uint64_t _totalBytes{0};
+};
+
+} // namespace cosmiccities
@@ -215,7 +215,7 @@ void InputManager::updateBackspaceHold(float dt) {
         backspaceDotsCount++;
         if (quitLabel) {
             std::string text = fmt::format("{}{}",
-                LocalisationManager::instance().get("ui.general.quitting"),
+                LocalisationManager::instance().view("ui.general.quitting"_lk),
                 std::string(backspaceDotsCount, '.'));
             quitLabel->setString(text);
         }
@@ -0,0 +1,249 @@
+// AssetsManagerEx delta updates end to end: a local HTTP server serves the remote manifest, the delta
+// and the whole asset, and the update must leave the new version in storage whether the delta applies
+// or has to be replaced by a whole download.
+
+#include "assets-manager/AssetsManagerEx.h"
+#include "assets-manager/DeltaPatch.h"
+#include "assets-manager/EventListenerAssetsManagerEx.h"
+#include "base/Director.h"
+#include "base/EventDispatcher.h"
+#include "base/Scheduler.h"
+#include "fmt/format.h"
+#include "yasio/xxsocket.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+using ax::extension::AssetsManagerEx;
+using ax::extension::DeltaPatch;
+using ax::extension::EventAssetsManagerEx;
+using ax::extension::EventListenerAssetsManagerEx;
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+
+Bytes noise(size_t size, uint32_t seed) {
+    Bytes bytes(size);
+    for (auto& byte : bytes) {
+        seed = seed * 1664525u + 1013904223u;
+        byte = static_cast<uint8_t>(seed >> 24);
+    }
+    return bytes;
+}
+
+Bytes toBytes(const std::string& text) { return Bytes(text.begin(), text.end()); }
+
+void writeFile(const fs::path& path, const Bytes& bytes) {
+    fs::create_directories(path.parent_path());
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+Bytes readFile(const fs::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    return Bytes(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// Serves GET requests for a fixed set of files, one connection per request, on an ephemeral port
+class HttpServer {
+public:
+    HttpServer() {
+        _socket.pserve("127.0.0.1", 0);
+        _port = _socket.local_endpoint().port();
+        _thread = std::thread([this] { serve(); });
+    }
+
+    ~HttpServer() {
+        _stopping = true;
+        // wakes the blocking accept
+        yasio::xxsocket wake;
+        wake.pconnect("127.0.0.1", _port);
+        _thread.join();
+    }
+
+    std::string url() const { return "http://127.0.0.1:" + std::to_string(_port) + "/"; }
+
+    void setFile(const std::string& path, Bytes bytes) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _files[path] = std::move(bytes);
+    }
+
+    int requestCount(const std::string& path) const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return static_cast<int>(std::count(_requests.begin(), _requests.end(), path));
+    }
+
+private:
+    void serve() {
+        for (;;) {
+            yasio::xxsocket client = _socket.accept();
+            if (_stopping) break;
+            if (client.is_open()) respond(client);
+        }
+    }
+
+    void respond(yasio::xxsocket& client) {
+        std::string request;
+        char buf[1024];
+        while (request.find("\r\n\r\n") == std::string::npos) {
+            int n = client.recv(buf, sizeof(buf));
+            if (n <= 0) return;
+            request.append(buf, n);
+        }
+
+        // "GET /<path> HTTP/1.1"
+        auto begin = request.find(' ') + 2;
+        auto path = request.substr(begin, request.find(' ', begin) - begin);
+
+        Bytes body;
+        bool found;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _requests.push_back(path);
+            auto it = _files.find(path);
+            found = it != _files.end();
+            if (found) body = it->second;
+        }
+
+        auto response = toBytes((found ? "HTTP/1.1 200 OK\r\n" : "HTTP/1.1 404 Not Found\r\n") +
+                                std::string("Content-Length: ") + std::to_string(body.size()) +
+                                "\r\nConnection: close\r\n\r\n");
+        response.insert(response.end(), body.begin(), body.end());
+        for (size_t sent = 0; sent < response.size();) {
+            int n = client.send(response.data() + sent, static_cast<int>(response.size() - sent));
+            if (n <= 0) return;
+            sent += n;
+        }
+    }
+
+    yasio::xxsocket _socket;
+    unsigned short _port = 0;
+    std::atomic<bool> _stopping{false};
+    std::thread _thread;
+    mutable std::mutex _mutex;
+    std::map<std::string, Bytes> _files;
+    std::vector<std::string> _requests;
+};
+
+struct UpdateResult {
+    AssetsManagerEx::State state;
+    Bytes updated;
+    float maxPercent = 0;
+};
+
+// Installs v1 of data.bin with its manifest, publishes v2 with a delta, and runs the update to the end
+UpdateResult runUpdate(HttpServer& server, const Bytes& installed, const Bytes& target, const Bytes& delta) {
+    const fs::path root = fs::temp_directory_path() / "cosmic-cities-patch-test";
+    fs::remove_all(root);
+
+    const auto localManifest = fmt::format(R"({{
+        "packageUrl": "{0}",
+        "remoteManifestUrl": "{0}project.manifest",
+        "version": "1.0.0",
+        "assets": {{ "data.bin": {{ "md5": "v1", "size": {1} }} }}
+    }})",
+                                           server.url(), installed.size());
+    const auto remoteManifest = fmt::format(R"({{
+        "packageUrl": "{0}",
+        "remoteManifestUrl": "{0}project.manifest",
+        "version": "1.1.0",
+        "assets": {{ "data.bin": {{ "md5": "v2", "size": {1},
+            "patch": {{ "from": "v1", "path": "data.bin.axdp", "size": {2} }} }} }}
+    }})",
+                                            server.url(), target.size(), delta.size());
+
+    writeFile(root / "app" / "project.manifest", toBytes(localManifest));
+    writeFile(root / "app" / "data.bin", installed);
+    server.setFile("project.manifest", toBytes(remoteManifest));
+    server.setFile("data.bin", target);
+    server.setFile("data.bin.axdp", delta);
+
+    auto director = ax::Director::getInstance();
+    auto manager = AssetsManagerEx::create((root / "app" / "project.manifest").generic_string(),
+                                           (root / "storage").generic_string() + "/");
+    manager->retain();
+
+    UpdateResult result;
+    auto listener = EventListenerAssetsManagerEx::create(manager, [&](EventAssetsManagerEx* event) {
+        // byte progress of the asset, against the total size
+        if (event->getEventCode() == EventAssetsManagerEx::EventCode::UPDATE_PROGRESSION &&
+            event->getAssetId() == "data.bin") {
+            result.maxPercent = std::max(result.maxPercent, event->getPercent());
+        }
+    });
+    director->getEventDispatcher()->addEventListenerWithFixedPriority(listener, 1);
+
+    manager->update();
+    // downloads and patch jobs complete on the scheduler
+    for (int i = 0; i < 2000; ++i) {
+        auto state = manager->getState();
+        if (state == AssetsManagerEx::State::UP_TO_DATE || state == AssetsManagerEx::State::FAIL_TO_UPDATE) break;
+        director->getScheduler()->update(0.1f);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    result.state = manager->getState();
+    result.updated = readFile(root / "storage" / "data.bin");
+
+    director->getEventDispatcher()->removeEventListener(listener);
+    manager->release();
+    fs::remove_all(root);
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("Modified assets update through their delta", "[assetsmanager][deltapatch]") {
+    HttpServer server;
+    const Bytes base = noise(256 * 1024, 1);
+    Bytes target = base;
+    auto inserted = noise(4096, 3);
+    target.insert(target.begin() + 100000, inserted.begin(), inserted.end());
+    const Bytes delta = DeltaPatch::create(base.data(), base.size(), target.data(), target.size());
+
+    SECTION("the delta applies to the installed version") {
+        auto result = runUpdate(server, base, target, delta);
+        REQUIRE(result.state == AssetsManagerEx::State::UP_TO_DATE);
+        CHECK(result.updated == target);
+        CHECK(server.requestCount("data.bin.axdp") == 1);
+        CHECK(server.requestCount("data.bin") == 0);
+        CHECK(result.maxPercent <= 100.0f);
+    }
+
+    SECTION("the installed file is not the one the delta was made against") {
+        Bytes installed = base;
+        installed[5000] ^= 0xff;
+        auto result = runUpdate(server, installed, target, delta);
+        REQUIRE(result.state == AssetsManagerEx::State::UP_TO_DATE);
+        CHECK(result.updated == target);
+        CHECK(server.requestCount("data.bin.axdp") == 1);
+        CHECK(server.requestCount("data.bin") == 1);
+        // the whole download replaces the delta in the total instead of overflowing it
+        CHECK(result.maxPercent <= 100.0f);
+    }
+
+    SECTION("the delta was damaged") {
+        Bytes corrupt = delta;
+        corrupt[corrupt.size() / 2] ^= 0xff;
+        auto result = runUpdate(server, base, target, corrupt);
+        REQUIRE(result.state == AssetsManagerEx::State::UP_TO_DATE);
+        CHECK(result.updated == target);
+        CHECK(server.requestCount("data.bin.axdp") == 1);
+        CHECK(server.requestCount("data.bin") == 1);
+        CHECK(result.maxPercent <= 100.0f);
+    }
+}
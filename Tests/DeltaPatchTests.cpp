@@ -0,0 +1,167 @@
+// DeltaPatch: deltas built from a base must rebuild the target exactly, and any delta that does not
+// belong to the base it is applied to, or that was damaged on the way, must be rejected with the
+// matching result instead of producing a file.
+
+#include "assets-manager/DeltaPatch.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using ax::extension::DeltaPatch;
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+
+// Deterministic filler, so a failure reproduces with the same bytes
+Bytes noise(size_t size, uint32_t seed) {
+    Bytes bytes(size);
+    for (auto& byte : bytes) {
+        seed = seed * 1664525u + 1013904223u;
+        byte = static_cast<uint8_t>(seed >> 24);
+    }
+    return bytes;
+}
+
+Bytes makeDelta(const Bytes& base, const Bytes& target) {
+    return DeltaPatch::create(base.data(), base.size(), target.data(), target.size());
+}
+
+// Applies from memory, feeding the delta in small reads so instructions straddle them
+DeltaPatch::Result apply(const Bytes& base, const Bytes& delta, Bytes& out) {
+    size_t deltaPos = 0;
+    out.clear();
+    return DeltaPatch::apply(
+        [&](uint64_t offset, void* buf, uint32_t size) -> int64_t {
+            if (offset > base.size()) return -1;
+            auto got = std::min<uint64_t>(size, base.size() - offset);
+            std::copy_n(base.data() + offset, got, static_cast<uint8_t*>(buf));
+            return static_cast<int64_t>(got);
+        },
+        base.size(),
+        [&](void* buf, uint32_t size) -> int64_t {
+            auto got = std::min<size_t>({size, delta.size() - deltaPos, 1000});
+            std::copy_n(delta.data() + deltaPos, got, static_cast<uint8_t*>(buf));
+            deltaPos += got;
+            return static_cast<int64_t>(got);
+        },
+        [&](const void* buf, uint32_t size) {
+            out.insert(out.end(), static_cast<const uint8_t*>(buf), static_cast<const uint8_t*>(buf) + size);
+            return true;
+        });
+}
+
+// A new version of base: bytes patched in place, a block inserted, a block removed and a tail appended
+Bytes edit(const Bytes& base) {
+    Bytes target = base;
+    for (size_t i = 1000; i < 1016; ++i)
+        target[i] ^= 0x5a;
+    auto inserted = noise(3000, 7);
+    target.insert(target.begin() + 40000, inserted.begin(), inserted.end());
+    target.erase(target.begin() + 90000, target.begin() + 95000);
+    auto tail = noise(500, 11);
+    target.insert(target.end(), tail.begin(), tail.end());
+    return target;
+}
+
+} // namespace
+
+TEST_CASE("Deltas rebuild the target from the base", "[deltapatch]") {
+    const Bytes base = noise(200 * 1024, 1);
+    Bytes out;
+
+    SECTION("an edited file") {
+        const Bytes target = edit(base);
+        const Bytes delta = makeDelta(base, target);
+        REQUIRE(apply(base, delta, out) == DeltaPatch::Result::OK);
+        CHECK(out == target);
+        // only the edits travel as literals
+        CHECK(delta.size() < 16 * 1024);
+    }
+
+    SECTION("an identical file") {
+        const Bytes delta = makeDelta(base, base);
+        REQUIRE(apply(base, delta, out) == DeltaPatch::Result::OK);
+        CHECK(out == base);
+        CHECK(delta.size() < 64);
+    }
+
+    SECTION("an unrelated file") {
+        const Bytes target = noise(70 * 1024, 2);
+        REQUIRE(apply(base, makeDelta(base, target), out) == DeltaPatch::Result::OK);
+        CHECK(out == target);
+    }
+
+    SECTION("empty base or target") {
+        const Bytes empty;
+        REQUIRE(apply(empty, makeDelta(empty, base), out) == DeltaPatch::Result::OK);
+        CHECK(out == base);
+        REQUIRE(apply(base, makeDelta(base, empty), out) == DeltaPatch::Result::OK);
+        CHECK(out.empty());
+    }
+}
+
+TEST_CASE("Deltas applied to another base are rejected before writing", "[deltapatch]") {
+    const Bytes base = noise(200 * 1024, 1);
+    const Bytes delta = makeDelta(base, edit(base));
+    Bytes out;
+
+    SECTION("same size, different content") {
+        Bytes other = base;
+        other[123456] ^= 1;
+        CHECK(apply(other, delta, out) == DeltaPatch::Result::BASE_MISMATCH);
+        CHECK(out.empty());
+    }
+
+    SECTION("different size") {
+        Bytes other(base.begin(), base.end() - 1);
+        CHECK(apply(other, delta, out) == DeltaPatch::Result::BASE_MISMATCH);
+        CHECK(out.empty());
+    }
+}
+
+TEST_CASE("Corrupt deltas are rejected", "[deltapatch]") {
+    const Bytes base = noise(200 * 1024, 1);
+    const Bytes target = edit(base);
+    Bytes delta = makeDelta(base, target);
+    Bytes out;
+
+    SECTION("bad magic") {
+        delta[0] ^= 0xff;
+        CHECK(apply(base, delta, out) == DeltaPatch::Result::BAD_DELTA);
+    }
+
+    SECTION("unknown version") {
+        delta[4] = 2;
+        CHECK(apply(base, delta, out) == DeltaPatch::Result::BAD_DELTA);
+    }
+
+    SECTION("truncated header") {
+        delta.resize(DeltaPatch::HEADER_SIZE - 1);
+        CHECK(apply(base, delta, out) == DeltaPatch::Result::BAD_DELTA);
+    }
+
+    SECTION("truncated instructions") {
+        delta.pop_back();
+        CHECK(apply(base, delta, out) == DeltaPatch::Result::BAD_DELTA);
+    }
+
+    SECTION("unknown instruction") {
+        delta[DeltaPatch::HEADER_SIZE] = 7;
+        CHECK(apply(base, delta, out) == DeltaPatch::Result::BAD_DELTA);
+    }
+
+    SECTION("damaged literal") {
+        // the tail appended by edit() is the last literal, just before the END instruction
+        delta[delta.size() - 2] ^= 0x01;
+        CHECK(apply(base, delta, out) == DeltaPatch::Result::TARGET_MISMATCH);
+    }
+
+    SECTION("damaged target hash") {
+        delta[32] ^= 0x01;
+        CHECK(apply(base, delta, out) == DeltaPatch::Result::TARGET_MISMATCH);
+    }
+}
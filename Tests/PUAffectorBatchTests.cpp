@@ -0,0 +1,159 @@
+// Particle Universe affectors: the batched path over a PUParticleBatch must leave every particle exactly
+// as the per-particle updatePUAffector does, including dimensions that would shrink to zero or below,
+// axes without a scale, and the padding lanes of a batch that is not a multiple of four.
+
+#include "Particle3D/PU/PUColorAffector.h"
+#include "Particle3D/PU/PUDynamicAttribute.h"
+#include "Particle3D/PU/PUParticleBatch.h"
+#include "Particle3D/PU/PUParticleSystem3D.h"
+#include "Particle3D/PU/PUScaleAffector.h"
+#include "base/RefPtr.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using ax::PUAffector;
+using ax::PUColorAffector;
+using ax::PUParticle3D;
+using ax::PUParticleBatch;
+using ax::PUScaleAffector;
+using ax::Vec3;
+using ax::Vec4;
+
+namespace {
+
+constexpr size_t PARTICLE_COUNT = 67;
+constexpr float STEP = 0.125f;
+
+using ParticleList = std::vector<std::unique_ptr<PUParticle3D>>;
+
+// Sizes from tiny to large, at every age, plus a degenerate one
+ParticleList makeParticles() {
+    ParticleList particles;
+    for (size_t i = 0; i < PARTICLE_COUNT; ++i) {
+        auto p = std::make_unique<PUParticle3D>();
+        p->width = 0.05f + (i % 7) * 0.5f;
+        p->height = 0.1f + (i % 5) * 0.75f;
+        p->depth = i == 3 ? 0.0f : 0.2f + (i % 3) * 1.25f;
+        p->ownDimensions = false;
+        p->totalTimeToLive = 2.0f;
+        p->timeToLive = 2.0f * (1.0f - float(i) / (PARTICLE_COUNT - 1));
+        p->timeFraction = (p->totalTimeToLive - p->timeToLive) / p->totalTimeToLive;
+        p->originalColor = Vec4(0.25f + (i % 4) * 0.25f, 0.5f, 1.0f - (i % 3) * 0.25f, 0.75f);
+        p->color = p->originalColor;
+        particles.push_back(std::move(p));
+    }
+    return particles;
+}
+
+void updateScalar(PUAffector* affector, ParticleList& particles, float dt) {
+    for (auto& p : particles)
+        affector->updatePUAffector(p.get(), dt);
+}
+
+void updateBatched(PUAffector* affector, ParticleList& particles, float dt) {
+    PUParticleBatch batch;
+    for (auto& p : particles)
+        batch.add(p.get());
+    batch.gather(affector->getBatchFields());
+    affector->updatePUAffectorBatch(batch, dt);
+    batch.scatter();
+}
+
+// Lanes use the same operations in the same order, only allow for the compiler contracting the scalar code
+bool near(float a, float b) { return std::fabs(a - b) <= 1e-5f * std::fmax(1.0f, std::fabs(a)); }
+
+void checkSame(const ParticleList& scalar, const ParticleList& batched) {
+    for (size_t i = 0; i < scalar.size(); ++i) {
+        const auto& s = *scalar[i];
+        const auto& b = *batched[i];
+        INFO("particle " << i);
+        CHECK(near(s.width, b.width));
+        CHECK(near(s.height, b.height));
+        CHECK(near(s.depth, b.depth));
+        CHECK(near(s.radius, b.radius));
+        CHECK(s.ownDimensions == b.ownDimensions);
+        CHECK(near(s.color.x, b.color.x));
+        CHECK(near(s.color.y, b.color.y));
+        CHECK(near(s.color.z, b.color.z));
+        CHECK(near(s.color.w, b.color.w));
+    }
+}
+
+ax::PUDynamicAttribute* fixed(float value) {
+    auto attribute = new ax::PUDynamicAttributeFixed();
+    attribute->setValue(value);
+    return attribute;
+}
+
+// Grows young particles and shrinks old ones, so some dimensions cross zero
+ax::PUDynamicAttribute* curve() {
+    auto attribute = new ax::PUDynamicAttributeCurved(ax::IT_LINEAR);
+    attribute->addControlPoint(0.0f, 2.0f);
+    attribute->addControlPoint(0.5f, 0.0f);
+    attribute->addControlPoint(1.0f, -6.0f);
+    attribute->processControlPoints();
+    return attribute;
+}
+
+void runScale(PUScaleAffector* affector, int frames) {
+    auto scalar = makeParticles();
+    auto batched = makeParticles();
+    for (int frame = 0; frame < frames; ++frame) {
+        updateScalar(affector, scalar, STEP);
+        updateBatched(affector, batched, STEP);
+    }
+    checkSame(scalar, batched);
+}
+
+} // namespace
+
+TEST_CASE("Batched scale affector matches the per-particle update", "[particle3d][pu]") {
+    ax::RefPtr<PUScaleAffector> affector = PUScaleAffector::create();
+
+    SECTION("uniform scale shrinking past zero") {
+        affector->setDynScaleXYZ(fixed(-3.0f));
+        runScale(affector.get(), 8);
+    }
+
+    SECTION("uniform scale over the lifetime, rescaled, with a time to live specialisation") {
+        affector->setDynScaleXYZ(curve());
+        affector->notifyRescaled(Vec3(1.0f, 2.0f, 0.5f));
+        affector->setAffectSpecialisation(PUAffector::AFSP_TTL_DECREASE);
+        runScale(affector.get(), 8);
+    }
+
+    SECTION("some axes without a scale") {
+        affector->setDynScaleX(curve());
+        affector->setDynScaleZ(fixed(-4.0f));
+        runScale(affector.get(), 8);
+    }
+
+    SECTION("no scale at all") {
+        runScale(affector.get(), 1);
+    }
+}
+
+TEST_CASE("Batched colour affector matches the per-particle update", "[particle3d][pu]") {
+    ax::RefPtr<PUColorAffector> affector = PUColorAffector::create();
+    affector->addColor(0.0f, Vec4(1.0f, 0.0f, 0.0f, 1.0f));
+    affector->addColor(0.4f, Vec4(0.0f, 1.0f, 0.0f, 0.5f));
+    affector->addColor(0.8f, Vec4(0.0f, 0.0f, 1.0f, 0.0f));
+
+    SECTION("set") {
+        affector->setColorOperation(PUColorAffector::CAO_SET);
+    }
+
+    SECTION("multiply") {
+        affector->setColorOperation(PUColorAffector::CAO_MULTIPLY);
+    }
+
+    auto scalar = makeParticles();
+    auto batched = makeParticles();
+    updateScalar(affector.get(), scalar, STEP);
+    updateBatched(affector.get(), batched, STEP);
+    checkSame(scalar, batched);
+}
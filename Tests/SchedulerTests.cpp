@@ -0,0 +1,283 @@
+// Scheduler timers: the timing wheel behind interval and delayed timers, and the state machine that
+// moves a timer between pending, wheel, per-frame and parked while targets pause, resume, reschedule
+// and unschedule, including from inside a firing callback.
+//
+// Steps are multiples of 1/8 s so every clock value is exact.
+
+#include "base/Scheduler.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <functional>
+#include <string>
+
+using ax::Scheduler;
+
+namespace {
+
+constexpr float STEP = 0.125f;
+
+void step(Scheduler& scheduler, int frames, float dt = STEP) {
+    for (int i = 0; i < frames; ++i)
+        scheduler.update(dt);
+}
+
+} // namespace
+
+TEST_CASE("Interval timers fire once their interval elapsed", "[scheduler]") {
+    Scheduler scheduler;
+    int target = 0;
+    int fired = 0;
+    scheduler.schedule([&](float) { ++fired; }, &target, 0.5f, false, "tick");
+
+    // the first update only arms the timer
+    step(scheduler, 1);
+    step(scheduler, 3);
+    CHECK(fired == 0);
+    step(scheduler, 1);
+    CHECK(fired == 1);
+    step(scheduler, 4);
+    CHECK(fired == 2);
+}
+
+TEST_CASE("Delayed timers with a repeat count unschedule themselves", "[scheduler]") {
+    Scheduler scheduler;
+    int target = 0;
+    std::string dts;
+    scheduler.schedule([&](float dt) { dts += std::to_string(static_cast<int>(dt * 1000)) + ' '; }, &target, 0.25f, 2,
+                       0.5f, false, "repeat");
+
+    step(scheduler, 16);
+    CHECK(dts == "500 250 250 ");
+    CHECK_FALSE(scheduler.isScheduled("repeat", &target));
+}
+
+TEST_CASE("Per-frame timers tick every frame after the one that arms them", "[scheduler]") {
+    Scheduler scheduler;
+    int target = 0;
+    int fired = 0;
+    scheduler.schedule([&](float) { ++fired; }, &target, 0.0f, false, "frame");
+
+    step(scheduler, 5);
+    CHECK(fired == 4);
+
+    scheduler.pauseTarget(&target);
+    step(scheduler, 3);
+    CHECK(fired == 4);
+
+    // resumed per-frame timers are already armed, so they tick on the very next frame
+    scheduler.resumeTarget(&target);
+    step(scheduler, 2);
+    CHECK(fired == 6);
+}
+
+TEST_CASE("Far deadlines survive cascades and long stalls", "[scheduler][wheel]") {
+    Scheduler scheduler;
+    int target = 0;
+
+    SECTION("stepping through every outer slot") {
+        int fired = 0;
+        scheduler.schedule([&](float) { ++fired; }, &target, 100.0f, false, "far");
+        step(scheduler, 1);
+        step(scheduler, 799);
+        CHECK(fired == 0);
+        step(scheduler, 1);
+        CHECK(fired == 1);
+    }
+
+    SECTION("a single update far past the deadline") {
+        int fired = 0;
+        scheduler.schedule([&](float) { ++fired; }, &target, 30.0f, false, "stall");
+        step(scheduler, 1);
+        scheduler.update(1000.0f);
+        // interval timers catch up on every deadline they missed
+        CHECK(fired == 33);
+        step(scheduler, 8 * 19);
+        CHECK(fired == 33);
+        step(scheduler, 8);
+        CHECK(fired == 34);
+    }
+}
+
+TEST_CASE("Paused targets keep the time left on their timers", "[scheduler]") {
+    Scheduler scheduler;
+    int target = 0;
+    int fired = 0;
+    scheduler.schedule([&](float) { ++fired; }, &target, 0.25f, true, "paused");
+
+    step(scheduler, 8);
+    CHECK(fired == 0);
+
+    scheduler.resumeTarget(&target);
+    step(scheduler, 3);
+    CHECK(fired == 1);
+
+    scheduler.pauseTarget(&target);
+    step(scheduler, 8);
+    CHECK(fired == 1);
+
+    scheduler.resumeTarget(&target);
+    step(scheduler, 1);
+    CHECK(fired == 1);
+    step(scheduler, 1);
+    CHECK(fired == 2);
+}
+
+TEST_CASE("Timers added to a target follow the target's paused state", "[scheduler]") {
+    Scheduler scheduler;
+    int target = 0;
+    int first = 0;
+    int second = 0;
+    scheduler.schedule([&](float) { ++first; }, &target, 0.25f, false, "first");
+    scheduler.pauseTarget(&target);
+
+    SECTION("consistent paused argument") {
+        scheduler.schedule([&](float) { ++second; }, &target, 0.25f, true, "second");
+        step(scheduler, 8);
+        CHECK(first == 0);
+        CHECK(second == 0);
+    }
+
+#if !defined(_AX_DEBUG) || _AX_DEBUG == 0
+    // debug builds assert on the mismatch, release builds must still honour the target
+    SECTION("mismatched paused argument") {
+        scheduler.schedule([&](float) { ++second; }, &target, 0.25f, false, "second");
+        step(scheduler, 8);
+        CHECK(first == 0);
+        CHECK(second == 0);
+    }
+#endif
+
+    scheduler.resumeTarget(&target);
+    step(scheduler, 3);
+    CHECK(first == 1);
+    CHECK(second == 1);
+}
+
+TEST_CASE("Scheduling an existing key again restarts the timer", "[scheduler]") {
+    Scheduler scheduler;
+    int target = 0;
+    int fired = 0;
+    auto callback = [&](float) { ++fired; };
+    scheduler.schedule(callback, &target, 1.0f, false, "reinit");
+    step(scheduler, 5);
+
+    scheduler.schedule(callback, &target, 0.25f, false, "reinit");
+    step(scheduler, 2);
+    CHECK(fired == 0);
+    step(scheduler, 1);
+    CHECK(fired == 1);
+
+    SECTION("while the target is paused") {
+        scheduler.pauseTarget(&target);
+        scheduler.schedule(callback, &target, 0.25f, true, "reinit");
+        step(scheduler, 8);
+        CHECK(fired == 1);
+
+        scheduler.resumeTarget(&target);
+        step(scheduler, 3);
+        CHECK(fired == 2);
+    }
+}
+
+TEST_CASE("Callbacks may unschedule and reschedule timers while they fire", "[scheduler]") {
+    Scheduler scheduler;
+    int target = 0;
+
+    SECTION("a timer unscheduling itself") {
+        int fired = 0;
+        scheduler.schedule(
+            [&](float) {
+                ++fired;
+                scheduler.unschedule("self", &target);
+            },
+            &target, 0.25f, false, "self");
+        step(scheduler, 16);
+        CHECK(fired == 1);
+        CHECK_FALSE(scheduler.isScheduled("self", &target));
+    }
+
+    SECTION("two due timers unscheduling each other") {
+        int fired = 0;
+        scheduler.schedule(
+            [&](float) {
+                ++fired;
+                scheduler.unschedule("b", &target);
+            },
+            &target, 0.25f, false, "a");
+        scheduler.schedule(
+            [&](float) {
+                ++fired;
+                scheduler.unschedule("a", &target);
+            },
+            &target, 0.25f, false, "b");
+        step(scheduler, 16);
+        // whichever fires first cancels the other, and the survivor keeps running: due at 0.375, then
+        // every 0.25 s up to 1.875
+        CHECK(fired == 7);
+        CHECK(scheduler.isScheduled("a", &target) != scheduler.isScheduled("b", &target));
+    }
+
+    SECTION("a timer rescheduling itself with a new interval") {
+        int fired = 0;
+        std::function<void(float)> callback = [&](float) {
+            if (++fired == 1)
+                scheduler.schedule(callback, &target, 0.5f, false, "again");
+        };
+        scheduler.schedule(callback, &target, 0.25f, false, "again");
+        step(scheduler, 3);
+        CHECK(fired == 1);
+        // armed again on the next update, then every 0.5 s
+        step(scheduler, 4);
+        CHECK(fired == 1);
+        step(scheduler, 1);
+        CHECK(fired == 2);
+    }
+
+    SECTION("a callback pausing its own target") {
+        int fired = 0;
+        scheduler.schedule(
+            [&](float) {
+                ++fired;
+                scheduler.pauseTarget(&target);
+            },
+            &target, 0.25f, false, "pause");
+        step(scheduler, 16);
+        CHECK(fired == 1);
+
+        scheduler.resumeTarget(&target);
+        step(scheduler, 2);
+        CHECK(fired == 2);
+    }
+
+    SECTION("a one-shot callback pausing its own target") {
+        // what Node::scheduleOnce schedules
+        int fired = 0;
+        scheduler.schedule(
+            [&](float) {
+                ++fired;
+                scheduler.pauseTarget(&target);
+            },
+            &target, 0.0f, 0, 0.25f, false, "once");
+        step(scheduler, 4);
+        CHECK(fired == 1);
+        CHECK_FALSE(scheduler.isScheduled("once", &target));
+
+        scheduler.resumeTarget(&target);
+        step(scheduler, 16);
+        CHECK(fired == 1);
+    }
+
+    SECTION("a callback unscheduling everything") {
+        int fired = 0;
+        scheduler.schedule(
+            [&](float) {
+                ++fired;
+                scheduler.unscheduleAll();
+            },
+            &target, 0.25f, false, "all");
+        step(scheduler, 16);
+        CHECK(fired == 1);
+        CHECK_FALSE(scheduler.isScheduled("all", &target));
+    }
+}
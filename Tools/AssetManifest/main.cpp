@@ -0,0 +1,139 @@
+// Build-time generator for the preload asset manifest (assets.ccman).
+//
+// Usage: CosmicCitiesAssetManifest <content-dir> <output-file> <root>...
+// Each root is a folder under the content dir; roots listed earlier get a lower
+// (earlier) priority group. Bitmap fonts pull in their page textures as dependencies.
+
+#include "utils/AssetManifest.h"
+#include "xxhash.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using cosmiccities::AssetManifest;
+
+namespace {
+
+bool hashFile(const fs::path& path, uint64_t& size, uint64_t& hash) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    XXH64_state_t* state = XXH64_createState();
+    XXH64_reset(state, 0);
+
+    char buffer[64 * 1024];
+    size = 0;
+    while (file) {
+        file.read(buffer, sizeof(buffer));
+        auto got = file.gcount();
+        if (got <= 0) break;
+        XXH64_update(state, buffer, static_cast<size_t>(got));
+        size += static_cast<uint64_t>(got);
+    }
+
+    hash = XXH64_digest(state);
+    XXH64_freeState(state);
+    return true;
+}
+
+// BMFont text format: page id=0 file="name.png"
+std::vector<std::string> fontPages(const fs::path& fnt) {
+    std::vector<std::string> pages;
+    std::ifstream file(fnt);
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.rfind("page ", 0) != 0) continue;
+        auto pos = line.find("file=\"");
+        if (pos == std::string::npos) continue;
+        pos += 6;
+        auto end = line.find('"', pos);
+        if (end == std::string::npos) continue;
+        pages.push_back(line.substr(pos, end - pos));
+    }
+    return pages;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        std::fprintf(stderr, "usage: %s <content-dir> <output-file> <root>...\n", argv[0]);
+        return 2;
+    }
+
+    const fs::path contentDir = argv[1];
+    const fs::path output = argv[2];
+
+    AssetManifest::Builder builder;
+    std::map<std::string, uint32_t> indexByPath;
+    std::vector<std::pair<uint32_t, fs::path>> fonts;
+
+    auto addFile = [&](const fs::path& file, AssetManifest::Type type, uint8_t group) -> int64_t {
+        auto rel = fs::relative(file, contentDir).generic_string();
+        auto it = indexByPath.find(rel);
+        if (it != indexByPath.end()) return it->second;
+
+        uint64_t size = 0, hash = 0;
+        if (!hashFile(file, size, hash)) {
+            std::fprintf(stderr, "cannot read %s\n", file.string().c_str());
+            return -1;
+        }
+        auto index = builder.add(rel, type, group, size, hash);
+        indexByPath.emplace(rel, index);
+        return index;
+    };
+
+    for (int i = 3; i < argc; ++i) {
+        const auto group = static_cast<uint8_t>(i - 3);
+        const fs::path root = contentDir / argv[i];
+        if (!fs::is_directory(root)) continue;
+
+        // Sorted so the manifest (and load order within a group) is deterministic
+        std::vector<fs::path> files;
+        for (const auto& entry : fs::recursive_directory_iterator(root)) {
+            if (entry.is_regular_file()) files.push_back(entry.path());
+        }
+        std::sort(files.begin(), files.end());
+
+        for (const auto& file : files) {
+            auto ext = file.extension().string();
+            AssetManifest::Type type;
+            if (ext.size() < 2 || !AssetManifest::typeForExtension(std::string_view(ext).substr(1), type)) continue;
+
+            auto index = addFile(file, type, group);
+            if (index >= 0 && type == AssetManifest::Type::Font) {
+                fonts.emplace_back(static_cast<uint32_t>(index), file);
+            }
+        }
+    }
+
+    for (const auto& [fontIndex, fontPath] : fonts) {
+        for (const auto& page : fontPages(fontPath)) {
+            auto pagePath = fontPath.parent_path() / page;
+            if (!fs::is_regular_file(pagePath)) continue;
+            auto dep = addFile(pagePath, AssetManifest::Type::Texture, UINT8_MAX);
+            if (dep >= 0) builder.addDependency(fontIndex, static_cast<uint32_t>(dep));
+        }
+    }
+    builder.propagateGroups();
+
+    auto bytes = builder.finish();
+    std::error_code ec;
+    if (output.has_parent_path()) fs::create_directories(output.parent_path(), ec);
+
+    std::ofstream out(output, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!out.good()) {
+        std::fprintf(stderr, "failed to write %s\n", output.string().c_str());
+        return 1;
+    }
+
+    std::printf("%zu assets -> %s\n", indexByPath.size(), output.string().c_str());
+    return 0;
+}
@@ -0,0 +1,88 @@
+// Generator for the binary deltas AssetsManagerEx applies to modified assets.
+//
+// Usage: CosmicCitiesDeltaPatch <base-file> <target-file> <delta-file>
+// The delta is verified by applying it before it is written. The remote manifest then lists the
+// asset as "patch": { "from": <md5 of base>, "path": <delta url>, "size": <delta size> }.
+
+#include "DeltaPatch.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace fs = std::filesystem;
+using ax::extension::DeltaPatch;
+
+namespace {
+
+bool readFile(const fs::path& path, std::vector<uint8_t>& bytes) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc != 4) {
+        std::fprintf(stderr, "usage: %s <base-file> <target-file> <delta-file>\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<uint8_t> base, target;
+    if (!readFile(argv[1], base)) {
+        std::fprintf(stderr, "cannot read %s\n", argv[1]);
+        return 1;
+    }
+    if (!readFile(argv[2], target)) {
+        std::fprintf(stderr, "cannot read %s\n", argv[2]);
+        return 1;
+    }
+
+    auto delta = DeltaPatch::create(base.data(), base.size(), target.data(), target.size());
+
+    // Round-trip so a broken delta never gets published
+    std::vector<uint8_t> rebuilt;
+    size_t deltaPos = 0;
+    auto result = DeltaPatch::apply(
+        [&](uint64_t offset, void* buf, uint32_t size) -> int64_t {
+            if (offset > base.size()) return -1;
+            auto got = std::min<uint64_t>(size, base.size() - offset);
+            std::copy_n(base.data() + offset, got, static_cast<uint8_t*>(buf));
+            return static_cast<int64_t>(got);
+        },
+        base.size(),
+        [&](void* buf, uint32_t size) -> int64_t {
+            auto got = std::min<size_t>(size, delta.size() - deltaPos);
+            std::copy_n(delta.data() + deltaPos, got, static_cast<uint8_t*>(buf));
+            deltaPos += got;
+            return static_cast<int64_t>(got);
+        },
+        [&](const void* buf, uint32_t size) {
+            rebuilt.insert(rebuilt.end(), static_cast<const uint8_t*>(buf), static_cast<const uint8_t*>(buf) + size);
+            return true;
+        });
+    if (result != DeltaPatch::Result::OK || rebuilt != target) {
+        std::fprintf(stderr, "delta failed to round-trip (%d)\n", static_cast<int>(result));
+        return 1;
+    }
+
+    const fs::path output = argv[3];
+    std::error_code ec;
+    if (output.has_parent_path()) fs::create_directories(output.parent_path(), ec);
+
+    std::ofstream out(output, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(delta.data()), static_cast<std::streamsize>(delta.size()));
+    if (!out.good()) {
+        std::fprintf(stderr, "failed to write %s\n", output.string().c_str());
+        return 1;
+    }
+
+    std::printf("%zu -> %zu bytes, delta %zu bytes -> %s\n", base.size(), target.size(), delta.size(),
+                output.string().c_str());
+    return 0;
+}
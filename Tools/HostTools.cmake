@@ -0,0 +1,25 @@
+# Build-time tools, shared by the native build (Tools/CMakeLists.txt) and the standalone host
+# project (Tools/Host) that cross builds compile for the build machine.
+# Expects COSMIC_CITIES_ROOT to point at the repository root.
+
+add_executable(CosmicCitiesLocalePack
+  ${COSMIC_CITIES_ROOT}/Tools/LocalePack/main.cpp
+  ${COSMIC_CITIES_ROOT}/Source/managers/LocalePack.cpp
+)
+
+target_include_directories(CosmicCitiesLocalePack PRIVATE
+  ${COSMIC_CITIES_ROOT}/Source
+  ${COSMIC_CITIES_ROOT}/axmol/3rdparty
+  ${COSMIC_CITIES_ROOT}/axmol/3rdparty/rapidjson/include
+)
+
+add_executable(CosmicCitiesAssetManifest
+  ${COSMIC_CITIES_ROOT}/Tools/AssetManifest/main.cpp
+  ${COSMIC_CITIES_ROOT}/Source/utils/AssetManifest.cpp
+  ${COSMIC_CITIES_ROOT}/axmol/3rdparty/xxhash/xxhash.c
+)
+
+target_include_directories(CosmicCitiesAssetManifest PRIVATE
+  ${COSMIC_CITIES_ROOT}/Source
+  ${COSMIC_CITIES_ROOT}/axmol/3rdparty/xxhash
+)
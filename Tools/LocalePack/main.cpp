@@ -0,0 +1,36 @@
+// Build-time compiler for .ccloc locale packs.
+//
+// Usage: CosmicCitiesLocalePack <output-dir> <locale.json>...
+// Each input is written to <output-dir>/<stem>.ccloc. index.json is skipped.
+
+#include "managers/LocalePack.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::fprintf(stderr, "usage: %s <output-dir> <locale.json>...\n", argv[0]);
+        return 2;
+    }
+
+    const std::filesystem::path outDir = argv[1];
+    int failures = 0;
+
+    for (int i = 2; i < argc; ++i) {
+        const std::filesystem::path input = argv[i];
+        if (input.filename() == "index.json")
+            continue;
+
+        const auto output = (outDir / input.stem()).string() + LocalePack::EXTENSION;
+        if (!LocalePack::compileFile(input.string(), output)) {
+            std::fprintf(stderr, "failed to compile %s\n", input.string().c_str());
+            ++failures;
+            continue;
+        }
+        std::printf("%s -> %s\n", input.string().c_str(), output.c_str());
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -199,6 +199,11 @@ public:
      * Is this aabb visible in frustum
      */
     bool isVisibleInFrustum(const AABB* aabb) const;
+
+    /**
+     * Get the frustum of the camera, rebuilt lazily when the view or projection changes
+     */
+    const Frustum& getFrustum() const;
 #endif
 
     /**
@@ -329,6 +334,11 @@ public:
      */
     void setScene(Scene* scene);
 
+    /**
+     * Get the owner scene of the camera, null until the camera enters a scene
+     */
+    Scene* getOwnerScene() const { return _scene; }
+
     /**set additional matrix for the projection matrix, it multiplies mat to projection matrix when called, used by
      * WP8*/
     void setAdditionalProjection(const Mat4& mat);
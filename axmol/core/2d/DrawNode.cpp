@@ -30,6 +30,7 @@
 #include "base/Configuration.h"
 #include "renderer/Renderer.h"
 #include "base/Director.h"
+#include "base/FrameArena.h"
 #include "base/EventListenerCustom.h"
 #include "base/EventDispatcher.h"
 #include "2d/ActionCatmullRom.h"
@@ -421,8 +422,7 @@ void DrawNode::drawQuadBezier(const Vec2& origin,
         return;
     }
 
-    axstd::pod_vector<Vec2> _vertices{
-        static_cast<size_t>(segments + 1)};  // Vec2* _vertices = _abuf.get<Vec2>(segments + 1);
+    auto _vertices = _director->getFrameArena()->allocateArray<Vec2>(segments + 1);
 
     float t = 0.0f;
     for (unsigned int i = 0; i < segments; i++)
@@ -434,7 +434,7 @@ void DrawNode::drawQuadBezier(const Vec2& origin,
     _vertices[segments].x = destination.x;
     _vertices[segments].y = destination.y;
 
-    _drawPoly(_vertices.data(), segments + 1, false, color, thickness, false);
+    _drawPoly(_vertices, segments + 1, false, color, thickness, false);
 }
 
 void DrawNode::drawCubicBezier(const Vec2& origin,
@@ -451,7 +451,7 @@ void DrawNode::drawCubicBezier(const Vec2& origin,
         return;
     }
 
-    axstd::pod_vector<Vec2> _vertices{static_cast<size_t>(segments + 1)};
+    auto _vertices = _director->getFrameArena()->allocateArray<Vec2>(segments + 1);
 
     float t = 0.0f;
     for (unsigned int i = 0; i < segments; i++)
@@ -465,7 +465,7 @@ void DrawNode::drawCubicBezier(const Vec2& origin,
     _vertices[segments].x = destination.x;
     _vertices[segments].y = destination.y;
 
-    _drawPoly(_vertices.data(), segments + 1, false, color, thickness, true);
+    _drawPoly(_vertices, segments + 1, false, color, thickness, true);
 }
 
 void DrawNode::drawCardinalSpline(const PointArray* configIn,
@@ -496,7 +496,7 @@ void DrawNode::drawCardinalSpline(const PointArray* configIn,
     float lt;
     float deltaT = 1.0f / config->count();
 
-    axstd::pod_vector<Vec2> _vertices{static_cast<size_t>(segments)};
+    auto _vertices = _director->getFrameArena()->allocateArray<Vec2>(segments);
 
     for (unsigned int i = 0; i < segments; i++)
     {
@@ -508,7 +508,6 @@ void DrawNode::drawCardinalSpline(const PointArray* configIn,
         {
             _vertices[i] = config->getControlPointAtIndex(config->count() - 1);
             segments     = i + 1;
-            _vertices.resize(segments);
             break;
         }
 
@@ -530,7 +529,7 @@ void DrawNode::drawCardinalSpline(const PointArray* configIn,
             _vertices[i - seg] = _vertices[i];
         segments -= (seg + seg);
     }
-    _drawPoly(_vertices.data(), segments, false, color, thickness, true);
+    _drawPoly(_vertices, segments, false, color, thickness, true);
 }
 
 void DrawNode::drawCatmullRom(const PointArray* pointsIn, unsigned int segments, const Color4F& color, float thickness, bool closed)
@@ -849,14 +848,15 @@ void DrawNode::_drawPolygon(const Vec2* verts,
 
     auto _vertices = _transform(verts, count, closedPolygon);
 
-    std::vector<V2F_C4B_T2F_Triangle> triangleList;
+    FrameVector<V2F_C4B_T2F_Triangle> triangleList{_director->getFrameArena()};
 
     int vertex_count = 0;
 
     // calculate the memory (important for correct drawing stuff)
-    if (closedPolygon && !isconvex && fillColor.a > 0.0f && !isConvex(_vertices.data(), count) && count >= 3)
+    if (closedPolygon && !isconvex && fillColor.a > 0.0f && !isConvex(_vertices, count) && count >= 3)
     {
-        std::vector<p2t::Point> p2pointsStorage;
+        // the CDT API only takes a std::vector of pointers, the points themselves can live in the frame arena
+        FrameVector<p2t::Point> p2pointsStorage{_director->getFrameArena()};
         p2pointsStorage.reserve(count);
         std::vector<p2t::Point*> p2points;
         p2points.reserve(count);
@@ -871,6 +871,7 @@ void DrawNode::_drawPolygon(const Vec2* verts,
         std::vector<p2t::Triangle*> tris = cdt.GetTriangles();
 
         vertex_count += tris.size();
+        triangleList.reserve(tris.size());
         for (auto&& t : tris)  // use it later; only one calculate!!!
         {
             p2t::Point* vec1 = t->GetPoint(0);
@@ -909,7 +910,7 @@ void DrawNode::_drawPolygon(const Vec2* verts,
 
     // start drawing...
     int ii = 0;
-    if (closedPolygon && !isconvex && fillColor.a > 0.0f && !isConvex(_vertices.data(), count) && count >= 3)
+    if (closedPolygon && !isconvex && fillColor.a > 0.0f && !isConvex(_vertices, count) && count >= 3)
     {
         for (auto&& t : triangleList)
         {
@@ -994,7 +995,7 @@ void DrawNode::_drawPolygon(const Vec2* verts,
                 Vec2 offset, n;
             };
 
-            axstd::pod_vector<ExtrudeVerts> extrude{static_cast<size_t>(sizeof(struct ExtrudeVerts) * count)};
+            auto extrude = _director->getFrameArena()->allocateArray<ExtrudeVerts>(count);
 
             for (unsigned int i = 0; i < count; i++)
             {
@@ -1241,7 +1242,7 @@ void DrawNode::_drawCircle(const Vec2& center,
     const float coef = 2.0f * (float)M_PI / segments;
 
     int count       = (drawLineToCenter) ? 3 : 2;
-    Vec2* _vertices = new Vec2[segments + count];
+    auto _vertices = _director->getFrameArena()->allocateArray<Vec2>(segments + count);
 
     float rsX = radius * scaleX;
     float rsY = radius * scaleY;
@@ -1260,8 +1261,6 @@ void DrawNode::_drawCircle(const Vec2& center,
         _drawPolygon(_vertices, segments + 1, fillColor, borderColor, false, thickness, true);
     else
         _drawPoly(_vertices, segments + 1, false, borderColor, thickness, true);
-
-    AX_SAFE_DELETE_ARRAY(_vertices);
 }
 
 void DrawNode::_drawColoredTriangle(Vec2* vertices3,
@@ -1317,7 +1316,7 @@ void DrawNode::_drawAStar(const Vec2& center,
     const float coef = 2.0f * (float)M_PI / segments;
     float halfAngle  = coef / 2.0f;
 
-    axstd::pod_vector<Vec2> _vertices(segments * 2 + 1);
+    auto _vertices = _director->getFrameArena()->allocateArray<Vec2>(segments * 2 + 1);
 
     int i = 0;
     for (unsigned int a = 0; a < segments; a++)
@@ -1329,12 +1328,12 @@ void DrawNode::_drawAStar(const Vec2& center,
 
     if (solid)
     {
-        _drawPolygon(_vertices.data(), i, filledColor, color, true, thickness, false);
+        _drawPolygon(_vertices, i, filledColor, color, true, thickness, false);
     }
     else
     {
         _vertices[i++] = _vertices[0];
-        _drawPoly(_vertices.data(), i, true, color, thickness, false);
+        _drawPoly(_vertices, i, true, color, thickness, false);
     }
 }
 
@@ -1478,7 +1477,9 @@ void DrawNode::_drawPie(const Vec2& center,
     {
         const float coef = 2.0f * (float)M_PI / DEGREES;
 
-        axstd::pod_vector<Vec2> _vertices(DEGREES + 2);
+        // the loop below visits 0..DEGREES inclusive, so a full circle puts DEGREES + 1 points on the arc;
+        // with the center and the first point again that is DEGREES + 3 (DEGREES + 2 wrote one past the end)
+        auto _vertices = _director->getFrameArena()->allocateArray<Vec2>(DEGREES + 3);
 
         int n        = 0;
         float rads   = 0.0f;
@@ -1508,21 +1509,21 @@ void DrawNode::_drawPie(const Vec2& center,
         case DrawMode::Fill:
             _vertices[n++] = center;
             _vertices[n++] = _vertices[0];
-            _drawPolygon(_vertices.data(), n, fillColor, Color4F::TRANSPARENT, true, 0, false);
-            _drawPoly(_vertices.data(), n, false, borderColor, thickness, true);
+            _drawPolygon(_vertices, n, fillColor, Color4F::TRANSPARENT, true, 0, false);
+            _drawPoly(_vertices, n, false, borderColor, thickness, true);
             break;
         case DrawMode::Outline:
             _vertices[n++] = center;
             _vertices[n++] = _vertices[0];
-            _drawPoly(_vertices.data(), n, false, borderColor, thickness, true);
+            _drawPoly(_vertices, n, false, borderColor, thickness, true);
             break;
         case DrawMode::Line:
-            _drawPoly(_vertices.data(), n,  false, borderColor, thickness, true);
+            _drawPoly(_vertices, n,  false, borderColor, thickness, true);
             break;
         case DrawMode::Semi:
             if (fillColor != Color4F::TRANSPARENT)
-                _drawPolygon(_vertices.data(), n, fillColor, borderColor, true, 0, false);
-            _drawPoly(_vertices.data(), n, true, borderColor, thickness, true);
+                _drawPolygon(_vertices, n, fillColor, borderColor, true, 0, false);
+            _drawPoly(_vertices, n, true, borderColor, thickness, true);
             break;
         default:
             break;
@@ -1530,7 +1531,7 @@ void DrawNode::_drawPie(const Vec2& center,
     }
 }
 
-axstd::pod_vector<Vec2> DrawNode::_transform(const Vec2* _vertices, unsigned int& count, bool closedPolygon)
+Vec2* DrawNode::_transform(const Vec2* _vertices, unsigned int& count, bool closedPolygon)
 {
     Vec2 vert0        = _vertices[0];
     int closedCounter = 0;
@@ -1540,10 +1541,10 @@ axstd::pod_vector<Vec2> DrawNode::_transform(const Vec2* _vertices, unsigned int
         closedCounter = 1;
     }
 
-    axstd::pod_vector<Vec2> vert(count + closedCounter);
+    auto vert = _director->getFrameArena()->allocateArray<Vec2>(count + closedCounter);
     if (properties.transform == false)
     {
-        memcpy(vert.data(), _vertices, count * sizeof(Vec2));
+        memcpy(vert, _vertices, count * sizeof(Vec2));
         if (closedCounter)
         {
             vert[count++] = vert0;
@@ -1551,7 +1552,7 @@ axstd::pod_vector<Vec2> DrawNode::_transform(const Vec2* _vertices, unsigned int
         return vert;
     }
 
-    applyTransform(_vertices, vert.data(), count);
+    applyTransform(_vertices, vert, count);
 
     if (closedCounter)
     {
@@ -670,8 +670,9 @@ private:
      * @param vertices A Vec2 vertices list.
      * @param count The number of vertices.
      * @param closedPolygon The closedPolygon flag.
+     * @return The transformed vertices, in frame arena memory.
      */
-    axstd::pod_vector<Vec2> _transform(const Vec2* vertices, unsigned int& count, bool closedPolygon = false);
+    Vec2* _transform(const Vec2* vertices, unsigned int& count, bool closedPolygon = false);
 
     void applyTransform(const Vec2* from, Vec2* to, unsigned int count);
 
@@ -42,6 +42,7 @@
 #include "renderer/Renderer.h"
 #include "renderer/RenderCommand.h"
 #include "base/Director.h"
+#include "base/FrameArena.h"
 #include "base/EventListenerCustom.h"
 #include "base/EventDispatcher.h"
 #include "base/EventCustom.h"
@@ -74,6 +75,16 @@ void updateBlend(backend::BlendDescriptor& blendDescriptor, BlendFunc blendFunc)
         blendDescriptor.destinationAlphaBlendFactor = backend::BlendFactor::ONE_MINUS_SRC_ALPHA;
     }
 }
+
+// Decodes into frame arena scratch memory and assigns, so a label whose text changes every frame keeps
+// reusing the capacity of its string. Leaves out untouched when utf8 is invalid.
+void decodeUTF8(std::string_view utf8, std::u32string& out)
+{
+    size_t length = 0;
+    auto buffer   = Director::getInstance()->getFrameArena()->allocateArray<char32_t>(utf8.length());
+    if (StringUtils::UTF8ToUTF32(utf8, buffer, length))
+        out.assign(buffer, length);
+}
 }  // namespace
 
 /**
@@ -962,11 +973,7 @@ void Label::setString(std::string_view text)
         _utf8Text     = text;
         _contentDirty = true;
 
-        std::u32string utf32String;
-        if (StringUtils::UTF8ToUTF32(_utf8Text, utf32String))
-        {
-            _utf32Text = utf32String;
-        }
+        decodeUTF8(_utf8Text, _utf32Text);
     }
 }
 
@@ -1771,11 +1778,7 @@ void Label::clearTextures()
 
     if (_fontAtlas)
     {
-        std::u32string utf32String;
-        if (StringUtils::UTF8ToUTF32(_utf8Text, utf32String))
-        {
-            _utf32Text = utf32String;
-        }
+        decodeUTF8(_utf8Text, _utf32Text);
 
         computeHorizontalKernings(_utf32Text);
     }
@@ -2130,6 +2133,11 @@ void Label::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
         _insideBounds = renderer->checkVisibility(transform, _contentSize);
     }
 
+    if (_insideBounds)
+        renderer->addDrawnNodes(1);
+    else
+        renderer->addCulledNodes(1);
+
     if (_insideBounds)
 #endif
     {
@@ -42,6 +42,7 @@ THE SOFTWARE.
 #include "2d/Camera.h"
 #include "2d/ActionManager.h"
 #include "2d/Scene.h"
+#include "2d/TransformPrepass.h"
 #include "2d/Component.h"
 #include "renderer/Material.h"
 #include "math/TransformUtils.h"
@@ -90,6 +91,7 @@ Node::Node()
     , _additionalTransform(nullptr)
     , _additionalTransformDirty(false)
     , _transformUpdated(true)
+    , _subtreeBoundsDirty(true)
     // children (lazy allocs)
     , _childrenIndexer(nullptr)
     // lazy alloc
@@ -258,6 +260,7 @@ void Node::setSkewX(float skewX)
 
     _skewX            = skewX;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeBoundsDirty();
 }
 
 float Node::getSkewY() const
@@ -272,6 +275,7 @@ void Node::setSkewY(float skewY)
 
     _skewY            = skewY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeBoundsDirty();
 }
 
 void Node::setLocalZOrder(int z)
@@ -324,6 +328,7 @@ void Node::setRotation(float rotation)
 
     _rotationZ_X = _rotationZ_Y = rotation;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeBoundsDirty();
 
     updateRotationQuat();
 }
@@ -339,6 +344,7 @@ void Node::setRotation3D(const Vec3& rotation)
         return;
 
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeBoundsDirty();
 
     _rotationX = rotation.x;
     _rotationY = rotation.y;
@@ -392,6 +398,7 @@ void Node::setRotationQuat(const Quaternion& quat)
     _rotationQuat = quat;
     updateRotation3D();
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeBoundsDirty();
 }
 
 Quaternion Node::getRotationQuat() const
@@ -406,6 +413,7 @@ void Node::setRotationSkewX(float rotationX)
 
     _rotationZ_X      = rotationX;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeBoundsDirty();
 
     updateRotationQuat();
 }
@@ -422,6 +430,7 @@ void Node::setRotationSkewY(float rotationY)
 
     _rotationZ_Y      = rotationY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeBoundsDirty();
 
     updateRotationQuat();
 }
@@ -441,6 +450,7 @@ void Node::setScale(float scale)
 
     _scaleX = _scaleY = _scaleZ = scale;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeBoundsDirty();
 }
 
 /// scaleX getter
@@ -458,6 +468,7 @@ void Node::setScale(float scaleX, float scaleY)
     _scaleX           = scaleX;
     _scaleY           = scaleY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeBoundsDirty();
 }
 
 /// scaleX setter
@@ -468,6 +479,7 @@ void Node::setScaleX(float scaleX)
 
     _scaleX           = scaleX;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeBoundsDirty();
 }
 
 /// scaleY getter
@@ -484,6 +496,7 @@ void Node::setScaleZ(float scaleZ)
 
     _scaleZ           = scaleZ;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeBoundsDirty();
 }
 
 /// scaleY getter
@@ -500,6 +513,7 @@ void Node::setScaleY(float scaleY)
 
     _scaleY           = scaleY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeBoundsDirty();
 }
 
 /// position getter
@@ -529,6 +543,7 @@ void Node::setPosition(float x, float y)
     _position.y = y;
 
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeBoundsDirty();
     _usingNormalizedPosition                            = false;
 }
 
@@ -574,6 +589,7 @@ void Node::setPositionZ(float positionZ)
         return;
 
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeBoundsDirty();
 
     _positionZ = positionZ;
 }
@@ -594,6 +610,7 @@ void Node::setPositionNormalized(const Vec2& position)
     _usingNormalizedPosition = true;
     _normalizedPositionDirty = true;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeBoundsDirty();
 }
 
 ssize_t Node::getChildrenCount() const
@@ -614,7 +631,11 @@ void Node::setVisible(bool visible)
     {
         _visible = visible;
         if (_visible)
+        {
+            // hidden nodes aren't visited, so their transform and the subtree bounds may be stale
             _transformUpdated = _transformDirty = _inverseDirty = true;
+            markSubtreeBoundsDirty();
+        }
     }
 }
 
@@ -636,6 +657,7 @@ void Node::setAnchorPoint(const Vec2& point)
         _anchorPoint = point;
         _anchorPointInPoints.set(_contentSize.width * _anchorPoint.x, _contentSize.height * _anchorPoint.y);
         _transformUpdated = _transformDirty = _inverseDirty = true;
+        markSubtreeBoundsDirty();
     }
 }
 
@@ -653,6 +675,7 @@ void Node::setContentSize(const Vec2& size)
 
         _anchorPointInPoints.set(_contentSize.width * _anchorPoint.x, _contentSize.height * _anchorPoint.y);
         _transformUpdated = _transformDirty = _inverseDirty = _contentSizeDirty = true;
+        markSubtreeBoundsDirty();
     }
 }
 
@@ -675,6 +698,13 @@ void Node::setParent(Node* parent)
     _parent           = parent;
     _normalizedPositionDirty = true;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeBoundsDirty();
+}
+
+void Node::markSubtreeBoundsDirty()
+{
+    for (auto node = this; node && !node->_subtreeBoundsDirty; node = node->_parent)
+        node->_subtreeBoundsDirty = true;
 }
 
 /// isRelativeAnchorPoint getter
@@ -690,6 +720,7 @@ void Node::setIgnoreAnchorPointForPosition(bool newValue)
     {
         _ignoreAnchorPointForPosition = newValue;
         _transformUpdated = _transformDirty = _inverseDirty = true;
+        markSubtreeBoundsDirty();
     }
 }
 
@@ -1136,6 +1167,7 @@ void Node::removeAllChildrenWithCleanup(bool cleanup)
 
     _children.clear();
     AX_SAFE_DELETE(_childrenIndexer);
+    markSubtreeBoundsDirty();
 }
 
 void Node::resetChild(Node* child, bool cleanup)
@@ -1176,6 +1208,7 @@ void Node::detachChild(Node* child, ssize_t childIndex, bool cleanup)
 
     resetChild(child, cleanup);
     _children.erase(childIndex);
+    markSubtreeBoundsDirty();
 }
 
 // helper used by reorderChild & add
@@ -1190,6 +1223,7 @@ void Node::insertChild(Node* child, int z)
 #endif  // AX_ENABLE_GC_FOR_NATIVE_OBJECTS
     _transformUpdated  = true;
     _reorderChildDirty = true;
+    markSubtreeBoundsDirty();
     _children.pushBack(child);
     child->_setLocalZOrder(z);
 }
@@ -1230,6 +1264,30 @@ void Node::visit()
 }
 
 uint32_t Node::processParentFlags(const Mat4& parentTransform, uint32_t parentFlags)
+{
+    if (_prepassStamp != 0)
+    {
+        // reuse the transform computed by TransformPrepass::run only when the node is reached the way the
+        // pass assumed, from an up to date parent and with the same dirty flags
+        const bool current = _prepassStamp == TransformPrepass::_activeStamp;
+        if (current && !_transformUpdated && !_contentSizeDirty && !_normalizedPositionDirty &&
+            &parentTransform == (_parent ? &_parent->_modelViewTransform : TransformPrepass::_activeRoot) &&
+            (!_parent || _parent->_prepassStamp == _prepassStamp) &&
+            (parentFlags & FLAGS_DIRTY_MASK) == (_prepassParentFlags & FLAGS_DIRTY_MASK))
+        {
+            return parentFlags | (_prepassFlags & FLAGS_DIRTY_MASK);
+        }
+
+        // the precomputed transform may be wrong, so recompute it and make our children do the same
+        _prepassStamp = 0;
+        if (current)
+            parentFlags |= FLAGS_TRANSFORM_DIRTY;
+    }
+
+    return updateTransformFlags(parentTransform, parentFlags);
+}
+
+uint32_t Node::updateTransformFlags(const Mat4& parentTransform, uint32_t parentFlags)
 {
     if (_usingNormalizedPosition)
     {
@@ -1241,6 +1299,7 @@ uint32_t Node::processParentFlags(const Mat4& parentTransform, uint32_t parentFl
             _position.y       = _normalizedPosition.y * s.height;
             _transformUpdated = _transformDirty = _inverseDirty = true;
             _normalizedPositionDirty                            = false;
+            markSubtreeBoundsDirty();
         }
     }
 
@@ -1803,6 +1862,7 @@ void Node::setNodeToParentTransform(const Mat4& transform)
     _transform        = transform;
     _transformDirty   = false;
     _transformUpdated = true;
+    markSubtreeBoundsDirty();
 
     if (_additionalTransform)
         // _additionalTransform[1] has a copy of lastest transform
@@ -1838,6 +1898,7 @@ void Node::setAdditionalTransform(const Mat4* additionalTransform)
         _additionalTransform[0] = *additionalTransform;
     }
     _transformUpdated = _additionalTransformDirty = _inverseDirty = true;
+    markSubtreeBoundsDirty();
 }
 
 void Node::setAdditionalTransform(const Mat4& additionalTransform)
@@ -853,6 +853,17 @@ public:
     virtual Node* getParent() { return _parent; }
     virtual const Node* getParent() const { return _parent; }
 
+    /**
+     * Flags this node and its ancestors after a transform, child or bounds change below them,
+     * so cached subtree bounds (see `MeshRenderer`) are gathered again.
+     * Stops at the first ancestor that is already flagged.
+     */
+    void markSubtreeBoundsDirty();
+    /** Whether this subtree changed since its bounds were last gathered. */
+    bool isSubtreeBoundsDirty() const { return _subtreeBoundsDirty; }
+    /** Called by whoever gathered the bounds of this subtree. */
+    void clearSubtreeBoundsDirty() { _subtreeBoundsDirty = false; }
+
     ////// REMOVES //////
 
     /**
@@ -1858,6 +1869,8 @@ protected:
 
     Mat4 transform(const Mat4& parentTransform);
     uint32_t processParentFlags(const Mat4& parentTransform, uint32_t parentFlags);
+    /// processParentFlags without the TransformPrepass lookup
+    uint32_t updateTransformFlags(const Mat4& parentTransform, uint32_t parentFlags);
 
     virtual void updateCascadeOpacity();
     virtual void disableCascadeOpacity();
@@ -1976,6 +1989,7 @@ protected:
     mutable bool _inverseDirty;              ///< inverse transform dirty flag
     mutable bool _additionalTransformDirty;  ///< transform dirty ?
     bool _transformUpdated;                  ///< Whether or not the Transform object was updated since the last frame
+    bool _subtreeBoundsDirty;                ///< Whether this node or a descendant moved since the subtree bounds were gathered
 
     bool _usingNormalizedPosition;
     bool _normalizedPositionDirty;
@@ -2005,6 +2019,15 @@ protected:
 
     backend::ProgramState* _programState = nullptr;
 
+    // TransformPrepass results, see processParentFlags
+    uint32_t _prepassStamp       = 0;
+    uint32_t _prepassParentFlags = 0;
+    uint32_t _prepassFlags       = 0;
+    /// set by nodes whose transform depends on state only known while visiting; their subtree is skipped
+    bool _transformPrepassExcluded = false;
+
+    friend class TransformPrepass;
+
 // Physics:remaining backwardly compatible
 #if defined(AX_ENABLE_PHYSICS)
     PhysicsBody* _physicsBody;
@@ -52,7 +52,7 @@ THE SOFTWARE.
 #include "renderer/TextureAtlas.h"
 #include "base/ZipUtils.h"
 #include "base/Director.h"
-#include "base/Profiling.h"
+#include "base/FrameProfiler.h"
 #include "base/UTF8.h"
 #include "base/Utils.h"
 #include "renderer/TextureCache.h"
@@ -1555,7 +1555,7 @@ void ParticleSystem::update(float dt)
     if (!_visible)
         return;
 
-    AX_PROFILER_START_CATEGORY(kProfilerCategoryParticles, "CCParticleSystem - update");
+    AX_PROFILE_ZONE("ParticleSystem::update");
 
     if (_componentContainer && !_componentContainer->isEmpty())
     {
@@ -1569,7 +1569,6 @@ void ParticleSystem::update(float dt)
         {
             updateParticleQuads();
             _transformSystemDirty = false;
-            AX_PROFILER_STOP_CATEGORY(kProfilerCategoryParticles, "CCParticleSystem - update");
             return;
         }
         dt             = _fixedFPSDelta;
@@ -1834,8 +1833,6 @@ void ParticleSystem::update(float dt)
     {
         postStep();
     }
-
-    AX_PROFILER_STOP_CATEGORY(kProfilerCategoryParticles, "CCParticleSystem - update");
 }
 
 void ParticleSystem::updateWithNoTime()
@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include "2d/Scene.h"
 #include "base/Director.h"
 #include "2d/Camera.h"
+#include "2d/TransformPrepass.h"
 #include "base/EventDispatcher.h"
 #include "base/EventListenerCustom.h"
 #include "base/UTF8.h"
@@ -48,6 +49,10 @@ THE SOFTWARE.
 #    include "navmesh/NavMesh.h"
 #endif
 
+#if defined(AX_ENABLE_3D)
+#    include "3d/AABBTree.h"
+#endif
+
 namespace ax
 {
 
@@ -73,6 +78,10 @@ Scene::~Scene()
 #if defined(AX_ENABLE_NAVMESH)
     AX_SAFE_RELEASE(_navMesh);
 #endif
+#if defined(AX_ENABLE_3D)
+    delete _cullingTree;
+#endif
+    delete _transformPrepass;
     _director->getEventDispatcher()->removeEventListener(_event);
     AX_SAFE_RELEASE(_event);
 
@@ -89,6 +98,36 @@ Scene::~Scene()
 #endif  // AX_ENABLE_GC_FOR_NATIVE_OBJECTS
 }
 
+void Scene::setTransformPrepassEnabled(bool enabled)
+{
+    if (enabled && !_transformPrepass)
+    {
+        _transformPrepass = new TransformPrepass();
+    }
+    else if (!enabled && _transformPrepass)
+    {
+        _transformPrepass->finish();
+        delete _transformPrepass;
+        _transformPrepass = nullptr;
+    }
+}
+
+#if defined(AX_ENABLE_3D)
+void Scene::setCullingTreeEnabled(bool enabled)
+{
+    if (enabled && !_cullingTree)
+    {
+        _cullingTree = new AABBTree();
+    }
+    else if (!enabled && _cullingTree)
+    {
+        // renderers holding proxies notice through the tree epoch and drop them
+        delete _cullingTree;
+        _cullingTree = nullptr;
+    }
+}
+#endif
+
 #if defined(AX_ENABLE_NAVMESH)
 void Scene::setNavMesh(NavMesh* navMesh)
 {
@@ -215,8 +254,18 @@ void Scene::render(Renderer* renderer, const Mat4& eyeTransform, const Mat4* eye
         camera->apply();
         // clear background with max depth
         camera->clearBackground();
+#if defined(AX_ENABLE_3D)
+        // one hierarchical pass per camera, MeshRenderer::visit then only reads the leaf flags
+        if (_cullingTree)
+            _cullingTree->cull(camera->getFrustum());
+#endif
+        // the visit only reads back what the pre-pass computed for this camera
+        if (_transformPrepass)
+            _transformPrepass->run(this, transform);
         // visit the scene
         visit(renderer, transform, 0);
+        if (_transformPrepass)
+            _transformPrepass->finish();
 #if defined(AX_ENABLE_NAVMESH)
         if (_navMesh && _navMeshDebugCamera == camera)
         {
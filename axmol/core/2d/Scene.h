@@ -49,6 +49,10 @@ class Physics3DWorld;
 #if defined(AX_ENABLE_NAVMESH)
 class NavMesh;
 #endif
+#if defined(AX_ENABLE_3D)
+class AABBTree;
+#endif
+class TransformPrepass;
 
 /**
  * @addtogroup _2d
@@ -124,6 +128,14 @@ public:
 
     void setCameraOrderDirty() { _cameraOrderDirty = true; }
 
+    /** Compute the transforms of the whole scene in a separate pass before each camera visits it.
+     * Pays off for large scenes where many nodes move every frame: the pass walks the hierarchy breadth-first
+     * and spreads wide levels over the job system. Mostly static scenes are better off without it.
+     */
+    void setTransformPrepassEnabled(bool enabled);
+    bool isTransformPrepassEnabled() const { return _transformPrepass != nullptr; }
+    TransformPrepass* getTransformPrepass() const { return _transformPrepass; }
+
     void onProjectionChanged(EventCustom* event);
 
 private:
@@ -148,6 +160,8 @@ protected:
 
     std::vector<BaseLight*> _lights;
 
+    TransformPrepass* _transformPrepass = nullptr;
+
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(Scene);
 
@@ -194,6 +208,21 @@ protected:
 #    endif
 #endif  // (defined(AX_ENABLE_PHYSICS) || defined(AX_ENABLE_3D_PHYSICS))
 
+#if defined(AX_ENABLE_3D)
+public:
+    /** Enable a scene-wide bounding volume hierarchy for frustum culling.
+     * Each MeshRenderer registers the bounds of its mesh subtree and, when the tree reports it off screen,
+     * skips visiting that subtree altogether. Non-mesh children do not contribute to those bounds and
+     * are culled together with their parent, so leave this off for scenes that attach large effects to meshes.
+     */
+    void setCullingTreeEnabled(bool enabled);
+    bool isCullingTreeEnabled() const { return _cullingTree != nullptr; }
+    AABBTree* getCullingTree() const { return _cullingTree; }
+
+protected:
+    AABBTree* _cullingTree = nullptr;
+#endif
+
 #if defined(AX_ENABLE_NAVMESH)
 public:
     /** set navigation mesh */
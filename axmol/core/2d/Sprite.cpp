@@ -1085,6 +1085,11 @@ void Sprite::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
         // XXX: this always return true since
         _insideBounds = renderer->checkVisibility(transform, _contentSize);
 
+    if (_insideBounds)
+        renderer->addDrawnNodes(1);
+    else
+        renderer->addCulledNodes(1);
+
     if (_insideBounds)
 #endif
     {
@@ -0,0 +1,177 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "2d/TransformPrepass.h"
+#include "2d/Node.h"
+#include "2d/Sprite.h"
+#if defined(AX_ENABLE_3D)
+#    include "3d/MeshRenderer.h"
+#endif
+#include "base/Director.h"
+#include "base/JobSystem.h"
+
+#include <algorithm>
+
+namespace ax
+{
+
+uint32_t TransformPrepass::_nextStamp     = 0;
+uint32_t TransformPrepass::_activeStamp   = 0;
+const Mat4* TransformPrepass::_activeRoot = nullptr;
+std::vector<const std::type_info*> TransformPrepass::_threadSafeTypes = {&typeid(Node), &typeid(Sprite),
+#if defined(AX_ENABLE_3D)
+                                                                        &typeid(MeshRenderer)
+#endif
+};
+
+void TransformPrepass::setThreadSafe(const std::type_info& type, bool threadSafe)
+{
+    auto it = std::find_if(_threadSafeTypes.begin(), _threadSafeTypes.end(),
+                           [&type](const std::type_info* other) { return *other == type; });
+    if (threadSafe && it == _threadSafeTypes.end())
+        _threadSafeTypes.push_back(&type);
+    else if (!threadSafe && it != _threadSafeTypes.end())
+        _threadSafeTypes.erase(it);
+}
+
+bool TransformPrepass::isThreadSafe(const Node* node)
+{
+    const std::type_info& type = typeid(*node);
+    for (auto&& other : _threadSafeTypes)
+    {
+        if (*other == type)
+            return true;
+    }
+    return false;
+}
+
+void TransformPrepass::run(Node* root, const Mat4& rootTransform)
+{
+    finish();
+
+    _stats = Stats();
+    if (!root->isVisible())
+        return;
+
+    flatten(root);
+
+    // stamp 0 means "never precomputed"
+    if (++_nextStamp == 0)
+        ++_nextStamp;
+
+    auto jobSystem = Director::getInstance()->getJobSystem();
+    for (size_t level = 0; level + 1 < _levels.size(); ++level)
+    {
+        const size_t begin  = _levels[level];
+        const size_t serial = _serialBegin[level];
+        const size_t count  = serial - begin;
+        if (jobSystem && count >= PARALLEL_THRESHOLD)
+        {
+            jobSystem->parallelFor(count, PARALLEL_GRAIN, [this, begin, &rootTransform](size_t first, size_t last) {
+                computeRange(begin + first, begin + last, rootTransform);
+            });
+            ++_stats.parallel;
+        }
+        else
+        {
+            computeRange(begin, serial, rootTransform);
+        }
+        // types that are not known to be thread safe stay on this thread
+        computeRange(serial, _levels[level + 1], rootTransform);
+    }
+
+    _stats.nodes  = static_cast<unsigned int>(_entries.size());
+    _stats.levels = static_cast<unsigned int>(_levels.size() - 1);
+
+    _activeStamp = _nextStamp;
+    _activeRoot  = &rootTransform;
+}
+
+void TransformPrepass::finish()
+{
+    _activeStamp = 0;
+    _activeRoot  = nullptr;
+}
+
+void TransformPrepass::flatten(Node* root)
+{
+    _entries.clear();
+    _levels.clear();
+    _serialBegin.clear();
+
+    // the root is computed on the calling thread anyway
+    _entries.push_back({root, nullptr});
+    _levels.push_back(0);
+    _serialBegin.push_back(0);
+    size_t begin = 0;
+    while (begin < _entries.size())
+    {
+        const size_t end = _entries.size();
+        for (size_t i = begin; i < end; ++i)
+        {
+            Node* node = _entries[i].node;
+            for (auto&& child : node->_children)
+            {
+                // invisible subtrees are not visited, excluded ones are left to the regular path
+                if (!child->_visible || child->_transformPrepassExcluded)
+                    continue;
+                // a normalized position reads the parent's (virtual) content size and may flag the parent chain
+                if (isThreadSafe(child) && !child->_usingNormalizedPosition)
+                    _entries.push_back({child, node});
+                else
+                    _serial.push_back({child, node});
+            }
+        }
+        // every level keeps its serial entries at the end, after the ones workers may compute
+        if (_entries.size() == end && _serial.empty())
+            break;
+        _levels.push_back(end);
+        _serialBegin.push_back(_entries.size());
+        _entries.insert(_entries.end(), _serial.begin(), _serial.end());
+        _serial.clear();
+        begin = end;
+    }
+    _levels.push_back(_entries.size());
+}
+
+void TransformPrepass::computeRange(size_t begin, size_t end, const Mat4& rootTransform)
+{
+    for (size_t i = begin; i < end; ++i)
+        computeEntry(_entries[i], rootTransform);
+}
+
+void TransformPrepass::computeEntry(const Entry& entry, const Mat4& rootTransform)
+{
+    Node* node = entry.node;
+
+    // parents belong to the previous level, which is complete by now
+    const Mat4& parentTransform = entry.parent ? entry.parent->_modelViewTransform : rootTransform;
+    const uint32_t parentFlags  = entry.parent ? entry.parent->_prepassFlags : 0;
+
+    node->_prepassParentFlags = parentFlags;
+    node->_prepassFlags       = node->updateTransformFlags(parentTransform, parentFlags);
+    node->_prepassStamp       = _nextStamp;
+}
+
+}  // namespace ax
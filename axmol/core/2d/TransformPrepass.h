@@ -0,0 +1,126 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "math/Math.h"
+#include <typeinfo>
+#include <vector>
+
+namespace ax
+{
+
+class Node;
+
+/**
+ * @addtogroup _2d
+ * @{
+ */
+
+/**
+ * @brief Computes the model view transforms of a scene before it is visited.
+ *
+ * Node::visit recomputes a dirty transform on the way down, one node at a time, interleaved with draw
+ * submission. When enabled through Scene::setTransformPrepassEnabled, the pass first flattens the visible
+ * hierarchy into an array ordered breadth-first, then walks it level by level: every node of a level only
+ * depends on the level above, so large levels are split across the job system. The visit that follows
+ * finds each transform already computed and only reads it back.
+ *
+ * A node reuses its precomputed transform only when it is reached exactly as the pass expected: same
+ * parent matrix, same parent flags and no change to its own transform in between (ParallaxNode, for
+ * instance, moves its children while visiting). Anything else falls back to the regular path for that
+ * node and its subtree, so the result never differs from a visit without the pass.
+ *
+ * Only node types registered with setThreadSafe() are computed on workers. getNodeToParentTransform is
+ * virtual and overrides such as cocostudio's Armature read state that belongs to the main thread, so any
+ * other type, including subclasses of a registered one, is computed on the calling thread after the rest
+ * of its level. Node, Sprite and MeshRenderer are registered by default.
+ */
+class AX_DLL TransformPrepass
+{
+public:
+    /** levels with fewer nodes than this are computed on the calling thread */
+    static constexpr size_t PARALLEL_THRESHOLD = 1024;
+    static constexpr size_t PARALLEL_GRAIN     = 256;
+
+    struct Stats
+    {
+        unsigned int nodes    = 0;  ///< nodes flattened by the last run
+        unsigned int levels   = 0;  ///< depth of the flattened hierarchy
+        unsigned int parallel = 0;  ///< levels that were split across workers
+    };
+
+    /**
+     * Allows or forbids computing nodes of exactly this dynamic type on job system workers.
+     * Register a type only if its getNodeToParentTransform and getContentSize are safe to call off the
+     * main thread while the main thread is waiting.
+     */
+    static void setThreadSafe(const std::type_info& type, bool threadSafe);
+    template <typename T>
+    static void setThreadSafe(bool threadSafe)
+    {
+        setThreadSafe(typeid(T), threadSafe);
+    }
+    static bool isThreadSafe(const Node* node);
+
+    /** Computes the transforms of root's visible hierarchy and arms them for the next visit */
+    void run(Node* root, const Mat4& rootTransform);
+
+    /** Disarms the results of the last run; call once the visit it was made for is done */
+    void finish();
+
+    const Stats& getStats() const { return _stats; }
+
+    static bool isActive() { return _activeStamp != 0; }
+
+protected:
+    friend class Node;
+
+    struct Entry
+    {
+        Node* node;
+        Node* parent;  ///< nullptr for the root
+    };
+
+    void flatten(Node* root);
+    void computeRange(size_t begin, size_t end, const Mat4& rootTransform);
+    void computeEntry(const Entry& entry, const Mat4& rootTransform);
+
+    std::vector<Entry> _entries;
+    std::vector<size_t> _levels;  ///< start index of every level in _entries, plus the end
+    std::vector<size_t> _serialBegin;  ///< index of the first entry of every level computed on the calling thread
+    std::vector<Entry> _serial;        ///< entries of the level being flattened whose type is not thread safe
+    Stats _stats;
+
+    static uint32_t _nextStamp;
+    static uint32_t _activeStamp;
+    static const Mat4* _activeRoot;
+    static std::vector<const std::type_info*> _threadSafeTypes;
+};
+
+// end of _2d group
+/// @}
+
+}  // namespace ax
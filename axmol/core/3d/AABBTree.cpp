@@ -0,0 +1,419 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "3d/AABBTree.h"
+#include "3d/Frustum.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace ax
+{
+
+static std::atomic<uint32_t> s_treeEpoch{0};
+
+static AABB combine(const AABB& a, const AABB& b)
+{
+    return AABB(Vec3(std::min(a._min.x, b._min.x), std::min(a._min.y, b._min.y), std::min(a._min.z, b._min.z)),
+                Vec3(std::max(a._max.x, b._max.x), std::max(a._max.y, b._max.y), std::max(a._max.z, b._max.z)));
+}
+
+// half the surface area, which is all the insertion heuristic needs
+static float perimeter(const AABB& box)
+{
+    Vec3 d = box._max - box._min;
+    return d.x * d.y + d.y * d.z + d.z * d.x;
+}
+
+static bool contains(const AABB& outer, const AABB& inner)
+{
+    return outer._min.x <= inner._min.x && outer._min.y <= inner._min.y && outer._min.z <= inner._min.z &&
+           inner._max.x <= outer._max.x && inner._max.y <= outer._max.y && inner._max.z <= outer._max.z;
+}
+
+AABBTree::AABBTree(float fatRatio) : _fatRatio(fatRatio), _epoch(++s_treeEpoch) {}
+
+int AABBTree::allocateNode()
+{
+    if (_freeList == NULL_NODE)
+    {
+        _nodes.emplace_back();
+        return static_cast<int>(_nodes.size()) - 1;
+    }
+
+    int nodeId     = _freeList;
+    _freeList      = _nodes[nodeId].parent;
+    _nodes[nodeId] = TreeNode{};
+    return nodeId;
+}
+
+void AABBTree::freeNode(int nodeId)
+{
+    auto& node    = _nodes[nodeId];
+    node.parent   = _freeList;
+    node.child1   = NULL_NODE;
+    node.child2   = NULL_NODE;
+    node.height   = -1;
+    node.userData = nullptr;
+    _freeList     = nodeId;
+}
+
+int AABBTree::createProxy(const AABB& aabb, void* userData)
+{
+    int proxyId = allocateNode();
+
+    Vec3 r = (aabb._max - aabb._min) * _fatRatio;
+    auto& node        = _nodes[proxyId];
+    node.aabb         = AABB(aabb._min - r, aabb._max + r);
+    node.userData     = userData;
+    node.height       = 0;
+    node.visibleStamp = _cullStamp;
+
+    insertLeaf(proxyId);
+    ++_proxyCount;
+    return proxyId;
+}
+
+void AABBTree::destroyProxy(int proxyId)
+{
+    AXASSERT(proxyId >= 0 && proxyId < static_cast<int>(_nodes.size()) && _nodes[proxyId].isLeaf(),
+             "invalid proxy id");
+    removeLeaf(proxyId);
+    freeNode(proxyId);
+    --_proxyCount;
+}
+
+bool AABBTree::moveProxy(int proxyId, const AABB& aabb)
+{
+    AXASSERT(proxyId >= 0 && proxyId < static_cast<int>(_nodes.size()) && _nodes[proxyId].isLeaf(),
+             "invalid proxy id");
+    if (contains(_nodes[proxyId].aabb, aabb))
+        return false;
+
+    removeLeaf(proxyId);
+
+    Vec3 r                 = (aabb._max - aabb._min) * _fatRatio;
+    _nodes[proxyId].aabb   = AABB(aabb._min - r, aabb._max + r);
+
+    insertLeaf(proxyId);
+    return true;
+}
+
+void AABBTree::clear()
+{
+    _nodes.clear();
+    _root       = NULL_NODE;
+    _freeList   = NULL_NODE;
+    _proxyCount = 0;
+    _epoch      = ++s_treeEpoch;
+}
+
+void AABBTree::insertLeaf(int leaf)
+{
+    if (_root == NULL_NODE)
+    {
+        _root                = leaf;
+        _nodes[leaf].parent  = NULL_NODE;
+        return;
+    }
+
+    // Descend towards the sibling that grows the tree's total area the least
+    const AABB leafAABB = _nodes[leaf].aabb;
+    int index           = _root;
+    while (!_nodes[index].isLeaf())
+    {
+        const auto& node = _nodes[index];
+        float area       = perimeter(node.aabb);
+        float combined   = perimeter(combine(node.aabb, leafAABB));
+
+        // cost of pairing the leaf with this node, and the minimum cost pushed down to the children
+        float cost            = 2.0f * combined;
+        float inheritanceCost = 2.0f * (combined - area);
+
+        auto descendCost = [&](int child) {
+            const auto& c = _nodes[child];
+            float grown   = perimeter(combine(leafAABB, c.aabb));
+            return (c.isLeaf() ? grown : grown - perimeter(c.aabb)) + inheritanceCost;
+        };
+        float cost1 = descendCost(node.child1);
+        float cost2 = descendCost(node.child2);
+
+        if (cost < cost1 && cost < cost2)
+            break;
+
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    int sibling   = index;
+    int oldParent = _nodes[sibling].parent;
+    int newParent = allocateNode();
+
+    auto& parent  = _nodes[newParent];
+    parent.parent = oldParent;
+    parent.aabb   = combine(leafAABB, _nodes[sibling].aabb);
+    parent.height = _nodes[sibling].height + 1;
+    parent.child1 = sibling;
+    parent.child2 = leaf;
+
+    if (oldParent != NULL_NODE)
+    {
+        if (_nodes[oldParent].child1 == sibling)
+            _nodes[oldParent].child1 = newParent;
+        else
+            _nodes[oldParent].child2 = newParent;
+    }
+    else
+    {
+        _root = newParent;
+    }
+    _nodes[sibling].parent = newParent;
+    _nodes[leaf].parent    = newParent;
+
+    refit(newParent);
+}
+
+void AABBTree::removeLeaf(int leaf)
+{
+    if (leaf == _root)
+    {
+        _root = NULL_NODE;
+        return;
+    }
+
+    int parent      = _nodes[leaf].parent;
+    int grandParent = _nodes[parent].parent;
+    int sibling     = _nodes[parent].child1 == leaf ? _nodes[parent].child2 : _nodes[parent].child1;
+
+    if (grandParent != NULL_NODE)
+    {
+        if (_nodes[grandParent].child1 == parent)
+            _nodes[grandParent].child1 = sibling;
+        else
+            _nodes[grandParent].child2 = sibling;
+        _nodes[sibling].parent = grandParent;
+        freeNode(parent);
+
+        refit(grandParent);
+    }
+    else
+    {
+        _root                  = sibling;
+        _nodes[sibling].parent = NULL_NODE;
+        freeNode(parent);
+    }
+}
+
+void AABBTree::refit(int index)
+{
+    // walk back to the root fixing bounds and heights, rotating where a branch got lopsided
+    while (index != NULL_NODE)
+    {
+        index = balance(index);
+
+        auto& node  = _nodes[index];
+        const auto& c1 = _nodes[node.child1];
+        const auto& c2 = _nodes[node.child2];
+        node.height = 1 + std::max(c1.height, c2.height);
+        node.aabb   = combine(c1.aabb, c2.aabb);
+
+        index = node.parent;
+    }
+}
+
+// Rotate A's taller child up if the branch is imbalanced. Returns the new root of the branch.
+//
+//         A
+//       /   \
+//      B     C
+//     / \   / \
+//    D   E F   G
+int AABBTree::balance(int iA)
+{
+    auto& A = _nodes[iA];
+    if (A.isLeaf() || A.height < 2)
+        return iA;
+
+    int iB   = A.child1;
+    int iC   = A.child2;
+    auto& B  = _nodes[iB];
+    auto& C  = _nodes[iC];
+    int diff = C.height - B.height;
+
+    if (diff > 1)
+    {
+        int iF  = C.child1;
+        int iG  = C.child2;
+        auto& F = _nodes[iF];
+        auto& G = _nodes[iG];
+
+        C.child1 = iA;
+        C.parent = A.parent;
+        A.parent = iC;
+
+        if (C.parent != NULL_NODE)
+        {
+            if (_nodes[C.parent].child1 == iA)
+                _nodes[C.parent].child1 = iC;
+            else
+                _nodes[C.parent].child2 = iC;
+        }
+        else
+        {
+            _root = iC;
+        }
+
+        if (F.height > G.height)
+        {
+            C.child2 = iF;
+            A.child2 = iG;
+            G.parent = iA;
+            A.aabb   = combine(B.aabb, G.aabb);
+            C.aabb   = combine(A.aabb, F.aabb);
+            A.height = 1 + std::max(B.height, G.height);
+            C.height = 1 + std::max(A.height, F.height);
+        }
+        else
+        {
+            C.child2 = iG;
+            A.child2 = iF;
+            F.parent = iA;
+            A.aabb   = combine(B.aabb, F.aabb);
+            C.aabb   = combine(A.aabb, G.aabb);
+            A.height = 1 + std::max(B.height, F.height);
+            C.height = 1 + std::max(A.height, G.height);
+        }
+        return iC;
+    }
+
+    if (diff < -1)
+    {
+        int iD  = B.child1;
+        int iE  = B.child2;
+        auto& D = _nodes[iD];
+        auto& E = _nodes[iE];
+
+        B.child1 = iA;
+        B.parent = A.parent;
+        A.parent = iB;
+
+        if (B.parent != NULL_NODE)
+        {
+            if (_nodes[B.parent].child1 == iA)
+                _nodes[B.parent].child1 = iB;
+            else
+                _nodes[B.parent].child2 = iB;
+        }
+        else
+        {
+            _root = iB;
+        }
+
+        if (D.height > E.height)
+        {
+            B.child2 = iD;
+            A.child1 = iE;
+            E.parent = iA;
+            A.aabb   = combine(C.aabb, E.aabb);
+            B.aabb   = combine(A.aabb, D.aabb);
+            A.height = 1 + std::max(C.height, E.height);
+            B.height = 1 + std::max(A.height, D.height);
+        }
+        else
+        {
+            B.child2 = iE;
+            A.child1 = iD;
+            D.parent = iA;
+            A.aabb   = combine(C.aabb, D.aabb);
+            B.aabb   = combine(A.aabb, E.aabb);
+            A.height = 1 + std::max(C.height, D.height);
+            B.height = 1 + std::max(A.height, E.height);
+        }
+        return iB;
+    }
+
+    return iA;
+}
+
+int AABBTree::markVisible(int index)
+{
+    // the whole branch is inside the frustum, so its leaves need no further plane tests
+    int count   = 0;
+    size_t base = _stack.size();
+    _stack.push_back(index);
+    while (_stack.size() > base)
+    {
+        auto& node = _nodes[_stack.back()];
+        _stack.pop_back();
+        if (node.isLeaf())
+        {
+            node.visibleStamp = _cullStamp;
+            ++count;
+            continue;
+        }
+        _stack.push_back(node.child1);
+        _stack.push_back(node.child2);
+    }
+    return count;
+}
+
+int AABBTree::cull(const Frustum& frustum)
+{
+    ++_cullStamp;
+    if (_root == NULL_NODE)
+        return 0;
+
+    int visible = 0;
+    _stack.clear();
+    _stack.push_back(_root);
+    while (!_stack.empty())
+    {
+        int index = _stack.back();
+        _stack.pop_back();
+
+        auto& node = _nodes[index];
+        switch (frustum.intersectAABB(node.aabb))
+        {
+        case Frustum::Intersection::OUTSIDE:
+            break;
+        case Frustum::Intersection::INSIDE:
+            visible += markVisible(index);
+            break;
+        case Frustum::Intersection::INTERSECTING:
+            if (node.isLeaf())
+            {
+                node.visibleStamp = _cullStamp;
+                ++visible;
+            }
+            else
+            {
+                _stack.push_back(node.child1);
+                _stack.push_back(node.child2);
+            }
+            break;
+        }
+    }
+    return visible;
+}
+
+}  // namespace ax
@@ -0,0 +1,113 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "3d/AABB.h"
+#include <vector>
+
+namespace ax
+{
+
+class Frustum;
+
+/**
+ * @addtogroup _3d
+ * @{
+ */
+
+/**
+ * @brief Dynamic bounding volume hierarchy over AABBs.
+ *
+ * Leaves hold a fattened copy of the bounds they were given, so small movements do not
+ * touch the tree; when a box escapes its fat bounds the leaf is reinserted and the
+ * branch rebalanced with tree rotations. cull() walks the hierarchy top-down against a
+ * frustum and rejects or accepts whole branches with a single plane test.
+ *
+ * Proxy ids stay valid until destroyProxy() or clear(); clear() also changes getEpoch()
+ * so holders of old ids can tell them apart from new ones.
+ */
+class AX_DLL AABBTree
+{
+public:
+    static constexpr int NULL_NODE = -1;
+
+    /** @param fatRatio Fraction of each extent added on both sides of a leaf's bounds. */
+    explicit AABBTree(float fatRatio = 0.1f);
+
+    int createProxy(const AABB& aabb, void* userData);
+    void destroyProxy(int proxyId);
+    /** Update the bounds of a proxy. Returns true if the leaf had to be reinserted. */
+    bool moveProxy(int proxyId, const AABB& aabb);
+
+    void* getUserData(int proxyId) const { return _nodes[proxyId].userData; }
+    const AABB& getFatAABB(int proxyId) const { return _nodes[proxyId].aabb; }
+
+    /** Mark every leaf whose fat bounds touch the frustum. Returns the number of visible leaves. */
+    int cull(const Frustum& frustum);
+    /** Whether the proxy was inside the frustum of the last cull(); true before the first cull. */
+    bool isVisible(int proxyId) const { return _nodes[proxyId].visibleStamp == _cullStamp; }
+
+    void clear();
+
+    uint32_t getEpoch() const { return _epoch; }
+    int getProxyCount() const { return _proxyCount; }
+    int getHeight() const { return _root == NULL_NODE ? 0 : _nodes[_root].height; }
+
+protected:
+    struct TreeNode
+    {
+        AABB aabb;
+        void* userData = nullptr;
+        int parent     = NULL_NODE;  // next free node while the node is unused
+        int child1     = NULL_NODE;
+        int child2     = NULL_NODE;
+        int height     = -1;  // 0 for leaves, -1 for free nodes
+        uint32_t visibleStamp = 0;
+
+        bool isLeaf() const { return child1 == NULL_NODE; }
+    };
+
+    int allocateNode();
+    void freeNode(int nodeId);
+    void insertLeaf(int leaf);
+    void removeLeaf(int leaf);
+    int balance(int iA);
+    void refit(int index);
+    int markVisible(int index);
+
+    std::vector<TreeNode> _nodes;
+    std::vector<int> _stack;
+    int _root       = NULL_NODE;
+    int _freeList   = NULL_NODE;
+    int _proxyCount = 0;
+    float _fatRatio;
+    uint32_t _cullStamp = 0;
+    uint32_t _epoch;
+};
+
+// end of 3d group
+/// @}
+
+}  // namespace ax
@@ -38,7 +38,11 @@ AttachNode* AttachNode::create(Bone3D* attachBone)
     return attachnode;
 }
 
-AttachNode::AttachNode() : _attachBone(nullptr) {}
+AttachNode::AttachNode() : _attachBone(nullptr)
+{
+    // the bone matrices may only be refreshed when the owning MeshRenderer draws
+    _transformPrepassExcluded = true;
+}
 AttachNode::~AttachNode() {}
 
 Mat4 AttachNode::getWorldToNodeTransform() const
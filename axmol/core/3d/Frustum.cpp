@@ -56,6 +56,30 @@ bool Frustum::isOutOfFrustum(const AABB& aabb) const
     return false;
 }
 
+Frustum::Intersection Frustum::intersectAABB(const AABB& aabb) const
+{
+    if (!_initialized)
+        return Intersection::INSIDE;
+
+    auto result = Intersection::INSIDE;
+    int plane   = _clipZ ? 6 : 4;
+    for (int i = 0; i < plane; i++)
+    {
+        const Vec3& normal = _plane[i].getNormal();
+        // corner furthest behind the plane; if it is in front, the whole box is
+        Vec3 nearPoint(normal.x < 0 ? aabb._max.x : aabb._min.x, normal.y < 0 ? aabb._max.y : aabb._min.y,
+                       normal.z < 0 ? aabb._max.z : aabb._min.z);
+        if (_plane[i].getSide(nearPoint) == PointSide::FRONT_PLANE)
+            return Intersection::OUTSIDE;
+
+        Vec3 farPoint(normal.x < 0 ? aabb._min.x : aabb._max.x, normal.y < 0 ? aabb._min.y : aabb._max.y,
+                      normal.z < 0 ? aabb._min.z : aabb._max.z);
+        if (_plane[i].getSide(farPoint) == PointSide::FRONT_PLANE)
+            result = Intersection::INTERSECTING;
+    }
+    return result;
+}
+
 bool Frustum::isOutOfFrustum(const OBB& obb) const
 {
     if (_initialized)
@@ -66,6 +66,19 @@ public:
      */
     bool isOutOfFrustum(const OBB& obb) const;
 
+    enum class Intersection
+    {
+        OUTSIDE,
+        INTERSECTING,
+        INSIDE,
+    };
+
+    /**
+     * classify aabb against the frustum, INSIDE when it lies completely within every clip plane.
+     * an uninitialized frustum reports INSIDE, matching isOutOfFrustum returning false.
+     */
+    Intersection intersectAABB(const AABB& aabb) const;
+
     /**
      * get & set z clip. if bclipZ == true use near and far plane
      */
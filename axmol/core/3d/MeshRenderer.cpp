@@ -31,6 +31,8 @@
 #include "3d/MeshMaterial.h"
 #include "3d/AttachNode.h"
 #include "3d/Mesh.h"
+#include "3d/AABBTree.h"
+#include "3d/SkinningStage.h"
 
 #include "base/Director.h"
 #include "base/UTF8.h"
@@ -296,7 +298,7 @@ bool MeshRenderer::init()
 
 bool MeshRenderer::initWithFile(std::string_view path)
 {
-    _aabbDirty = true;
+    onAABBDirty();
     _meshes.clear();
     _meshVertexDatas.clear();
     AX_SAFE_RELEASE_NULL(_skeleton);
@@ -671,6 +673,7 @@ void MeshRenderer::addMesh(Mesh* mesh)
     auto meshVertex = mesh->getMeshIndexData()->_vertexData;
     _meshVertexDatas.pushBack(meshVertex);
     _meshes.pushBack(mesh);
+    onAABBDirty();
 }
 
 Texture2D* MeshRenderer::setMeshTexture(Mesh* mesh, std::string_view texPath, NTextureData::Usage usage)
@@ -713,6 +716,7 @@ void MeshRenderer::enableInstancing(MeshMaterial::InstanceMaterialType instanceM
 
 void MeshRenderer::enableInstancing(MeshMaterial* instanceMat, int count)
 {
+    _instancing = true;
     for (auto&& mesh : _meshes)
     {
         mesh->enableInstancing(true, MAX(1, count));
@@ -722,6 +726,7 @@ void MeshRenderer::enableInstancing(MeshMaterial* instanceMat, int count)
 
 void MeshRenderer::disableInstancing()
 {
+    _instancing = false;
     for (auto&& mesh : _meshes)
         mesh->enableInstancing(false, 0);
 }
@@ -820,6 +825,15 @@ void MeshRenderer::visit(ax::Renderer* renderer, const ax::Mat4& parentTransform
     uint32_t flags = processParentFlags(parentTransform, parentFlags);
     flags |= FLAGS_RENDER_AS_3D;
 
+#if AX_USE_CULLING
+    // reject the whole subtree before descending into it
+    if (isCulledBySceneTree(flags))
+    {
+        renderer->addCulledNodes(1);
+        return;
+    }
+#endif
+
     //
     _director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
     _director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
@@ -859,15 +873,25 @@ void MeshRenderer::visit(ax::Renderer* renderer, const ax::Mat4& parentTransform
 void MeshRenderer::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 {
 #if AX_USE_CULLING
-    // TODO new-renderer: interface isVisibleInFrustum removal
-    //  camera clipping
-//    if(_children.empty() && Camera::getVisitingCamera() &&
-//    !Camera::getVisitingCamera()->isVisibleInFrustum(&getAABB()))
-//        return;
+    // camera clipping, children are tested on their own when visited
+    auto camera = Camera::getVisitingCamera();
+    if (camera && !_instancing && !_meshes.empty() && !camera->isVisibleInFrustum(&getAABB()))
+    {
+        renderer->addCulledNodes(1);
+        return;
+    }
 #endif
+    if (!_meshes.empty())
+        renderer->addDrawnNodes(1);
 
     if (_skeleton)
-        _skeleton->updateBoneMatrix();
+    {
+        // skinned by SkinningStage this frame if we were on screen in the last one
+        auto frame      = _director->getTotalFrames();
+        _skinBatchFrame = frame + 1;
+        if (_skinnedFrame != frame)
+            _skeleton->updateBoneMatrix();
+    }
 
     Color4F color(getDisplayedColor());
     color.a = getDisplayedOpacity() / 255.0f;
@@ -899,6 +923,112 @@ void MeshRenderer::draw(Renderer* renderer, const Mat4& transform, uint32_t flag
     }
 }
 
+void MeshRenderer::onEnter()
+{
+    Node::onEnter();
+    if (_skeleton)
+        SkinningStage::getInstance()->addMeshRenderer(this);
+}
+
+void MeshRenderer::onExit()
+{
+    if (_skeleton)
+        SkinningStage::getInstance()->removeMeshRenderer(this);
+    releaseCullingProxy();
+    Node::onExit();
+}
+
+bool MeshRenderer::isCulledBySceneTree(uint32_t flags)
+{
+    auto camera = Camera::getVisitingCamera();
+    auto scene  = camera ? camera->getOwnerScene() : nullptr;
+    auto tree   = scene ? scene->getCullingTree() : nullptr;
+    if (!tree || _instancing)
+        return false;
+
+    // attachments follow bones, which move without touching any node setter
+    if (!_attachments.empty())
+        markSubtreeBoundsDirty();
+
+    bool registered       = tree == _cullingTree && tree->getEpoch() == _cullingEpoch && _cullingProxy >= 0;
+    bool transformChanged = (flags & FLAGS_DIRTY_MASK) != 0;
+    if (registered && !transformChanged && !_subtreeBoundsDirty && !_cullingProxyStale)
+        return !tree->isVisible(_cullingProxy);
+
+    const AABB& bounds = getSubtreeAABB(transformChanged);
+    _cullingProxyStale = false;
+    if (bounds.isEmpty())
+        return false;
+
+    bool moved = true;
+    if (registered)
+    {
+        moved = tree->moveProxy(_cullingProxy, bounds);
+    }
+    else
+    {
+        _cullingTree  = tree;
+        _cullingEpoch = tree->getEpoch();
+        _cullingProxy = tree->createProxy(bounds, this);
+    }
+
+    // the tree was culled before this visit, so a leaf that was just (re)inserted is tested directly
+    if (moved)
+        return !camera->isVisibleInFrustum(&tree->getFatAABB(_cullingProxy));
+    return !tree->isVisible(_cullingProxy);
+}
+
+const AABB& MeshRenderer::getSubtreeAABB(bool transformChanged)
+{
+    auto frame = _director->getTotalFrames();
+    if (_subtreeAABBFrame != UINT_MAX && !_subtreeBoundsDirty)
+    {
+        // a moved ancestor only invalidates bounds gathered before this frame
+        if (!transformChanged || _subtreeAABBFrame == frame)
+            return _subtreeAABB;
+    }
+
+    _subtreeAABB.reset();
+    if (!_meshes.empty())
+        _subtreeAABB.merge(getAABB());
+    for (auto&& child : _children)
+        mergeSubtreeAABB(_subtreeAABB, child, transformChanged || _subtreeBoundsDirty);
+
+    clearSubtreeBoundsDirty();
+    _subtreeAABBFrame  = frame;
+    _cullingProxyStale = true;
+    return _subtreeAABB;
+}
+
+void MeshRenderer::mergeSubtreeAABB(AABB& aabb, Node* node, bool transformChanged)
+{
+    if (auto meshRenderer = dynamic_cast<MeshRenderer*>(node))
+    {
+        aabb.merge(meshRenderer->getSubtreeAABB(transformChanged));
+        return;
+    }
+
+    // a flagged node may have moved itself, which moves everything below it
+    transformChanged = transformChanged || node->isSubtreeBoundsDirty();
+    for (auto&& child : node->getChildren())
+        mergeSubtreeAABB(aabb, child, transformChanged);
+    node->clearSubtreeBoundsDirty();
+}
+
+void MeshRenderer::releaseCullingProxy()
+{
+    if (_cullingProxy < 0)
+        return;
+
+    auto scene = getScene();
+    auto tree  = scene ? scene->getCullingTree() : nullptr;
+    if (tree && tree == _cullingTree && tree->getEpoch() == _cullingEpoch)
+        tree->destroyProxy(_cullingProxy);
+
+    _cullingTree  = nullptr;
+    _cullingProxy = -1;
+}
+
 bool MeshRenderer::setProgramState(backend::ProgramState* programState, bool ownPS /* = false*/)
 {
     if (Node::setProgramState(programState, ownPS))
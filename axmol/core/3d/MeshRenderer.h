@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include <climits>
 #include <unordered_map>
 
 #include "base/Vector.h"
@@ -48,6 +49,7 @@ namespace ax
  */
 
 class Mesh;
+class AABBTree;
 class Texture2D;
 class MeshSkin;
 class AttachNode;
@@ -57,6 +59,8 @@ struct NodeData;
  */
 class AX_DLL MeshRenderer : public Node, public BlendProtocol
 {
+    friend class SkinningStage;
+
 public:
     /**
      * Creates an empty MeshRenderer without a mesh or a texture.
@@ -233,6 +237,9 @@ public:
      */
     virtual void visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags) override;
 
+    virtual void onEnter() override;
+    virtual void onExit() override;
+
     /** generate default material. */
     void genMaterial(bool useLight = false);
 
@@ -245,10 +252,22 @@ public:
 
     void addMesh(Mesh* mesh);
 
-    void onAABBDirty() { _aabbDirty = true; }
+    void onAABBDirty()
+    {
+        _aabbDirty = true;
+        markSubtreeBoundsDirty();
+    }
 
     void afterAsyncLoad(void* param);
 
+    /** Keep this subtree's proxy in the scene culling tree up to date and report whether the tree rejects it */
+    bool isCulledBySceneTree(uint32_t flags);
+    void releaseCullingProxy();
+
+    /** Bounds of this renderer and its descendants, gathered again only when the subtree changed */
+    const AABB& getSubtreeAABB(bool transformChanged);
+    static void mergeSubtreeAABB(AABB& aabb, Node* node, bool transformChanged);
+
     static AABB getAABBRecursivelyImp(Node* node);
 
     /** Enables instancing for this Mesh Renderer, keep in mind that
@@ -326,6 +345,18 @@ protected:
     bool _usingAutogeneratedGLProgram;
     bool _transparentMaterialHint; // Generate transparent materials when building from files
     unsigned short _meshTextureHint; // Whether model file has texture config
+    bool _instancing = false;        // instances are drawn outside the mesh bounds, so skip culling
+
+    AABBTree* _cullingTree  = nullptr;  // only compared against the scene's tree, never dereferenced
+    uint32_t _cullingEpoch  = 0;
+    int _cullingProxy       = -1;
+    bool _cullingProxyStale = true;  // _subtreeAABB was gathered again since the proxy last moved
+
+    AABB _subtreeAABB;
+    unsigned int _subtreeAABBFrame = UINT_MAX;  // frame _subtreeAABB was gathered in, UINT_MAX before the first time
+
+    unsigned int _skinBatchFrame = 0;  // frame in which SkinningStage should skin this renderer, set when drawn
+    unsigned int _skinnedFrame   = 0;  // frame SkinningStage last updated the skeleton for
 
     struct AsyncLoadParam
     {
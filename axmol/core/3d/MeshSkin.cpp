@@ -26,6 +26,8 @@
 #include "3d/MeshSkin.h"
 #include "3d/Bundle3D.h"
 #include "3d/Skeleton3D.h"
+#include "base/Director.h"
+#include "math/MathUtil.h"
 
 namespace ax
 {
@@ -101,18 +103,21 @@ int MeshSkin::getBoneIndex(Bone3D* bone) const
 // compute matrix palette used by gpu skin
 Vec4* MeshSkin::getMatrixPalette()
 {
+    if (_batchedPalette && _batchedFrame == Director::getInstance()->getTotalFrames())
+        return _batchedPalette;
+
     _matrixPalette.resize(_skinBones.size() * PALETTE_ROWS);
-    int i = 0, paletteIndex = 0;
-    static Mat4 t;
-    for (auto&& it : _skinBones)
+    computeMatrixPalette(_matrixPalette.data());
+    return _matrixPalette.data();
+}
+
+void MeshSkin::computeMatrixPalette(Vec4* dst)
+{
+    for (ssize_t i = 0, size = _skinBones.size(); i < size; ++i)
     {
-        Mat4::multiply(it->getWorldMat(), _invBindPoses[i++], &t);
-        _matrixPalette[paletteIndex++].set(t.m[0], t.m[4], t.m[8], t.m[12]);
-        _matrixPalette[paletteIndex++].set(t.m[1], t.m[5], t.m[9], t.m[13]);
-        _matrixPalette[paletteIndex++].set(t.m[2], t.m[6], t.m[10], t.m[14]);
+        MathUtil::multiplyMatrixRows3x4(_skinBones.at(i)->getWorldMat().m, _invBindPoses[i].m,
+                                        &dst[i * PALETTE_ROWS].x);
     }
-
-    return _matrixPalette.data();
 }
 
 ssize_t MeshSkin::getMatrixPaletteSize() const
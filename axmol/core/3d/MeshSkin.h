@@ -50,6 +50,7 @@ class Skeleton3D;
 class AX_DLL MeshSkin : public Object
 {
     friend class Mesh;
+    friend class SkinningStage;
 
 public:
     /**create a new meshskin if do not want to share meshskin*/
@@ -69,9 +70,12 @@ public:
     /**get bone index*/
     int getBoneIndex(Bone3D* bone) const;
 
-    /**compute matrix palette used by gpu skin*/
+    /**compute matrix palette used by gpu skin, or return the one SkinningStage computed for this frame*/
     Vec4* getMatrixPalette();
 
+    /**write getMatrixPaletteSize() rows into dst; touches no shared state, so it is safe on worker threads*/
+    void computeMatrixPalette(Vec4* dst);
+
     /**getSkinBoneCount() * 3*/
     ssize_t getMatrixPaletteSize() const;
 
@@ -106,6 +110,10 @@ protected:
     // Each 4x3 row-wise matrix is represented as 3 Vec4's.
     // The number of Vec4's is (_skinBones.size() * 3).
     std::vector<Vec4> _matrixPalette;
+
+    // palette written by SkinningStage into its frame arena, valid while _batchedFrame is the current frame
+    Vec4* _batchedPalette      = nullptr;
+    unsigned int _batchedFrame = 0;
 };
 
 // end of 3d group
@@ -24,6 +24,7 @@
  ****************************************************************************/
 
 #include "3d/Skeleton3D.h"
+#include "math/MathUtil.h"
 
 namespace ax
 {
@@ -146,14 +147,7 @@ Bone3D* Bone3D::create(std::string_view id)
 
 void Bone3D::updateJointMatrix(Vec4* matrixPalette)
 {
-    {
-        static Mat4 t;
-        Mat4::multiply(_world, getInverseBindPose(), &t);
-
-        matrixPalette[0].set(t.m[0], t.m[4], t.m[8], t.m[12]);
-        matrixPalette[1].set(t.m[1], t.m[5], t.m[9], t.m[13]);
-        matrixPalette[2].set(t.m[2], t.m[6], t.m[10], t.m[14]);
-    }
+    MathUtil::multiplyMatrixRows3x4(_world.m, getInverseBindPose().m, &matrixPalette->x);
 }
 
 Bone3D* Bone3D::getParentBone()
@@ -0,0 +1,190 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "3d/SkinningStage.h"
+#include "3d/MeshRenderer.h"
+#include "3d/MeshSkin.h"
+#include "3d/Mesh.h"
+#include "3d/Skeleton3D.h"
+#include "base/Director.h"
+#include "base/EventDispatcher.h"
+#include "base/EventListenerCustom.h"
+#include "base/JobSystem.h"
+
+#include <algorithm>
+
+namespace ax
+{
+
+// Enough matrix work per chunk to amortize handing it to another thread
+static constexpr unsigned int MIN_BONES_PER_CHUNK = 256;
+
+SkinningStage* SkinningStage::_instance = nullptr;
+
+SkinningStage* SkinningStage::getInstance()
+{
+    if (_instance == nullptr)
+        _instance = new SkinningStage();
+    return _instance;
+}
+
+void SkinningStage::destroyInstance()
+{
+    if (_instance)
+    {
+        delete _instance;
+        _instance = nullptr;
+    }
+}
+
+SkinningStage::SkinningStage() {}
+
+SkinningStage::~SkinningStage()
+{
+    setEnabled(false);
+}
+
+void SkinningStage::setEnabled(bool enabled)
+{
+    if (enabled == isEnabled())
+        return;
+
+    auto dispatcher = Director::getInstance()->getEventDispatcher();
+    if (enabled)
+    {
+        _listener = dispatcher->addCustomEventListener(Director::EVENT_BEFORE_DRAW, [this](EventCustom*) { update(); });
+        _listener->retain();
+    }
+    else
+    {
+        dispatcher->removeEventListener(_listener);
+        AX_SAFE_RELEASE_NULL(_listener);
+        _arena.clear();
+        _arena.shrink_to_fit();
+    }
+}
+
+void SkinningStage::addMeshRenderer(MeshRenderer* renderer)
+{
+    if (std::find(_renderers.begin(), _renderers.end(), renderer) == _renderers.end())
+        _renderers.emplace_back(renderer);
+}
+
+void SkinningStage::removeMeshRenderer(MeshRenderer* renderer)
+{
+    auto it = std::find(_renderers.begin(), _renderers.end(), renderer);
+    if (it != _renderers.end())
+    {
+        *it = _renderers.back();
+        _renderers.pop_back();
+    }
+}
+
+void SkinningStage::update()
+{
+    const auto frame = Director::getInstance()->getTotalFrames();
+
+    _jobs.clear();
+    _skins.clear();
+    _chunks.clear();
+    _stats = Stats{};
+
+    // gather what was on screen last frame and lay its palettes out in the arena
+    size_t rows = 0;
+    for (auto renderer : _renderers)
+    {
+        if (!renderer->_skeleton || renderer->_skinBatchFrame != frame)
+            continue;
+
+        Job job{renderer, static_cast<unsigned int>(_skins.size()), 0};
+        for (auto mesh : renderer->getMeshes())
+        {
+            auto skin = mesh->getSkin();
+            if (!skin)
+                continue;
+            _skins.push_back({skin, rows});
+            rows += skin->getMatrixPaletteSize();
+            ++job.skinCount;
+        }
+        if (job.skinCount)
+            _jobs.push_back(job);
+    }
+    if (_jobs.empty())
+        return;
+
+    _arena.resize(rows);
+    for (const auto& slot : _skins)
+    {
+        slot.skin->_batchedPalette = _arena.data() + slot.offset;
+        slot.skin->_batchedFrame   = frame;
+    }
+
+    unsigned int bones = 0;
+    Chunk chunk{0, 0};
+    for (unsigned int i = 0; i < _jobs.size(); ++i)
+    {
+        auto& job                   = _jobs[i];
+        job.renderer->_skinnedFrame = frame;
+        auto jobBones               = static_cast<unsigned int>(job.renderer->_skeleton->getBoneCount());
+        bones += jobBones;
+        _stats.bones += jobBones;
+        ++chunk.jobCount;
+        if (bones >= MIN_BONES_PER_CHUNK)
+        {
+            _chunks.push_back(chunk);
+            chunk = Chunk{i + 1, 0};
+            bones = 0;
+        }
+    }
+    if (chunk.jobCount)
+        _chunks.push_back(chunk);
+
+    _stats.skeletons = static_cast<unsigned int>(_jobs.size());
+    _stats.palettes  = static_cast<unsigned int>(_skins.size());
+    _stats.chunks    = static_cast<unsigned int>(_chunks.size());
+
+    // Chunks nobody picked up run on the main thread, so a busy job system never stalls the frame
+    auto jobSystem = Director::getInstance()->getJobSystem();
+    auto body      = [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            runChunk(_chunks[i]);
+    };
+    if (jobSystem)
+        jobSystem->parallelFor(_chunks.size(), 1, body);
+    else
+        body(0, _chunks.size());
+}
+
+void SkinningStage::runChunk(const Chunk& chunk)
+{
+    for (unsigned int i = chunk.firstJob, end = chunk.firstJob + chunk.jobCount; i < end; ++i)
+    {
+        const auto& job = _jobs[i];
+        job.renderer->_skeleton->updateBoneMatrix();
+        for (unsigned int s = job.firstSkin, last = job.firstSkin + job.skinCount; s < last; ++s)
+            _skins[s].skin->computeMatrixPalette(_arena.data() + _skins[s].offset);
+    }
+}
+
+}  // namespace ax
@@ -0,0 +1,120 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "math/Math.h"
+#include <vector>
+
+namespace ax
+{
+
+class MeshRenderer;
+class MeshSkin;
+class EventListenerCustom;
+
+/**
+ * @addtogroup _3d
+ * @{
+ */
+
+/**
+ * @brief Computes the skinning of every animated MeshRenderer in one pass before the scene is drawn.
+ *
+ * Without the stage each MeshRenderer refreshes its skeleton and builds its palettes inside draw(), one
+ * character at a time on the main thread. Once enabled, the stage runs on Director::EVENT_BEFORE_DRAW,
+ * after all updates and actions, and splits the skinned renderers drawn in the previous frame across the
+ * job system. Bone world matrices and 3x4 palettes are written into an arena reused from frame to frame,
+ * and draw() then only uploads them. Renderers that were off screen last frame fall back to the
+ * per-draw path, so nothing is ever drawn with a stale pose.
+ */
+class AX_DLL SkinningStage
+{
+public:
+    struct Stats
+    {
+        unsigned int skeletons = 0;
+        unsigned int palettes  = 0;
+        unsigned int bones     = 0;
+        unsigned int chunks    = 0;
+    };
+
+    static SkinningStage* getInstance();
+    static void destroyInstance();
+
+    /** enable or disable batched skinning, disabled by default */
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return _listener != nullptr; }
+
+    /** MeshRenderers with a skeleton register themselves while they are running */
+    void addMeshRenderer(MeshRenderer* renderer);
+    void removeMeshRenderer(MeshRenderer* renderer);
+
+    /** compute skeletons and palettes for the current frame, called automatically while enabled */
+    void update();
+
+    /** counters of the last update() */
+    const Stats& getStats() const { return _stats; }
+
+protected:
+    SkinningStage();
+    ~SkinningStage();
+
+    struct Job
+    {
+        MeshRenderer* renderer;
+        unsigned int firstSkin;
+        unsigned int skinCount;
+    };
+
+    struct SkinSlot
+    {
+        MeshSkin* skin;
+        size_t offset;  // first palette row in _arena
+    };
+
+    struct Chunk
+    {
+        unsigned int firstJob;
+        unsigned int jobCount;
+    };
+
+    void runChunk(const Chunk& chunk);
+
+    static SkinningStage* _instance;
+
+    std::vector<MeshRenderer*> _renderers;  // weak refs
+    std::vector<Job> _jobs;
+    std::vector<SkinSlot> _skins;
+    std::vector<Chunk> _chunks;
+    std::vector<Vec4> _arena;  // palettes of the current frame, capacity is kept across frames
+    EventListenerCustom* _listener = nullptr;
+    Stats _stats;
+};
+
+// end of 3d group
+/// @}
+
+}  // namespace ax
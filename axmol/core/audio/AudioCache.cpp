@@ -30,6 +30,7 @@
 #include <thread>
 #include "base/Director.h"
 #include "base/Scheduler.h"
+#include "base/FrameProfiler.h"
 
 #include "audio/AudioDecoderManager.h"
 #include "audio/AudioDecoder.h"
@@ -110,6 +111,8 @@ AudioCache::~AudioCache()
 
 void AudioCache::readDataTask(unsigned int selfId)
 {
+    AX_PROFILE_ZONE("AudioCache::readDataTask");
+
     // Note: It's in sub thread
     AXLOGV("readDataTask begin, cache id={}", selfId);
 
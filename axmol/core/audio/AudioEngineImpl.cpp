@@ -36,6 +36,7 @@
 #include "platform/FileUtils.h"
 #include "base/Director.h"
 #include "base/Scheduler.h"
+#include "base/FrameProfiler.h"
 #include "base/Utils.h"
 
 #if AX_USE_ALSOFT
@@ -992,6 +993,8 @@ void AudioEngineImpl::setFinishCallback(AUDIO_ID audioID,
 
 void AudioEngineImpl::update(float /*dt*/)
 {
+    AX_PROFILE_ZONE("AudioEngine::update");
+
     std::unique_lock<std::recursive_mutex> lck(_threadMutex);
     _updatePlayers(false);
 }
@@ -30,6 +30,7 @@
 #include "platform/FileUtils.h"
 #include "audio/AudioDecoder.h"
 #include "audio/AudioDecoderManager.h"
+#include "base/FrameProfiler.h"
 
 #if AX_USE_ALSOFT
 #    include "audio/AudioEffectsExtension.h"
@@ -428,6 +429,7 @@ void AudioPlayer::clearEffects()
 void AudioPlayer::rotateBufferThread(int offsetFrame)
 {
     yasio::set_thread_name("axmol-audio");
+    AX_PROFILE_THREAD("axmol-audio");
 
     char* tmpBuffer           = nullptr;
     auto& fullPath            = _audioCache->_fileFullPath;
@@ -463,6 +465,7 @@ void AudioPlayer::rotateBufferThread(int offsetFrame)
                 alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
                 while (bufferProcessed > 0)
                 {
+                    AX_PROFILE_ZONE("AudioPlayer::rotateBuffer");
                     bufferProcessed--;
                     if (_timeDirty)
                     {
@@ -45,6 +45,10 @@ THE SOFTWARE.
 #include "base/Logging.h"
 #include "base/Data.h"
 #include "base/Director.h"
+#include "base/FrameArena.h"
+#include "base/FrameProfiler.h"
+#include "base/FrameStats.h"
+#include "base/InlineFunction.h"
 #include "base/IMEDelegate.h"
 #include "base/IMEDispatcher.h"
 #include "base/Map.h"
@@ -135,6 +139,7 @@ THE SOFTWARE.
 #include "2d/ProtectedNode.h"
 #include "2d/RenderTexture.h"
 #include "2d/Scene.h"
+#include "2d/TransformPrepass.h"
 #include "2d/Transition.h"
 #include "2d/TransitionPageTurn.h"
 #include "2d/TransitionProgress.h"
@@ -263,6 +268,7 @@ THE SOFTWARE.
 
 // 3d
 #include "3d/AABB.h"
+#include "3d/AABBTree.h"
 #include "3d/Animate3D.h"
 #include "3d/Animation3D.h"
 #include "3d/AttachNode.h"
@@ -276,6 +282,7 @@ THE SOFTWARE.
 #include "3d/Plane.h"
 #include "3d/Ray.h"
 #include "3d/Skeleton3D.h"
+#include "3d/SkinningStage.h"
 #include "3d/Skybox.h"
 #include "3d/MeshRenderer.h"
 #include "3d/MeshMaterial.h"
@@ -242,11 +242,32 @@ THE SOFTWARE.
  * once per second showing average time (in milliseconds) required to execute the specific routine(s).
  * Useful for debugging purposes only. It is recommended to leave it disabled.
  * To enable set it to a value different than 0. Disabled by default.
+ * Superseded by AX_ENABLE_FRAME_PROFILER, see FrameProfiler.
  */
 #ifndef AX_ENABLE_PROFILERS
 #    define AX_ENABLE_PROFILERS 0
 #endif
 
+/** @def AX_ENABLE_FRAME_PROFILER
+ * If enabled, AX_PROFILE_ZONE() records scoped zones for FrameProfiler. Zones cost one relaxed atomic load
+ * while no capture is running, so it is enabled by default, including release builds.
+ * To strip the instrumentation entirely set it to 0.
+ */
+#ifndef AX_ENABLE_FRAME_PROFILER
+#    define AX_ENABLE_FRAME_PROFILER 1
+#endif
+
+/** @def AX_ENABLE_HEAP_ALLOCATION_COUNTER
+ * If enabled, the engine replaces the global operator new to count heap allocations. The count for the
+ * last frame is available from Director::getFrameHeapAllocations().
+ * Costs one relaxed atomic increment per allocation, and takes the global operator new away from the
+ * application, so it is disabled by default. The AX_ENABLE_HEAP_ALLOCATION_COUNTER CMake option turns it
+ * on for the engine, and benchmark builds (ENABLE_BENCHMARKS) enable it by default.
+ */
+#ifndef AX_ENABLE_HEAP_ALLOCATION_COUNTER
+#    define AX_ENABLE_HEAP_ALLOCATION_COUNTER 0
+#endif
+
 /** Enable Lua engine debug log. */
 #ifndef AX_LUA_ENGINE_DEBUG
 #    define AX_LUA_ENGINE_DEBUG 0
@@ -47,6 +47,8 @@
 #include "base/Scheduler.h"
 #include "platform/PlatformConfig.h"
 #include "base/Configuration.h"
+#include "base/FrameProfiler.h"
+#include "base/FrameStats.h"
 #include "2d/Scene.h"
 #include "platform/FileUtils.h"
 #include "renderer/TextureCache.h"
@@ -65,6 +67,17 @@ extern const char* axmolVersion(void);
 
 static const size_t SEND_BUFSIZ = 512;
 
+static char invalid_filename_char[] = {':', '/', '\\', '?', '%', '*', '<', '>', '"', '|', '\r', '\n', '\t'};
+
+// names received from a console client are appended to the writable path, so they may not leave it
+static bool isValidFileName(std::string_view name)
+{
+    if (name.empty() || name == "." || name == "..")
+        return false;
+    return std::none_of(std::begin(invalid_filename_char), std::end(invalid_filename_char),
+                        [name](char c) { return name.find(c) != std::string_view::npos; });
+}
+
 //
 //  Utility code
 //
@@ -362,7 +375,9 @@ Console::Console()
     createCommandExit();
     createCommandFileUtils();
     createCommandFps();
+    createCommandFrameStats();
     createCommandHelp();
+    createCommandProfiler();
     createCommandProjection();
     createCommandResolution();
     createCommandSceneGraph();
@@ -904,11 +919,32 @@ void Console::createCommandFps()
                           AX_CALLBACK_2(Console::commandFpsSubCommandOnOff, this)});
 }
 
+void Console::createCommandFrameStats()
+{
+    addCommand({"framestats", "Print the frame timing percentiles. Args: [-h | help | reset | dump | ]",
+                AX_CALLBACK_2(Console::commandFrameStats, this)});
+    addSubCommand("framestats", {"reset", "Discard the collected frames.",
+                                 AX_CALLBACK_2(Console::commandFrameStatsSubCommandReset, this)});
+    addSubCommand("framestats",
+                  {"dump", "Print the stats as JSON, or save them to the writable path. Args: [file name]",
+                   AX_CALLBACK_2(Console::commandFrameStatsSubCommandDump, this)});
+}
+
 void Console::createCommandHelp()
 {
     addCommand({"help", "Print this message. Args: [ ]", AX_CALLBACK_2(Console::commandHelp, this)});
 }
 
+void Console::createCommandProfiler()
+{
+    addCommand({"profiler", "Capture a frame profiler trace. Args: [-h | help | start | stop | ]",
+                AX_CALLBACK_2(Console::commandProfiler, this)});
+    addSubCommand("profiler", {"start", "Start a capture. Args: [events per thread]",
+                               AX_CALLBACK_2(Console::commandProfilerSubCommandStart, this)});
+    addSubCommand("profiler", {"stop", "Stop the capture and save a Chrome trace to the writable path. Args: [file name]",
+                               AX_CALLBACK_2(Console::commandProfilerSubCommandStop, this)});
+}
+
 void Console::createCommandProjection()
 {
     addCommand({"projection", "Change or print the current projection. Args: [-h | help | 2d | 3d | ]",
@@ -1041,7 +1077,8 @@ void Console::commandFileUtils(socket_native_type fd, std::string_view /*args*/)
 
 void Console::commandFileUtilsSubCommandFlush(socket_native_type /*fd*/, std::string_view /*args*/)
 {
-    FileUtils::getInstance()->purgeCachedEntries();
+    Scheduler* sched = Director::getInstance()->getScheduler();
+    sched->runOnAxmolThread([] { FileUtils::getInstance()->purgeCachedEntries(); });
 }
 
 void Console::commandFps(socket_native_type fd, std::string_view /*args*/)
@@ -1057,11 +1094,102 @@ void Console::commandFpsSubCommandOnOff(socket_native_type /*fd*/, std::string_v
     sched->runOnAxmolThread(std::bind(&Director::setStatsDisplay, dir, state));
 }
 
+void Console::commandFrameStats(socket_native_type fd, std::string_view /*args*/)
+{
+    Scheduler* sched = Director::getInstance()->getScheduler();
+    sched->runOnAxmolThread([fd] {
+        auto text = Director::getInstance()->getFrameStats()->toString();
+        Console::Utility::sendToConsole(fd, text.c_str(), text.length());
+    });
+}
+
+void Console::commandFrameStatsSubCommandReset(socket_native_type /*fd*/, std::string_view /*args*/)
+{
+    Scheduler* sched = Director::getInstance()->getScheduler();
+    sched->runOnAxmolThread([] { Director::getInstance()->getFrameStats()->reset(); });
+}
+
+void Console::commandFrameStatsSubCommandDump(socket_native_type fd, std::string_view args)
+{
+    std::string name;
+    auto pos = args.find(' ');
+    if (pos != std::string_view::npos && pos + 1 < args.size())
+        name = args.substr(pos + 1);
+
+    if (!name.empty() && !isValidFileName(name))
+    {
+        Console::Utility::mydprintf(fd, "framestats: invalid file name!\n");
+        return;
+    }
+
+    Scheduler* sched = Director::getInstance()->getScheduler();
+    sched->runOnAxmolThread([fd, name] {
+        auto json = Director::getInstance()->getFrameStats()->toJson();
+        if (name.empty())
+        {
+            Console::Utility::sendToConsole(fd, json.c_str(), json.length());
+            return;
+        }
+
+        auto path = FileUtils::getInstance()->getWritablePath();
+        path.append(name);
+        if (FileUtils::getInstance()->writeStringToFile(json, path))
+            Console::Utility::mydprintf(fd, "Frame stats saved to %s\n", path.c_str());
+        else
+            Console::Utility::mydprintf(fd, "Failed to save frame stats to %s\n", path.c_str());
+    });
+}
+
 void Console::commandHelp(socket_native_type fd, std::string_view /*args*/)
 {
     sendHelp(fd, _commands, "\nAvailable commands:\n");
 }
 
+void Console::commandProfiler(socket_native_type fd, std::string_view /*args*/)
+{
+    Console::Utility::mydprintf(fd, "Profiler is: %s\nZones recorded: %llu\nZones dropped: %llu\n",
+                                FrameProfiler::isCapturing() ? "capturing" : "idle",
+                                static_cast<unsigned long long>(FrameProfiler::getRecordedCount()),
+                                static_cast<unsigned long long>(FrameProfiler::getDroppedCount()));
+}
+
+void Console::commandProfilerSubCommandStart(socket_native_type fd, std::string_view args)
+{
+    auto events = FrameProfiler::DEFAULT_EVENTS_PER_THREAD;
+    auto pos    = args.find(' ');
+    if (pos != std::string_view::npos)
+    {
+        auto value = atoi(std::string{args.substr(pos + 1)}.c_str());
+        if (value > 0)
+            events = static_cast<uint32_t>(value);
+    }
+    FrameProfiler::start(events);
+    Console::Utility::mydprintf(fd, "Profiler capture started\n");
+}
+
+void Console::commandProfilerSubCommandStop(socket_native_type fd, std::string_view args)
+{
+    FrameProfiler::stop();
+
+    std::string_view name = "trace.json";
+    auto pos              = args.find(' ');
+    if (pos != std::string_view::npos && pos + 1 < args.size())
+        name = args.substr(pos + 1);
+
+    if (!isValidFileName(name))
+    {
+        Console::Utility::mydprintf(fd, "profiler: invalid file name!\n");
+        return;
+    }
+
+    auto path = FileUtils::getInstance()->getWritablePath();
+    path.append(name);
+    if (FrameProfiler::saveChromeTrace(path))
+        Console::Utility::mydprintf(fd, "Trace saved to %s\n", path.c_str());
+    else
+        Console::Utility::mydprintf(fd, "Failed to save trace to %s\n", path.c_str());
+}
+
 void Console::commandProjection(socket_native_type fd, std::string_view /*args*/)
 {
     auto director = Director::getInstance();
@@ -1278,8 +1406,6 @@ void Console::commandTouchSubCommandSwipe(socket_native_type fd, std::string_vie
     }
 }
 
-static char invalid_filename_char[] = {':', '/', '\\', '?', '%', '*', '<', '>', '"', '|', '\r', '\n', '\t'};
-
 void Console::commandUpload(socket_native_type fd)
 {
     ssize_t n, rc;
@@ -220,7 +220,9 @@ protected:
     void createCommandExit();
     void createCommandFileUtils();
     void createCommandFps();
+    void createCommandFrameStats();
     void createCommandHelp();
+    void createCommandProfiler();
     void createCommandProjection();
     void createCommandResolution();
     void createCommandSceneGraph();
@@ -244,7 +246,13 @@ protected:
     void commandFileUtilsSubCommandFlush(socket_native_type fd, std::string_view args);
     void commandFps(socket_native_type fd, std::string_view args);
     void commandFpsSubCommandOnOff(socket_native_type fd, std::string_view args);
+    void commandFrameStats(socket_native_type fd, std::string_view args);
+    void commandFrameStatsSubCommandReset(socket_native_type fd, std::string_view args);
+    void commandFrameStatsSubCommandDump(socket_native_type fd, std::string_view args);
     void commandHelp(socket_native_type fd, std::string_view args);
+    void commandProfiler(socket_native_type fd, std::string_view args);
+    void commandProfilerSubCommandStart(socket_native_type fd, std::string_view args);
+    void commandProfilerSubCommandStop(socket_native_type fd, std::string_view args);
     void commandProjection(socket_native_type fd, std::string_view args);
     void commandProjectionSubCommand2d(socket_native_type fd, std::string_view args);
     void commandProjectionSubCommand3d(socket_native_type fd, std::string_view args);
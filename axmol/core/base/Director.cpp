@@ -54,13 +54,20 @@ THE SOFTWARE.
 #include "base/Macros.h"
 #include "base/EventDispatcher.h"
 #include "base/EventCustom.h"
+#include "base/EventType.h"
 #include "base/Logging.h"
 #include "base/AutoreleasePool.h"
+#include "base/FrameArena.h"
+#include "base/FrameProfiler.h"
+#include "base/FrameStats.h"
 #include "base/Configuration.h"
 #ifndef AX_CORE_PROFILE
 #    include "base/AsyncTaskPool.h"
 #endif
 #include "base/ObjectFactory.h"
+#if defined(AX_ENABLE_3D)
+#    include "3d/SkinningStage.h"
+#endif
 #include "platform/Application.h"
 #if defined(AX_ENABLE_AUDIO)
 #    include "audio/AudioEngine.h"
@@ -112,6 +119,8 @@ Director::Director() {}
 
 bool Director::init()
 {
+    AX_PROFILE_THREAD("Main");
+
     setDefaultValues();
 
     _scenesStack.reserve(15);
@@ -122,6 +131,10 @@ bool Director::init()
     auto concurrency = Configuration::getInstance()->getValue("axmol.concurrency", Value{-1}).asInt();
     _jobSystem = new JobSystem(concurrency);
 
+    _frameArenas[0] = new FrameArena();
+    _frameArenas[1] = new FrameArena();
+    _frameStats     = new FrameStats();
+
 #ifdef AX_ENABLE_CONSOLE
     _console = new Console();
 #endif
@@ -208,6 +221,10 @@ Director::~Director()
 
     AX_SAFE_DELETE(_jobSystem);
 
+    AX_SAFE_DELETE(_frameArenas[0]);
+    AX_SAFE_DELETE(_frameArenas[1]);
+    AX_SAFE_DELETE(_frameStats);
+
     s_SharedDirector = nullptr;
 }
 
@@ -288,6 +305,7 @@ void Director::drawScene()
     // tick before glClear: issue #533
     if (!_paused)
     {
+        FrameStats::PhaseScope phase(_frameStats, FrameStats::Phase::UPDATE);
         _eventDispatcher->dispatchEvent(_eventBeforeUpdate);
         _scheduler->update(_deltaTime);
         _eventDispatcher->dispatchEvent(_eventAfterUpdate);
@@ -318,7 +336,11 @@ void Director::drawScene()
 
         // render the scene
         if (_renderView)
+        {
+            AX_PROFILE_ZONE("Director::renderScene");
+            FrameStats::PhaseScope phase(_frameStats, FrameStats::Phase::VISIT);
             _renderView->renderScene(_runningScene, _renderer);
+        }
 
         _eventDispatcher->dispatchEvent(_eventAfterVisit);
     }
@@ -326,6 +348,7 @@ void Director::drawScene()
     // draw the notifications node
     if (_notificationNode)
     {
+        FrameStats::PhaseScope phase(_frameStats, FrameStats::Phase::VISIT);
         _notificationNode->visit(_renderer, Mat4::IDENTITY, 0);
     }
 
@@ -349,6 +372,8 @@ void Director::drawScene()
     // swap buffers
     if (_renderView)
     {
+        AX_PROFILE_ZONE("Director::swapBuffers");
+        FrameStats::PhaseScope phase(_frameStats, FrameStats::Phase::SWAP);
         _renderView->swapBuffers();
     }
 
@@ -687,6 +712,7 @@ void Director::purgeCachedData()
         AXLOGD("{}\n", _textureCache->getCachedTextureInfo());
     }
     FileUtils::getInstance()->purgeCachedEntries();
+    _eventDispatcher->dispatchCustomEvent(EVENT_FILE_CACHE_PURGED);
 }
 
 float Director::getZEye() const
@@ -1091,6 +1117,7 @@ void Director::reset()
     AX_SAFE_RELEASE_NULL(_FPSLabel);
     AX_SAFE_RELEASE_NULL(_drawnBatchesLabel);
     AX_SAFE_RELEASE_NULL(_drawnVerticesLabel);
+    AX_SAFE_RELEASE_NULL(_drawnNodesLabel);
     _isStatusLabelUpdated = true;
 
     // purge bitmap cache
@@ -1108,6 +1135,9 @@ void Director::reset()
 #endif
     backend::ProgramStateRegistry::destroyInstance();
     backend::ProgramManager::destroyInstance();
+#if defined(AX_ENABLE_3D)
+    SkinningStage::destroyInstance();
+#endif
 
     // axmol specific data structures
     UserDefault::destroyInstance();
@@ -1247,6 +1277,7 @@ void Director::resume()
     _deltaTime = 0;
     // fix issue #3509, skip one fps to avoid incorrect time calculation.
     setNextDeltaTimeZero(true);
+    _frameStats->skipFrameInterval();
 }
 
 void Director::updateFrameRate()
@@ -1274,13 +1305,15 @@ void Director::showStats()
         _isStatusLabelUpdated = false;
     }
 
-    static uint32_t prevCalls = 0;
-    static uint32_t prevVerts = 0;
+    static uint32_t prevCalls  = 0;
+    static uint32_t prevVerts  = 0;
+    static uint32_t prevNodes  = 0;
+    static uint32_t prevCulled = 0;
 
     ++_frames;
     _accumDt += _deltaTime;
 
-    if (_statsDisplay && _FPSLabel && _drawnBatchesLabel && _drawnVerticesLabel)
+    if (_statsDisplay && _FPSLabel && _drawnBatchesLabel && _drawnVerticesLabel && _drawnNodesLabel)
     {
         char buffer[30];
 
@@ -1311,7 +1344,19 @@ void Director::showStats()
             prevVerts = currentVerts;
         }
 
+        // nodes that went through frustum culling: sprites, labels and meshes
+        auto currentNodes  = (uint32_t)_renderer->getDrawnNodes();
+        auto currentCulled = (uint32_t)_renderer->getCulledNodes();
+        if (currentNodes != prevNodes || currentCulled != prevCulled)
+        {
+            auto msg = fmt::format_to_z(buffer, "Nodes:{:6d} culled:{:6d}", currentNodes, currentCulled);
+            _drawnNodesLabel->setString(msg);
+            prevNodes  = currentNodes;
+            prevCulled = currentCulled;
+        }
+
         const Mat4& identity = Mat4::IDENTITY;
+        _drawnNodesLabel->visit(_renderer, identity, 0);
         _drawnVerticesLabel->visit(_renderer, identity, 0);
         _drawnBatchesLabel->visit(_renderer, identity, 0);
         _FPSLabel->visit(_renderer, identity, 0);
@@ -1341,15 +1386,18 @@ void Director::createStatsLabel()
     std::string fpsString          = "00.0";
     std::string drawBatchString    = "000";
     std::string drawVerticesString = "00000";
+    std::string drawNodesString    = "000";
     if (_FPSLabel)
     {
         fpsString          = _FPSLabel->getString();
         drawBatchString    = _drawnBatchesLabel->getString();
         drawVerticesString = _drawnVerticesLabel->getString();
+        drawNodesString    = _drawnNodesLabel->getString();
 
         AX_SAFE_RELEASE_NULL(_FPSLabel);
         AX_SAFE_RELEASE_NULL(_drawnBatchesLabel);
         AX_SAFE_RELEASE_NULL(_drawnVerticesLabel);
+        AX_SAFE_RELEASE_NULL(_drawnNodesLabel);
         _textureCache->removeTextureForKey("/ax_fps_images");
         FileUtils::getInstance()->purgeCachedEntries();
     }
@@ -1396,6 +1444,11 @@ void Director::createStatsLabel()
     _drawnVerticesLabel->setIgnoreContentScaleFactor(true);
     _drawnVerticesLabel->setScale(scaleFactor);
 
+    _drawnNodesLabel = LabelAtlas::create(drawNodesString, texture, 12, 32, '.');
+    _drawnNodesLabel->retain();
+    _drawnNodesLabel->setIgnoreContentScaleFactor(true);
+    _drawnNodesLabel->setScale(scaleFactor);
+
     setStatsAnchor();
 }
 
@@ -1418,66 +1471,77 @@ void Director::setStatsAnchor(AnchorPreset anchor)
         {
         case AnchorPreset::BOTTOM_LEFT:
             _fpsPosition = Vec2(0, 0);
+            _drawnNodesLabel->setAnchorPoint({0, 0});
             _drawnVerticesLabel->setAnchorPoint({0, 0});
             _drawnBatchesLabel->setAnchorPoint({0, 0});
             _FPSLabel->setAnchorPoint({0, 0});
             break;
         case AnchorPreset::CENTER_LEFT:
-            _fpsPosition = Vec2(0, safeSize.height / 2 - height_spacing * 1.5);
+            _fpsPosition = Vec2(0, safeSize.height / 2 - height_spacing * 2);
+            _drawnNodesLabel->setAnchorPoint({0, 0.0});
             _drawnVerticesLabel->setAnchorPoint({0, 0.0});
             _drawnBatchesLabel->setAnchorPoint({0, 0.0});
             _FPSLabel->setAnchorPoint({0, 0});
             break;
         case AnchorPreset::TOP_LEFT:
-            _fpsPosition = Vec2(0, safeSize.height - height_spacing * 3);
+            _fpsPosition = Vec2(0, safeSize.height - height_spacing * 4);
+            _drawnNodesLabel->setAnchorPoint({0, 0});
             _drawnVerticesLabel->setAnchorPoint({0, 0});
             _drawnBatchesLabel->setAnchorPoint({0, 0});
             _FPSLabel->setAnchorPoint({0, 0});
             break;
         case AnchorPreset::BOTTOM_RIGHT:
             _fpsPosition = Vec2(safeSize.width, 0);
+            _drawnNodesLabel->setAnchorPoint({1, 0});
             _drawnVerticesLabel->setAnchorPoint({1, 0});
             _drawnBatchesLabel->setAnchorPoint({1, 0});
             _FPSLabel->setAnchorPoint({1, 0});
             break;
         case AnchorPreset::CENTER_RIGHT:
-            _fpsPosition = Vec2(safeSize.width, safeSize.height / 2 - height_spacing * 1.5);
+            _fpsPosition = Vec2(safeSize.width, safeSize.height / 2 - height_spacing * 2);
+            _drawnNodesLabel->setAnchorPoint({1, 0.0});
             _drawnVerticesLabel->setAnchorPoint({1, 0.0});
             _drawnBatchesLabel->setAnchorPoint({1, 0.0});
             _FPSLabel->setAnchorPoint({1, 0.0});
             break;
         case AnchorPreset::TOP_RIGHT:
-            _fpsPosition = Vec2(safeSize.width, safeSize.height - height_spacing * 3);
+            _fpsPosition = Vec2(safeSize.width, safeSize.height - height_spacing * 4);
+            _drawnNodesLabel->setAnchorPoint({1, 0});
             _drawnVerticesLabel->setAnchorPoint({1, 0});
             _drawnBatchesLabel->setAnchorPoint({1, 0});
             _FPSLabel->setAnchorPoint({1, 0});
             break;
         case AnchorPreset::BOTTOM_CENTER:
             _fpsPosition = Vec2(safeSize.width / 2, 0);
+            _drawnNodesLabel->setAnchorPoint({0.5, 0});
             _drawnVerticesLabel->setAnchorPoint({0.5, 0});
             _drawnBatchesLabel->setAnchorPoint({0.5, 0});
             _FPSLabel->setAnchorPoint({0.5, 0});
             break;
         case AnchorPreset::CENTER:
-            _fpsPosition = Vec2(safeSize.width / 2, safeSize.height / 2 - height_spacing * 1.5);
+            _fpsPosition = Vec2(safeSize.width / 2, safeSize.height / 2 - height_spacing * 2);
+            _drawnNodesLabel->setAnchorPoint({0.5, 0.0});
             _drawnVerticesLabel->setAnchorPoint({0.5, 0.0});
             _drawnBatchesLabel->setAnchorPoint({0.5, 0.0});
             _FPSLabel->setAnchorPoint({0.5, 0.0});
             break;
         case AnchorPreset::TOP_CENTER:
-            _fpsPosition = Vec2(safeSize.width / 2, safeSize.height - height_spacing * 3);
+            _fpsPosition = Vec2(safeSize.width / 2, safeSize.height - height_spacing * 4);
+            _drawnNodesLabel->setAnchorPoint({0.5, 0});
             _drawnVerticesLabel->setAnchorPoint({0.5, 0});
             _drawnBatchesLabel->setAnchorPoint({0.5, 0});
             _FPSLabel->setAnchorPoint({0.5, 0});
             break;
         default:  // FPSPosition::BOTTOM_LEFT
             _fpsPosition = Vec2(0, 0);
+            _drawnNodesLabel->setAnchorPoint({0, 0});
             _drawnVerticesLabel->setAnchorPoint({0, 0});
             _drawnBatchesLabel->setAnchorPoint({0, 0});
             _FPSLabel->setAnchorPoint({0, 0});
             break;
         }
 
+        _drawnNodesLabel->setPosition(Vec2(0, height_spacing * 3.0f) + _fpsPosition + safeOrigin);
         _drawnVerticesLabel->setPosition(Vec2(0, height_spacing * 2.0f) + _fpsPosition + safeOrigin);
         _drawnBatchesLabel->setPosition(Vec2(0, height_spacing * 1.0f) + _fpsPosition + safeOrigin);
         _FPSLabel->setPosition(Vec2(0, height_spacing * 0.0f) + _fpsPosition + safeOrigin);
@@ -1560,6 +1624,7 @@ void Director::startAnimation(SetIntervalReason reason)
 
     // fix issue #3509, skip one fps to avoid incorrect time calculation.
     setNextDeltaTimeZero(true);
+    _frameStats->skipFrameInterval();
 }
 
 void Director::queueOperation(AsyncOperation op, void* param)
@@ -1582,6 +1647,8 @@ void Director::processOperations()
 
 void Director::mainLoop()
 {
+    AX_PROFILE_ZONE("Director::mainLoop");
+
 #if defined(AX_PLATFORM_PC)
     processOperations();
 #endif
@@ -1598,13 +1665,34 @@ void Director::mainLoop()
     }
     else if (!_invalid)
     {
+        _frameStats->beginFrame();
+
         drawScene();
 
         // release the objects
         PoolManager::getInstance()->getCurrentPool()->clear();
+
+        endFrameMemory();
+
+        _frameStats->endFrame(static_cast<uint32_t>(_renderer->getDrawnBatches()),
+                              static_cast<uint32_t>(_renderer->getDrawnVertices()),
+                              static_cast<uint32_t>(_renderer->getDrawnNodes()),
+                              static_cast<uint32_t>(_renderer->getCulledNodes()),
+                              static_cast<uint32_t>(_frameHeapAllocations), _animationInterval);
     }
 }
 
+void Director::endFrameMemory()
+{
+    // what was allocated from the previous frame's arena is not referenced anymore
+    _frameArenaIndex ^= 1;
+    _frameArenas[_frameArenaIndex]->reset();
+
+    auto heapAllocations  = FrameArena::getHeapAllocationCount();
+    _frameHeapAllocations = heapAllocations - _heapAllocationMark;
+    _heapAllocationMark   = heapAllocations;
+}
+
 void Director::mainLoop(float dt)
 {
     _deltaTime               = dt;
@@ -57,6 +57,8 @@ namespace ax
 
 /* Forward declarations. */
 class LabelAtlas;
+class FrameArena;
+class FrameStats;
 // class RenderView;
 class DirectorDelegate;
 class Node;
@@ -414,6 +416,22 @@ public:
      */
     JobSystem* getJobSystem() const { return _jobSystem; }
 
+    /** Gets the arena for temporaries of the current frame.
+     * The two frame arenas are swapped at the end of every frame and the new current one is reset, so
+     * memory from it remains valid until the end of the next frame. Main thread only.
+     */
+    FrameArena* getFrameArena() const { return _frameArenas[_frameArenaIndex]; }
+
+    /** Number of heap allocations made during the last complete frame.
+     * Always 0 unless the engine is built with AX_ENABLE_HEAP_ALLOCATION_COUNTER.
+     */
+    uint64_t getFrameHeapAllocations() const { return _frameHeapAllocations; }
+
+    /** Gets the rolling frame timing statistics: frame time percentiles, per-phase timings, draw stats
+     * and allocation counts of the last frames. Main thread only.
+     */
+    FrameStats* getFrameStats() const { return _frameStats; }
+
     /** Gets the Scheduler associated with this director.
      * @since v2.0
      */
@@ -559,6 +577,9 @@ protected:
     /** calculates delta time since last time it was called */
     void calculateDeltaTime();
 
+    /** swaps the frame arenas and samples the heap allocation counter */
+    void endFrameMemory();
+
     // textureCache creation or release
     void initTextureCache();
     void destroyTextureCache();
@@ -603,6 +624,13 @@ protected:
 
     JobSystem* _jobSystem = nullptr;
 
+    FrameArena* _frameArenas[2]   = {};
+    unsigned int _frameArenaIndex = 0;
+    uint64_t _frameHeapAllocations = 0;
+    uint64_t _heapAllocationMark   = 0;
+
+    FrameStats* _frameStats = nullptr;
+
     // texture cache belongs to this director
     TextureCache* _textureCache = nullptr;
 
@@ -616,6 +644,7 @@ protected:
     LabelAtlas* _FPSLabel           = nullptr;
     LabelAtlas* _drawnBatchesLabel  = nullptr;
     LabelAtlas* _drawnVerticesLabel = nullptr;
+    LabelAtlas* _drawnNodesLabel    = nullptr;
 
     /** Whether or not the Director is paused */
     bool _paused = false;
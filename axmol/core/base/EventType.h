@@ -56,3 +56,9 @@
 // This message is used for notifying application code of a warm start.
 // This message is posted in core/platform/android/javaactivity.cpp
 #define EVENT_APP_WARM_START "event_app_warm_start"
+
+// Files found through the search paths may have changed, or memory is low.
+// This message is used for dropping caches keyed on file paths, such as CSLoader's parsed .csb files.
+// This message is posted by Director::purgeCachedData on memory warnings and by AssetsManagerEx once an update
+// replaced files and search paths.
+#define EVENT_FILE_CACHE_PURGED "event_file_cache_purged"
@@ -0,0 +1,198 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "base/FrameArena.h"
+#include "base/Config.h"
+#include "base/Macros.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+
+#if AX_ENABLE_HEAP_ALLOCATION_COUNTER
+namespace
+{
+std::atomic<uint64_t> s_heapAllocations{0};
+}
+
+// Only the non over-aligned forms are replaced; they are replaced as a complete set so that
+// allocation and deallocation always pair up, whatever the standard library defaults forward to.
+void* operator new(std::size_t size)
+{
+    s_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (size == 0)
+        size = 1;
+    for (;;)
+    {
+        if (void* p = std::malloc(size))
+            return p;
+        auto handler = std::get_new_handler();
+        if (!handler)
+            throw std::bad_alloc();
+        handler();
+    }
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return ::operator new(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return ::operator new(size, std::nothrow);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+#endif
+
+namespace ax
+{
+
+uint64_t FrameArena::getHeapAllocationCount()
+{
+#if AX_ENABLE_HEAP_ALLOCATION_COUNTER
+    return s_heapAllocations.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
+
+FrameArena::FrameArena(size_t blockSize) : _blockSize(blockSize) {}
+
+FrameArena::~FrameArena()
+{
+    reset();
+    releaseBlocks();
+}
+
+void* FrameArena::allocateSlow(size_t bytes, size_t alignment)
+{
+    if (_blocks)
+        ++_overflows;
+    addBlock((std::max)(_blockSize, bytes + alignment));
+    return allocate(bytes, alignment);
+}
+
+void FrameArena::addBlock(size_t size)
+{
+    if (_blocks)
+        _retiredBytes += _cursor - _begin;
+
+    auto block  = static_cast<Block*>(::operator new(sizeof(Block) + size));
+    block->next = _blocks;
+    block->size = size;
+    _blocks     = block;
+    _capacity += size;
+
+    _begin  = reinterpret_cast<uint8_t*>(block + 1);
+    _cursor = _begin;
+    _end    = _begin + size;
+}
+
+void FrameArena::releaseBlocks()
+{
+    while (_blocks)
+    {
+        auto next = _blocks->next;
+        ::operator delete(_blocks);
+        _blocks = next;
+    }
+    _begin = _cursor = _end = nullptr;
+    _capacity = _retiredBytes = 0;
+}
+
+void FrameArena::addFinalizer(void* object, void (*destroy)(void*))
+{
+    auto finalizer = static_cast<Finalizer*>(allocate(sizeof(Finalizer), alignof(Finalizer)));
+    *finalizer     = {_finalizers, object, destroy};
+    _finalizers    = finalizer;
+}
+
+void FrameArena::reset()
+{
+    // newest first, so objects die in reverse order of creation
+    while (_finalizers)
+    {
+        auto finalizer = _finalizers;
+        _finalizers    = finalizer->next;
+        finalizer->destroy(finalizer->object);
+    }
+
+    _peakBytes = (std::max)(_peakBytes, getUsedBytes());
+
+    if (_blocks && _blocks->next)
+    {
+        // this frame needed several blocks: replace them with one that fits it all
+        _blockSize = (std::max)(_blockSize, _capacity);
+        releaseBlocks();
+        addBlock(_blockSize);
+    }
+    else
+    {
+        _cursor       = _begin;
+        _retiredBytes = 0;
+    }
+}
+
+}  // namespace ax
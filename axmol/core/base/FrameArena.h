@@ -0,0 +1,193 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "platform/PlatformMacros.h"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <version>
+#if defined(__cpp_lib_memory_resource)
+#    include <memory_resource>
+#endif
+
+namespace ax
+{
+
+/**
+ * @addtogroup base
+ * @{
+ */
+
+/**
+ * @brief A linear allocator for temporaries that live no longer than a frame.
+ *
+ * Allocation bumps a pointer inside a block and nothing is freed individually; reset() rewinds the arena
+ * in one go. When a frame needs more than the current block, extra blocks are taken from the heap and
+ * merged into a single larger block on the next reset, so a steady workload stops touching the heap
+ * after a couple of frames.
+ *
+ * Director owns two arenas and swaps them at the end of every frame, see Director::getFrameArena().
+ * Memory from the frame arena therefore stays valid until the end of the next frame. Arenas are not
+ * thread safe: the Director ones belong to the main thread.
+ */
+class AX_DLL FrameArena
+{
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 256 * 1024;
+
+    explicit FrameArena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+    ~FrameArena();
+
+    FrameArena(const FrameArena&)            = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t))
+    {
+        auto p = (reinterpret_cast<uintptr_t>(_cursor) + (alignment - 1)) & ~(uintptr_t)(alignment - 1);
+        if (p + bytes <= reinterpret_cast<uintptr_t>(_end))
+        {
+            _cursor = reinterpret_cast<uint8_t*>(p + bytes);
+            return reinterpret_cast<void*>(p);
+        }
+        return allocateSlow(bytes, alignment);
+    }
+
+    /** uninitialized storage for count trivially destructible objects */
+    template <typename T>
+    T* allocateArray(size_t count)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "FrameArena never runs destructors of arrays");
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /** constructs a T in the arena; its destructor, if any, runs on the next reset */
+    template <typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+        T* object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<T>)
+            addFinalizer(object, [](void* p) { static_cast<T*>(p)->~T(); });
+        return object;
+    }
+
+    /** destroys what create() made, in reverse order, and makes all memory available again */
+    void reset();
+
+    /** bytes handed out since the last reset */
+    size_t getUsedBytes() const { return _retiredBytes + (_cursor - _begin); }
+    /** largest getUsedBytes() seen at a reset */
+    size_t getPeakBytes() const { return _peakBytes; }
+    size_t getCapacity() const { return _capacity; }
+    /** heap blocks added because a frame outgrew the arena */
+    unsigned int getOverflowCount() const { return _overflows; }
+
+    /** Number of global operator new calls so far, always 0 unless AX_ENABLE_HEAP_ALLOCATION_COUNTER is set */
+    static uint64_t getHeapAllocationCount();
+
+protected:
+    struct Block
+    {
+        Block* next;
+        size_t size;
+    };
+
+    struct Finalizer
+    {
+        Finalizer* next;
+        void* object;
+        void (*destroy)(void*);
+    };
+
+    void* allocateSlow(size_t bytes, size_t alignment);
+    void addBlock(size_t size);
+    void releaseBlocks();
+    void addFinalizer(void* object, void (*destroy)(void*));
+
+    Block* _blocks{nullptr};  ///< current block first
+    uint8_t* _begin{nullptr};
+    uint8_t* _cursor{nullptr};
+    uint8_t* _end{nullptr};
+    Finalizer* _finalizers{nullptr};
+
+    size_t _blockSize;
+    size_t _capacity{0};
+    size_t _retiredBytes{0};
+    size_t _peakBytes{0};
+    unsigned int _overflows{0};
+};
+
+/** std allocator drawing from a FrameArena; deallocation is a no-op */
+template <typename T>
+class FrameAllocator
+{
+public:
+    using value_type = T;
+
+    FrameAllocator(FrameArena* arena) noexcept : _arena(arena) {}
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U>& other) noexcept : _arena(other._arena)
+    {}
+
+    T* allocate(size_t count) { return static_cast<T*>(_arena->allocate(sizeof(T) * count, alignof(T))); }
+    void deallocate(T*, size_t) noexcept {}
+
+    template <typename U>
+    bool operator==(const FrameAllocator<U>& other) const noexcept
+    {
+        return _arena == other._arena;
+    }
+
+    FrameArena* _arena;
+};
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+#if defined(__cpp_lib_memory_resource)
+/** std::pmr adapter, for containers and libraries that take a memory_resource */
+class AX_DLL FrameArenaResource : public std::pmr::memory_resource
+{
+public:
+    explicit FrameArenaResource(FrameArena* arena) : _arena(arena) {}
+
+    FrameArena* getArena() const { return _arena; }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override { return _arena->allocate(bytes, alignment); }
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    FrameArena* _arena;
+};
+#endif
+
+// end of base group
+/** @} */
+
+}  // namespace ax
@@ -0,0 +1,297 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "base/FrameProfiler.h"
+#include "platform/FileUtils.h"
+#include "fmt/format.h"
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ax
+{
+
+namespace
+{
+struct ThreadBuffer
+{
+    uint32_t id{0};
+    std::string name;
+    bool inUse{true};
+
+    // written by the owning thread only
+    std::vector<FrameProfiler::Event> events;
+    uint64_t mask{0};
+    std::atomic<uint32_t> generation{0};
+    std::atomic<uint64_t> head{0};
+    // set while the owning thread is inside record(), stop() waits for it to clear
+    std::atomic<bool> recording{false};
+};
+
+struct Registry
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+};
+
+// Leaked on purpose: worker threads may still record while static destructors run.
+Registry& registry()
+{
+    static auto instance = new Registry();
+    return *instance;
+}
+
+// Returns the buffer to the registry when its thread exits, so short lived threads (streamed audio,
+// downloads) reuse buffers instead of growing the registry.
+struct ThreadSlot
+{
+    ThreadBuffer* buffer{nullptr};
+
+    ~ThreadSlot()
+    {
+        if (buffer)
+        {
+            auto& r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            buffer->inUse = false;
+        }
+    }
+};
+
+thread_local ThreadSlot t_slot;
+
+std::atomic<uint32_t> s_generation{0};
+std::atomic<uint32_t> s_capacity{FrameProfiler::DEFAULT_EVENTS_PER_THREAD};
+std::atomic<uint64_t> s_epoch{0};
+
+ThreadBuffer* acquireBuffer()
+{
+    auto& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto&& buffer : r.buffers)
+    {
+        if (!buffer->inUse)
+        {
+            buffer->inUse = true;
+            buffer->name.clear();
+            return buffer.get();
+        }
+    }
+    auto buffer = std::make_unique<ThreadBuffer>();
+    buffer->id  = static_cast<uint32_t>(r.buffers.size() + 1);
+    r.buffers.emplace_back(std::move(buffer));
+    return r.buffers.back().get();
+}
+
+ThreadBuffer* currentBuffer()
+{
+    if (!t_slot.buffer)
+        t_slot.buffer = acquireBuffer();
+    return t_slot.buffer;
+}
+
+void appendEscaped(std::string& out, std::string_view text)
+{
+    for (auto c : text)
+    {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        else if (static_cast<unsigned char>(c) < 0x20)
+            c = ' ';
+        out += c;
+    }
+}
+}  // namespace
+
+std::atomic<bool> FrameProfiler::_capturing{false};
+
+void FrameProfiler::start(uint32_t eventsPerThread)
+{
+    uint32_t capacity = 64;
+    while (capacity < eventsPerThread && capacity < (1u << 30))
+        capacity <<= 1;
+
+    _capturing.store(false, std::memory_order_relaxed);
+    s_capacity.store(capacity, std::memory_order_relaxed);
+    s_epoch.store(now(), std::memory_order_relaxed);
+    s_generation.fetch_add(1, std::memory_order_release);
+    _capturing.store(true, std::memory_order_release);
+}
+
+void FrameProfiler::stop()
+{
+    _capturing.store(false, std::memory_order_seq_cst);
+
+    // a thread that saw the capture running may still be resizing or writing its buffer; once every flag
+    // is clear, any later record() sees the capture stopped, so the buffers can be exported safely
+    auto& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto&& buffer : r.buffers)
+    {
+        while (buffer->recording.load(std::memory_order_acquire))
+            std::this_thread::yield();
+    }
+}
+
+void FrameProfiler::setThreadName(std::string_view name)
+{
+    auto buffer = currentBuffer();
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    buffer->name.assign(name);
+}
+
+void FrameProfiler::record(const char* name, uint64_t start, uint64_t end)
+{
+    if (!_capturing.load(std::memory_order_acquire))
+        return;
+
+    // the registry lock is only taken before the flag is set, so stop() can hold it while waiting
+    auto buffer = currentBuffer();
+    buffer->recording.store(true, std::memory_order_seq_cst);
+    if (!_capturing.load(std::memory_order_seq_cst))
+    {
+        buffer->recording.store(false, std::memory_order_release);
+        return;
+    }
+
+    auto generation = s_generation.load(std::memory_order_acquire);
+    if (buffer->generation.load(std::memory_order_relaxed) != generation)
+    {
+        // first zone of this thread in the capture
+        auto capacity = s_capacity.load(std::memory_order_relaxed);
+        if (buffer->events.size() != capacity)
+        {
+            buffer->events.resize(capacity);
+            buffer->events.shrink_to_fit();
+        }
+        buffer->mask = capacity - 1;
+        buffer->head.store(0, std::memory_order_relaxed);
+        buffer->generation.store(generation, std::memory_order_release);
+    }
+
+    auto index                          = buffer->head.load(std::memory_order_relaxed);
+    buffer->events[index & buffer->mask] = Event{name, start, end - start};
+    buffer->head.store(index + 1, std::memory_order_release);
+    buffer->recording.store(false, std::memory_order_release);
+}
+
+uint64_t FrameProfiler::getRecordedCount()
+{
+    auto& r         = registry();
+    auto generation = s_generation.load(std::memory_order_acquire);
+    uint64_t count  = 0;
+
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto&& buffer : r.buffers)
+    {
+        if (buffer->generation.load(std::memory_order_acquire) == generation)
+            count += buffer->head.load(std::memory_order_acquire);
+    }
+    return count;
+}
+
+uint64_t FrameProfiler::getDroppedCount()
+{
+    auto& r         = registry();
+    auto generation = s_generation.load(std::memory_order_acquire);
+    uint64_t count  = 0;
+
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto&& buffer : r.buffers)
+    {
+        if (buffer->generation.load(std::memory_order_acquire) != generation)
+            continue;
+        auto head = buffer->head.load(std::memory_order_acquire);
+        if (head > buffer->events.size())
+            count += head - buffer->events.size();
+    }
+    return count;
+}
+
+std::string FrameProfiler::toChromeTrace()
+{
+    // threads write their buffers without locking while a capture runs
+    if (isCapturing())
+        return "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[]}\n";
+
+    auto& r         = registry();
+    auto generation = s_generation.load(std::memory_order_acquire);
+    auto epoch      = s_epoch.load(std::memory_order_relaxed);
+
+    std::string out;
+    out.reserve(static_cast<size_t>(getRecordedCount()) * 80 + 64);
+    out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    auto separate = [&] {
+        if (!first)
+            out += ",\n";
+        first = false;
+    };
+
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto&& buffer : r.buffers)
+    {
+        if (buffer->generation.load(std::memory_order_acquire) != generation)
+            continue;
+
+        if (!buffer->name.empty())
+        {
+            separate();
+            out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,";
+            fmt::format_to(std::back_inserter(out), "\"tid\":{},\"args\":{{\"name\":\"", buffer->id);
+            appendEscaped(out, buffer->name);
+            out += "\"}}";
+        }
+
+        auto head     = buffer->head.load(std::memory_order_acquire);
+        auto capacity = static_cast<uint64_t>(buffer->events.size());
+        auto begin    = head > capacity ? head - capacity : 0;
+        for (auto i = begin; i < head; ++i)
+        {
+            auto& event = buffer->events[i & buffer->mask];
+            if (event.start < epoch)
+                continue;
+            separate();
+            out += "{\"name\":\"";
+            appendEscaped(out, event.name);
+            fmt::format_to(std::back_inserter(out), "\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":1,\"tid\":{}}}",
+                           (event.start - epoch) / 1000.0, event.duration / 1000.0, buffer->id);
+        }
+    }
+
+    out += "]}\n";
+    return out;
+}
+
+bool FrameProfiler::saveChromeTrace(std::string_view path)
+{
+    if (isCapturing())
+        return false;
+    return FileUtils::getInstance()->writeStringToFile(toChromeTrace(), path);
+}
+
+}  // namespace ax
@@ -0,0 +1,152 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Config.h"
+#include "platform/PlatformMacros.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace ax
+{
+
+/**
+ * @addtogroup base
+ * @{
+ */
+
+/**
+ * @brief A hierarchical frame profiler that records scoped zones into per-thread ring buffers.
+ *
+ * Zones are opened with AX_PROFILE_ZONE() and closed at the end of the enclosing scope. While no capture
+ * is running a zone costs one relaxed atomic load, so the instrumentation stays compiled into release
+ * builds and a trace can be taken on any machine:
+ *
+ * @code
+ * FrameProfiler::start();
+ * // ... play a few frames ...
+ * FrameProfiler::stop();
+ * FrameProfiler::saveChromeTrace(FileUtils::getInstance()->getWritablePath() + "trace.json");
+ * @endcode
+ *
+ * Each thread writes to its own ring buffer without locking; when a buffer wraps, the oldest zones of
+ * that thread are dropped. Zone names must be string literals (or otherwise outlive the capture), they
+ * are stored by pointer. The saved file loads in chrome://tracing and https://ui.perfetto.dev.
+ *
+ * Supersedes Profiler / ProfilingTimer, which only report averages and are compiled out by default.
+ */
+class AX_DLL FrameProfiler
+{
+public:
+    static constexpr uint32_t DEFAULT_EVENTS_PER_THREAD = 32 * 1024;
+
+    struct Event
+    {
+        const char* name;
+        uint64_t start;     // nanoseconds
+        uint64_t duration;  // nanoseconds
+    };
+
+    /** Starts a new capture, discarding the previous one. Capacity is rounded up to a power of two. */
+    static void start(uint32_t eventsPerThread = DEFAULT_EVENTS_PER_THREAD);
+    /**
+     * Stops recording and waits for threads that are still inside record() to leave it.
+     * The captured zones stay available for export until the next start().
+     */
+    static void stop();
+
+    static bool isCapturing() { return _capturing.load(std::memory_order_relaxed); }
+
+    /** Monotonic timestamp in nanoseconds. */
+    static uint64_t now()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch())
+                                         .count());
+    }
+
+    /** Names the calling thread in exported traces. The name is copied. */
+    static void setThreadName(std::string_view name);
+
+    /** Appends a finished zone to the calling thread's buffer. Prefer AX_PROFILE_ZONE(). */
+    static void record(const char* name, uint64_t start, uint64_t end);
+
+    /** Number of zones recorded by the current or last capture, including the ones dropped on wrap. */
+    static uint64_t getRecordedCount();
+    /** Number of zones overwritten because a thread's ring buffer was full. */
+    static uint64_t getDroppedCount();
+
+    /**
+     * Serializes the last capture in the Chrome trace event format.
+     * Only valid after stop() returned; while capturing it returns an empty trace and saveChromeTrace()
+     * fails.
+     */
+    static std::string toChromeTrace();
+    static bool saveChromeTrace(std::string_view path);
+
+private:
+    static std::atomic<bool> _capturing;
+};
+
+/** Records the enclosing scope as a zone when a capture is running. */
+class ProfileZone
+{
+public:
+    explicit ProfileZone(const char* name)
+        : _name(name), _start(FrameProfiler::isCapturing() ? FrameProfiler::now() : 0)
+    {}
+    ~ProfileZone()
+    {
+        if (_start != 0)
+            FrameProfiler::record(_name, _start, FrameProfiler::now());
+    }
+
+    ProfileZone(const ProfileZone&)            = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    const char* _name;
+    uint64_t _start;
+};
+
+// end of base group
+/** @} */
+
+}  // namespace ax
+
+#if AX_ENABLE_FRAME_PROFILER
+#    define AX_PROFILE_CONCAT_(a, b)    a##b
+#    define AX_PROFILE_CONCAT(a, b)     AX_PROFILE_CONCAT_(a, b)
+#    define AX_PROFILE_ZONE(__name__)   ax::ProfileZone AX_PROFILE_CONCAT(_axProfileZone, __COUNTER__)(__name__)
+#    define AX_PROFILE_FUNCTION()       AX_PROFILE_ZONE(__FUNCTION__)
+#    define AX_PROFILE_THREAD(__name__) ax::FrameProfiler::setThreadName(__name__)
+#else
+#    define AX_PROFILE_ZONE(__name__)
+#    define AX_PROFILE_FUNCTION()
+#    define AX_PROFILE_THREAD(__name__)
+#endif
@@ -0,0 +1,281 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "base/FrameStats.h"
+#include "base/Config.h"
+#include "base/FrameProfiler.h"
+#include "fmt/format.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace ax
+{
+
+namespace
+{
+constexpr float NS_TO_MS = 1.0f / 1000000.0f;
+
+const char* const PHASE_NAMES[] = {"other", "update", "visit", "render", "swap"};
+
+void appendSummary(std::string& out, const char* name, const FrameStats::Summary& s)
+{
+    fmt::format_to(std::back_inserter(out),
+                   "\"{}\":{{\"p50\":{:.3f},\"p95\":{:.3f},\"p99\":{:.3f},\"max\":{:.3f},\"mean\":{:.3f}}}", name,
+                   s.p50, s.p95, s.p99, s.max, s.mean);
+}
+
+void appendRow(std::string& out, const char* name, const FrameStats::Summary& s)
+{
+    fmt::format_to(std::back_inserter(out), "{:<18}{:>10.2f}{:>10.2f}{:>10.2f}{:>10.2f}{:>10.2f}\n", name, s.p50,
+                   s.p95, s.p99, s.max, s.mean);
+}
+}  // namespace
+
+FrameStats::FrameStats(size_t windowSize) : _samples(std::max<size_t>(windowSize, 1)) {}
+
+void FrameStats::beginFrame()
+{
+    auto now = FrameProfiler::now();
+
+    _current.frameTime = _frameStart != 0 ? (now - _frameStart) * NS_TO_MS : 0.0f;
+    _current.phaseTimes.fill(0.0f);
+
+    _frameStart = now;
+    _phaseStart = now;
+    _phase      = Phase::OTHER;
+}
+
+FrameStats::Phase FrameStats::switchPhase(Phase phase)
+{
+    auto now = FrameProfiler::now();
+    _current.phaseTimes[(size_t)_phase] += (now - _phaseStart) * NS_TO_MS;
+    _phaseStart = now;
+
+    auto previous = _phase;
+    _phase        = phase;
+    return previous;
+}
+
+void FrameStats::endFrame(uint32_t drawnBatches,
+                          uint32_t drawnVertices,
+                          uint32_t drawnNodes,
+                          uint32_t culledNodes,
+                          uint32_t heapAllocations,
+                          float frameBudget)
+{
+    if (_frameStart == 0)
+        return;
+
+    switchPhase(Phase::OTHER);
+
+    _current.cpuTime = 0.0f;
+    for (auto time : _current.phaseTimes)
+        _current.cpuTime += time;
+    if (_current.frameTime <= 0.0f)
+        _current.frameTime = _current.cpuTime;
+
+    _current.drawnBatches    = drawnBatches;
+    _current.drawnVertices   = drawnVertices;
+    _current.drawnNodes      = drawnNodes;
+    _current.culledNodes     = culledNodes;
+    _current.heapAllocations = heapAllocations;
+
+    _samples[_count % _samples.size()] = _current;
+    ++_count;
+
+    auto bucket = std::upper_bound(HISTOGRAM_BOUNDS.begin(), HISTOGRAM_BOUNDS.end(), _current.frameTime) -
+                  HISTOGRAM_BOUNDS.begin();
+    ++_histogram[bucket];
+    if (frameBudget > 0.0f && _current.frameTime > frameBudget * 2000.0f)
+        ++_hitches;
+}
+
+void FrameStats::reset()
+{
+    _count   = 0;
+    _hitches = 0;
+    _histogram.fill(0);
+}
+
+void FrameStats::setWindowSize(size_t windowSize)
+{
+    _samples.assign(std::max<size_t>(windowSize, 1), Sample{});
+    reset();
+}
+
+const FrameStats::Sample& FrameStats::getLastSample() const
+{
+    static const Sample empty{};
+    return _count != 0 ? _samples[(_count - 1) % _samples.size()] : empty;
+}
+
+template <typename Getter>
+FrameStats::Summary FrameStats::summarize(Getter&& getter) const
+{
+    Summary summary;
+    auto count = getSampleCount();
+    if (count == 0)
+        return summary;
+
+    std::vector<float> values(count);
+    double total = 0.0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        values[i] = getter(_samples[i]);
+        total += values[i];
+    }
+    std::sort(values.begin(), values.end());
+
+    // nearest-rank percentiles
+    auto rank = [&](float p) { return values[std::min(count - 1, (size_t)std::ceil(p * count) - 1)]; };
+    summary.p50  = rank(0.50f);
+    summary.p95  = rank(0.95f);
+    summary.p99  = rank(0.99f);
+    summary.max  = values.back();
+    summary.mean = static_cast<float>(total / count);
+    return summary;
+}
+
+FrameStats::Summary FrameStats::getFrameTimeSummary() const
+{
+    return summarize([](const Sample& s) { return s.frameTime; });
+}
+
+FrameStats::Summary FrameStats::getCpuTimeSummary() const
+{
+    return summarize([](const Sample& s) { return s.cpuTime; });
+}
+
+FrameStats::Summary FrameStats::getPhaseSummary(Phase phase) const
+{
+    return summarize([phase](const Sample& s) { return s.phaseTimes[(size_t)phase]; });
+}
+
+FrameStats::Summary FrameStats::getDrawnBatchesSummary() const
+{
+    return summarize([](const Sample& s) { return (float)s.drawnBatches; });
+}
+
+FrameStats::Summary FrameStats::getDrawnVerticesSummary() const
+{
+    return summarize([](const Sample& s) { return (float)s.drawnVertices; });
+}
+
+FrameStats::Summary FrameStats::getDrawnNodesSummary() const
+{
+    return summarize([](const Sample& s) { return (float)s.drawnNodes; });
+}
+
+FrameStats::Summary FrameStats::getCulledNodesSummary() const
+{
+    return summarize([](const Sample& s) { return (float)s.culledNodes; });
+}
+
+FrameStats::Summary FrameStats::getHeapAllocationsSummary() const
+{
+    return summarize([](const Sample& s) { return (float)s.heapAllocations; });
+}
+
+const char* FrameStats::getPhaseName(Phase phase)
+{
+    return phase < Phase::COUNT ? PHASE_NAMES[(size_t)phase] : "";
+}
+
+std::string FrameStats::toJson() const
+{
+    std::string out;
+    out.reserve(2048);
+    fmt::format_to(std::back_inserter(out), "{{\"frames\":{},\"window\":{},\"heapAllocationCounter\":{},", _count,
+                   getSampleCount(), AX_ENABLE_HEAP_ALLOCATION_COUNTER ? "true" : "false");
+
+    appendSummary(out, "frameTimeMs", getFrameTimeSummary());
+    out += ',';
+    appendSummary(out, "cpuTimeMs", getCpuTimeSummary());
+
+    out += ",\"phasesMs\":{";
+    for (size_t i = 0; i < (size_t)Phase::COUNT; ++i)
+    {
+        if (i != 0)
+            out += ',';
+        appendSummary(out, PHASE_NAMES[i], getPhaseSummary((Phase)i));
+    }
+    out += "},";
+
+    appendSummary(out, "drawnBatches", getDrawnBatchesSummary());
+    out += ',';
+    appendSummary(out, "drawnVertices", getDrawnVerticesSummary());
+    out += ',';
+    appendSummary(out, "drawnNodes", getDrawnNodesSummary());
+    out += ',';
+    appendSummary(out, "culledNodes", getCulledNodesSummary());
+    out += ',';
+    appendSummary(out, "heapAllocations", getHeapAllocationsSummary());
+
+    fmt::format_to(std::back_inserter(out), ",\"hitches\":{},\"histogram\":[", _hitches);
+    for (size_t i = 0; i < _histogram.size(); ++i)
+    {
+        if (i != 0)
+            out += ',';
+        if (i < HISTOGRAM_BOUNDS.size())
+            fmt::format_to(std::back_inserter(out), "{{\"upToMs\":{:.3f},\"frames\":{}}}", HISTOGRAM_BOUNDS[i],
+                           _histogram[i]);
+        else
+            fmt::format_to(std::back_inserter(out), "{{\"upToMs\":null,\"frames\":{}}}", _histogram[i]);
+    }
+    out += "]}\n";
+    return out;
+}
+
+std::string FrameStats::toString() const
+{
+    std::string out;
+    out.reserve(2048);
+    fmt::format_to(std::back_inserter(out), "frames: {}, window: {}, hitches: {}\n", _count, getSampleCount(),
+                   _hitches);
+    fmt::format_to(std::back_inserter(out), "{:<18}{:>10}{:>10}{:>10}{:>10}{:>10}\n", "", "p50", "p95", "p99", "max",
+                   "mean");
+    appendRow(out, "frame (ms)", getFrameTimeSummary());
+    appendRow(out, "cpu (ms)", getCpuTimeSummary());
+    for (size_t i = 0; i < (size_t)Phase::COUNT; ++i)
+        appendRow(out, fmt::format("  {} (ms)", PHASE_NAMES[i]).c_str(), getPhaseSummary((Phase)i));
+    appendRow(out, "batches", getDrawnBatchesSummary());
+    appendRow(out, "vertices", getDrawnVerticesSummary());
+    appendRow(out, "drawn nodes", getDrawnNodesSummary());
+    appendRow(out, "culled nodes", getCulledNodesSummary());
+    appendRow(out, "heap allocations", getHeapAllocationsSummary());
+
+    out += "histogram:";
+    for (size_t i = 0; i < _histogram.size(); ++i)
+    {
+        if (i < HISTOGRAM_BOUNDS.size())
+            fmt::format_to(std::back_inserter(out), " <{:.1f}ms:{}", HISTOGRAM_BOUNDS[i], _histogram[i]);
+        else
+            fmt::format_to(std::back_inserter(out), " more:{}", _histogram[i]);
+    }
+    out += '\n';
+    return out;
+}
+
+}  // namespace ax
@@ -0,0 +1,176 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "platform/PlatformMacros.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ax
+{
+
+/**
+ * @addtogroup base
+ * @{
+ */
+
+/**
+ * @brief Rolling frame timing statistics collected by the Director.
+ *
+ * Every frame records its wall time (from the start of the previous frame), the CPU time spent in each
+ * phase of Director::mainLoop, the draw batches and vertices, the nodes drawn and culled by frustum culling
+ * and the heap allocation count. Percentiles
+ * are computed over the last getWindowSize() frames; the hitch histogram counts every frame since the
+ * last reset(). Collection costs a handful of clock reads per frame and is always on.
+ *
+ * The numbers are meant to be compared across builds: use toJson() (or the 'framestats dump' Console
+ * command) rather than the on-screen stats.
+ */
+class AX_DLL FrameStats
+{
+public:
+    static constexpr size_t DEFAULT_WINDOW_SIZE = 600;
+
+    /** Phases of a frame. Time is charged to exactly one phase, nested scopes are exclusive. */
+    enum class Phase
+    {
+        OTHER,
+        UPDATE,
+        VISIT,
+        RENDER,
+        SWAP,
+        COUNT
+    };
+
+    struct Sample
+    {
+        float frameTime;  // milliseconds between the start of this frame and the previous one
+        float cpuTime;    // milliseconds spent inside the frame
+        std::array<float, (size_t)Phase::COUNT> phaseTimes;
+        uint32_t drawnBatches;
+        uint32_t drawnVertices;
+        uint32_t drawnNodes;
+        uint32_t culledNodes;
+        uint32_t heapAllocations;
+    };
+
+    struct Summary
+    {
+        float p50  = 0.0f;
+        float p95  = 0.0f;
+        float p99  = 0.0f;
+        float max  = 0.0f;
+        float mean = 0.0f;
+    };
+
+    /** Upper bounds of the hitch histogram buckets in milliseconds, the last bucket is open. */
+    static constexpr std::array<float, 6> HISTOGRAM_BOUNDS = {8.334f, 16.667f, 33.334f, 50.0f, 100.0f, 250.0f};
+
+    /** Charges the time of its scope to a phase and restores the previous phase on exit. */
+    class PhaseScope
+    {
+    public:
+        PhaseScope(FrameStats* stats, Phase phase) : _stats(stats), _previous(stats->switchPhase(phase)) {}
+        ~PhaseScope() { _stats->switchPhase(_previous); }
+
+        PhaseScope(const PhaseScope&)            = delete;
+        PhaseScope& operator=(const PhaseScope&) = delete;
+
+    private:
+        FrameStats* _stats;
+        Phase _previous;
+    };
+
+    explicit FrameStats(size_t windowSize = DEFAULT_WINDOW_SIZE);
+
+    void beginFrame();
+    /** The next frame is measured from its own start, e.g. after resuming from background. */
+    void skipFrameInterval() { _frameStart = 0; }
+    /**
+     * @param frameBudget seconds per frame the game targets, frames longer than twice the budget are hitches.
+     */
+    void endFrame(uint32_t drawnBatches,
+                  uint32_t drawnVertices,
+                  uint32_t drawnNodes,
+                  uint32_t culledNodes,
+                  uint32_t heapAllocations,
+                  float frameBudget);
+
+    /** Makes phase the current one and returns the phase that was current. */
+    Phase switchPhase(Phase phase);
+
+    /** Discards the window and the histogram. */
+    void reset();
+
+    size_t getWindowSize() const { return _samples.size(); }
+    /** Resizes the percentile window, which also resets the stats. */
+    void setWindowSize(size_t windowSize);
+    /** Number of frames in the window. */
+    size_t getSampleCount() const { return _count < _samples.size() ? (size_t)_count : _samples.size(); }
+    /** Number of frames since the last reset. */
+    uint64_t getFrameCount() const { return _count; }
+    uint64_t getHitchCount() const { return _hitches; }
+    const std::array<uint64_t, HISTOGRAM_BOUNDS.size() + 1>& getHistogram() const { return _histogram; }
+
+    /** The most recent complete frame. */
+    const Sample& getLastSample() const;
+
+    Summary getFrameTimeSummary() const;
+    Summary getCpuTimeSummary() const;
+    Summary getPhaseSummary(Phase phase) const;
+    Summary getDrawnBatchesSummary() const;
+    Summary getDrawnVerticesSummary() const;
+    Summary getDrawnNodesSummary() const;
+    Summary getCulledNodesSummary() const;
+    Summary getHeapAllocationsSummary() const;
+
+    static const char* getPhaseName(Phase phase);
+
+    std::string toJson() const;
+    /** Human readable table, one metric per line. */
+    std::string toString() const;
+
+private:
+    template <typename Getter>
+    Summary summarize(Getter&& getter) const;
+
+    std::vector<Sample> _samples;
+    uint64_t _count = 0;
+
+    Sample _current{};
+    uint64_t _frameStart  = 0;
+    uint64_t _phaseStart  = 0;
+    Phase _phase          = Phase::OTHER;
+
+    std::array<uint64_t, HISTOGRAM_BOUNDS.size() + 1> _histogram{};
+    uint64_t _hitches = 0;
+};
+
+// end of base group
+/** @} */
+
+}  // namespace ax
@@ -0,0 +1,162 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ax
+{
+
+/**
+ * @addtogroup base
+ * @{
+ */
+
+template <typename Signature, size_t Capacity>
+class InlineFunction;
+
+/**
+ * @brief A move-only std::function replacement that never allocates.
+ *
+ * The callable is stored in Capacity bytes inside the object itself; assigning one that does not fit is
+ * a compile error rather than a silent heap allocation. Use fits<F> to pick another storage for large
+ * callables, as CallbackCommand does with the frame arena.
+ */
+template <typename R, typename... Args, size_t Capacity>
+class InlineFunction<R(Args...), Capacity>
+{
+public:
+    template <typename F>
+    static constexpr bool fits = sizeof(F) <= Capacity && alignof(F) <= alignof(std::max_align_t) &&
+                                 std::is_nothrow_move_constructible_v<F>;
+
+    InlineFunction() noexcept = default;
+    InlineFunction(std::nullptr_t) noexcept {}
+
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, InlineFunction>>>
+    InlineFunction(F&& f)
+    {
+        emplace(std::forward<F>(f));
+    }
+
+    InlineFunction(InlineFunction&& other) noexcept { moveFrom(other); }
+
+    InlineFunction& operator=(InlineFunction&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    InlineFunction& operator=(std::nullptr_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, InlineFunction>>>
+    InlineFunction& operator=(F&& f)
+    {
+        reset();
+        emplace(std::forward<F>(f));
+        return *this;
+    }
+
+    InlineFunction(const InlineFunction&)            = delete;
+    InlineFunction& operator=(const InlineFunction&) = delete;
+
+    ~InlineFunction() { reset(); }
+
+    explicit operator bool() const noexcept { return _invoke != nullptr; }
+
+    R operator()(Args... args) { return _invoke(_storage, std::forward<Args>(args)...); }
+
+    void reset() noexcept
+    {
+        if (_manage)
+            _manage(_storage, nullptr);
+        _invoke = nullptr;
+        _manage = nullptr;
+    }
+
+private:
+    template <typename F>
+    void emplace(F&& f)
+    {
+        using T = std::decay_t<F>;
+        static_assert(fits<T>, "callable does not fit into this InlineFunction, capture less or by pointer");
+
+        // keep "empty" meaning empty for null function pointers and std::function
+        if constexpr (std::is_constructible_v<bool, const T&>)
+        {
+            if (!static_cast<bool>(f))
+                return;
+        }
+
+        new (_storage) T(std::forward<F>(f));
+        _invoke = [](void* storage, Args&&... args) -> R {
+            return (*static_cast<T*>(storage))(std::forward<Args>(args)...);
+        };
+        if constexpr (!std::is_trivially_copyable_v<T>)
+        {
+            // moves into `to` when given one, destroys either way
+            _manage = [](void* from, void* to) {
+                if (to)
+                    new (to) T(std::move(*static_cast<T*>(from)));
+                static_cast<T*>(from)->~T();
+            };
+        }
+    }
+
+    void moveFrom(InlineFunction& other) noexcept
+    {
+        if (!other._invoke)
+            return;
+        if (other._manage)
+            other._manage(other._storage, _storage);
+        else
+            std::memcpy(_storage, other._storage, Capacity);
+        _invoke       = other._invoke;
+        _manage       = other._manage;
+        other._invoke = nullptr;
+        other._manage = nullptr;
+    }
+
+    alignas(std::max_align_t) unsigned char _storage[Capacity];
+    R (*_invoke)(void*, Args&&...) = nullptr;
+    void (*_manage)(void* from, void* to) = nullptr;
+};
+
+// end of base group
+/** @} */
+
+}  // namespace ax
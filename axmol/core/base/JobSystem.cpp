@@ -25,6 +25,7 @@
 
 #include "base/JobSystem.h"
 #include "base/Director.h"
+#include "base/FrameProfiler.h"
 #include "yasio/thread_name.hpp"
 
 #include <queue>
@@ -34,6 +35,7 @@
 #include <future>
 #include <functional>
 #include <stdexcept>
+#include <atomic>
 
 #if defined(__EMSCRIPTEN__)
 #    include <emscripten/emscripten.h>
@@ -52,6 +54,7 @@ public:
             workers.emplace_back([this, thread_data] {
                 thread_data->init();
                 yasio::set_thread_name(thread_data->name());
+                AX_PROFILE_THREAD(thread_data->name());
                 for (;;)
                 {
                     std::function<void(JobThreadData*)> task;
@@ -118,6 +121,8 @@ public:
             worker.join();
     }
 
+    size_t size() const { return workers.size(); }
+
 private:
     // need to keep track of threads so we can join them
     std::vector<std::thread> workers;
@@ -227,6 +232,61 @@ void JobSystem::enqueue(std::shared_ptr<JobThreadTask> task)
         taskw(_mainThreadData);
 }
 
+size_t JobSystem::getThreadCount() const
+{
+    return _executor ? _executor->size() : 0;
+}
+
+void JobSystem::parallelFor(size_t count, size_t grain, const std::function<void(size_t begin, size_t end)>& body)
+{
+    if (count == 0)
+        return;
+    grain         = (std::max)(grain, size_t{1});
+    size_t ranges = (count + grain - 1) / grain;
+    size_t helpers = (std::min)(ranges - 1, getThreadCount());
+    if (helpers == 0)
+    {
+        body(0, count);
+        return;
+    }
+
+    // Shared with the helpers: one that only starts after we returned finds no range left and
+    // leaves without touching body.
+    struct Progress
+    {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> finished{0};
+        size_t ranges;
+        size_t count;
+        size_t grain;
+        const std::function<void(size_t, size_t)>* body;
+    };
+    auto progress    = std::make_shared<Progress>();
+    progress->ranges = ranges;
+    progress->count  = count;
+    progress->grain  = grain;
+    progress->body   = &body;
+
+    auto drain = [progress](JobThreadData*) {
+        for (;;)
+        {
+            size_t index = progress->next.fetch_add(1, std::memory_order_relaxed);
+            if (index >= progress->ranges)
+                return;
+            size_t begin = index * progress->grain;
+            (*progress->body)(begin, (std::min)(begin + progress->grain, progress->count));
+            progress->finished.fetch_add(1, std::memory_order_release);
+        }
+    };
+
+    for (size_t i = 0; i < helpers; ++i)
+        _executor->enqueue_v(drain);
+
+    drain(_mainThreadData);
+    while (progress->finished.load(std::memory_order_acquire) < ranges)
+        std::this_thread::yield();
+}
+
 void JobSystem::enqueue(std::function<void()> task, std::function<void()> done)
 {
     if (!task)
@@ -39,6 +39,7 @@ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
 #include <memory>
 #include <string>
 #include <span>
+#include <functional>
 #include "base/Config.h"
 #include "platform/PlatformDefine.h"
 
@@ -102,6 +103,16 @@ public:
     void enqueue(std::function<void()> task, std::function<void()> done);
     void enqueue(std::shared_ptr<JobThreadTask> task);
 
+    /**
+     * Run body(begin, end) over [0, count) in ranges of at most grain items on the workers and the calling
+     * thread, returning once every range is done. Ranges no worker picked up are run by the caller, so a
+     * busy pool costs parallelism but never stalls the call. body must be safe to run concurrently.
+     */
+    void parallelFor(size_t count, size_t grain, const std::function<void(size_t begin, size_t end)>& body);
+
+    /** number of worker threads, 0 when jobs run inline */
+    size_t getThreadCount() const;
+
  protected:
     void init(const std::span<std::shared_ptr<JobThreadData>>& tdds);
 
@@ -50,6 +50,8 @@ class ProfilingTimer;
  axmol builtin profiler.
 
  To use it, enable set the AX_ENABLE_PROFILERS=1 in the Config.h file
+
+ @deprecated Use FrameProfiler and AX_PROFILE_ZONE(), which record per-thread zones and export Chrome traces.
  */
 
 class AX_DLL Profiler
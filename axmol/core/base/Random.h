@@ -65,6 +65,9 @@ public:
         return dist(mt);
     }
 
+    /** Reseeds the generator behind random_real and random_int, for deterministic replays and benchmarks. */
+    static void seed(uint32_t value) { getEngine().seed(value); }
+
 private:
     static std::mt19937& getEngine();
 };
@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include "base/Scheduler.h"
 #include "base/Macros.h"
 #include "base/Director.h"
+#include "base/FrameProfiler.h"
 #include "base/ScriptSupport.h"
 
 namespace ax
@@ -47,6 +48,10 @@ Timer::Timer()
     , _delay(0.0f)
     , _interval(0.0f)
     , _aborted(false)
+    , _deadline(0.0)
+    , _listIndex(0)
+    , _wheelSlot(0)
+    , _state(State::IDLE)
 {}
 
 void Timer::setupTimerWithInterval(float seconds, unsigned int repeat, float delay)
@@ -181,6 +186,168 @@ void TimerTargetCallback::cancel()
     _scheduler->unschedule(_key, _target);
 }
 
+// TimerWheel
+
+TimerWheel::TimerWheel() : _slots(INNER_SLOTS + OUTER_WHEELS * OUTER_SLOTS), _tick(0), _size(0) {}
+
+uint64_t TimerWheel::toTick(double time)
+{
+    return time > 0.0 ? static_cast<uint64_t>(time * TICKS_PER_SECOND) : 0;
+}
+
+void TimerWheel::insert(Timer* timer)
+{
+    place(timer, toTick(timer->_deadline));
+    timer->_state = Timer::State::WHEEL;
+    ++_size;
+}
+
+void TimerWheel::remove(Timer* timer)
+{
+    unlink(timer);
+    timer->_state = Timer::State::IDLE;
+    --_size;
+}
+
+void TimerWheel::place(Timer* timer, uint64_t expiry)
+{
+    // overdue timers go to the current slot, the next advance picks them up
+    if (expiry < _tick)
+        expiry = _tick;
+
+    auto delta = expiry - _tick;
+    int slot;
+    if (delta < INNER_SLOTS)
+    {
+        slot = static_cast<int>(expiry & (INNER_SLOTS - 1));
+    }
+    else
+    {
+        // beyond the outermost wheel: park in its farthest slot, re-placed when that slot cascades
+        if (delta >= MAX_SPAN)
+        {
+            delta  = MAX_SPAN - 1;
+            expiry = _tick + delta;
+        }
+
+        int wheel = 0;
+        int shift = INNER_BITS;
+        while (delta >= (uint64_t{1} << (shift + OUTER_BITS)))
+        {
+            ++wheel;
+            shift += OUTER_BITS;
+        }
+        slot = INNER_SLOTS + wheel * OUTER_SLOTS + static_cast<int>((expiry >> shift) & (OUTER_SLOTS - 1));
+    }
+
+    auto& bucket      = _slots[slot];
+    timer->_wheelSlot = static_cast<uint16_t>(slot);
+    timer->_listIndex = static_cast<uint32_t>(bucket.size());
+    bucket.emplace_back(timer);
+}
+
+void TimerWheel::unlink(Timer* timer)
+{
+    auto& bucket = _slots[timer->_wheelSlot];
+    auto last    = bucket.back();
+    if (last != timer)
+    {
+        bucket[timer->_listIndex] = last;
+        last->_listIndex          = timer->_listIndex;
+    }
+    bucket.pop_back();
+}
+
+void TimerWheel::cascade(int wheel)
+{
+    const int shift = INNER_BITS + wheel * OUTER_BITS;
+    auto& bucket    = _slots[INNER_SLOTS + wheel * OUTER_SLOTS + ((_tick >> shift) & (OUTER_SLOTS - 1))];
+    if (bucket.empty())
+        return;
+
+    // every timer of this slot now expires within the span of the inner wheels
+    axstd::pod_vector<Timer*> timers;
+    timers.swap(bucket);
+    for (auto timer : timers)
+        place(timer, toTick(timer->_deadline));
+
+    // hand the storage back so the slot doesn't reallocate on its next use
+    if (bucket.empty())
+    {
+        timers.clear();
+        bucket.swap(timers);
+    }
+}
+
+void TimerWheel::rebuild(uint64_t tick)
+{
+    axstd::pod_vector<Timer*> timers;
+    timers.reserve(_size);
+    for (auto& bucket : _slots)
+    {
+        for (auto timer : bucket)
+            timers.emplace_back(timer);
+        bucket.clear();
+    }
+
+    _tick = tick;
+    for (auto timer : timers)
+        place(timer, toTick(timer->_deadline));
+}
+
+void TimerWheel::advance(double now, axstd::pod_vector<Timer*>& due)
+{
+    const auto target = toTick(now);
+
+    // after a long stall, re-bucketing once is cheaper than walking every elapsed tick
+    if (target > _tick && target - _tick > uint64_t{INNER_SLOTS} * OUTER_SLOTS)
+        rebuild(target);
+
+    // slots of fully elapsed ticks expire as a whole
+    while (_tick < target)
+    {
+        auto& bucket = _slots[_tick & (INNER_SLOTS - 1)];
+        for (auto timer : bucket)
+        {
+            timer->_state = Timer::State::DUE;
+            timer->retain();
+            due.emplace_back(timer);
+        }
+        _size -= bucket.size();
+        bucket.clear();
+
+        ++_tick;
+        if ((_tick & (INNER_SLOTS - 1)) == 0)
+        {
+            for (int wheel = 0; wheel < OUTER_WHEELS; ++wheel)
+            {
+                cascade(wheel);
+                if (((_tick >> (INNER_BITS + wheel * OUTER_BITS)) & (OUTER_SLOTS - 1)) != 0)
+                    break;
+            }
+        }
+    }
+
+    // the current tick is only partially elapsed
+    auto& bucket = _slots[_tick & (INNER_SLOTS - 1)];
+    for (size_t i = 0; i < bucket.size();)
+    {
+        auto timer = bucket[i];
+        if (timer->_deadline <= now)
+        {
+            unlink(timer);
+            --_size;
+            timer->_state = Timer::State::DUE;
+            timer->retain();
+            due.emplace_back(timer);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
 #if AX_ENABLE_SCRIPT_BINDING
 
 // TimerScriptHandler
@@ -218,8 +385,8 @@ const int Scheduler::PRIORITY_NON_SYSTEM_MIN = PRIORITY_SYSTEM + 1;
 
 Scheduler::Scheduler()
     : _timeScale(1.0f)
-    , _currentTarget(nullptr)
-    , _currentTargetSalvaged(false)
+    , _timerClock(0.0)
+    , _perFrameHoles(0)
     , _indexMapLocked(false)
 #if AX_ENABLE_SCRIPT_BINDING
     , _scriptHandlerEntries(20)
@@ -274,15 +441,17 @@ void Scheduler::schedule(const ccSchedulerFunc& callback,
     }
     else
     {
-        auto timerIt = std::find_if(timers.begin(), timers.end(), [&key](Timer* const itimer) {
+        auto existing = std::find_if(timers.begin(), timers.end(), [&key](Timer* const itimer) {
             TimerTargetCallback* timer = dynamic_cast<TimerTargetCallback*>(itimer);
             return timer && !timer->isExhausted() && key == timer->getKey();
         });
-        if (timerIt != timers.end())
+        if (existing != timers.end())
         {
             AXLOGD("Scheduler#schedule. Reiniting timer with interval {:.4f}, repeat {}, delay {:.4f}", interval, repeat,
                   delay);
-            (*timerIt)->setupTimerWithInterval(interval, repeat, delay);
+            (*existing)->setupTimerWithInterval(interval, repeat, delay);
+            unlinkTimer(*existing);
+            enqueueTimer(*existing, timerIt->second.paused);
             return;
         }
     }
@@ -291,6 +460,8 @@ void Scheduler::schedule(const ccSchedulerFunc& callback,
     timer->initWithCallback(this, callback, target, key, interval, repeat, delay);
     timers.pushBack(timer);
     timer->release();
+    // the target's state wins over the argument, which only the first timer of a target sets
+    enqueueTimer(timer, timerIt->second.paused);
 }
 
 void Scheduler::unschedule(std::string_view key, void* target)
@@ -311,30 +482,12 @@ void Scheduler::unschedule(std::string_view key, void* target)
 
             if (timer && key == timer->getKey())
             {
-                if (timer == timerHandle.currentTimer && (!timer->isAborted()))
-                {
-                    timer->retain();
-                    timer->setAborted();
-                }
-
+                detachTimer(timer);
                 timerHandle.timers.erase(i);
 
-                // update timerIndex in case we are in tick:, looping over the actions
-                if (timerHandle.timerIndex >= i)
-                {
-                    timerHandle.timerIndex--;
-                }
-
                 if (timerHandle.timers.empty())
                 {
-                    if (_currentTarget == &timerHandle)
-                    {
-                        _currentTargetSalvaged = true;
-                    }
-                    else
-                    {
-                        _timersMap.erase(timerIt);
-                    }
+                    _timersMap.erase(timerIt);
                 }
 
                 return;
@@ -343,6 +496,192 @@ void Scheduler::unschedule(std::string_view key, void* target)
     }
 }
 
+void Scheduler::enqueueTimer(Timer* timer, bool paused)
+{
+    if (paused)
+    {
+        // still unarmed (_elapsed == -1), unparkTimer queues it again on resume
+        timer->_state = Timer::State::PARKED;
+        return;
+    }
+
+    timer->_state     = Timer::State::PENDING;
+    timer->_listIndex = static_cast<uint32_t>(_pendingTimers.size());
+    _pendingTimers.emplace_back(timer);
+}
+
+void Scheduler::unlinkTimer(Timer* timer)
+{
+    switch (timer->_state)
+    {
+    case Timer::State::PENDING:
+        _pendingTimers[timer->_listIndex] = nullptr;
+        break;
+    case Timer::State::WHEEL:
+        _timerWheel.remove(timer);
+        break;
+    case Timer::State::PER_FRAME:
+        _perFrameTimers[timer->_listIndex] = nullptr;
+        ++_perFrameHoles;
+        break;
+    default:
+        // DUE and FIRING timers are held by the update loop, which checks the state before touching them
+        break;
+    }
+    timer->_state = Timer::State::IDLE;
+}
+
+void Scheduler::detachTimer(Timer* timer)
+{
+    unlinkTimer(timer);
+    timer->setAborted();
+}
+
+void Scheduler::parkTimer(Timer* timer)
+{
+    switch (timer->_state)
+    {
+    case Timer::State::WHEEL:
+        _timerWheel.remove(timer);
+        timer->_deadline -= _timerClock;
+        break;
+    case Timer::State::DUE:
+    case Timer::State::FIRING:
+        timer->_deadline -= _timerClock;
+        break;
+    case Timer::State::PENDING:
+    case Timer::State::PER_FRAME:
+        unlinkTimer(timer);
+        break;
+    default:
+        return;
+    }
+    timer->_state = Timer::State::PARKED;
+}
+
+void Scheduler::unparkTimer(Timer* timer)
+{
+    if (timer->_state != Timer::State::PARKED)
+        return;
+
+    if (timer->_elapsed == -1)
+    {
+        enqueueTimer(timer, false);
+    }
+    else if (timer->_interval > 0 || timer->_useDelay)
+    {
+        timer->_deadline += _timerClock;
+        _timerWheel.insert(timer);
+    }
+    else
+    {
+        addPerFrameTimer(timer);
+    }
+}
+
+void Scheduler::addPerFrameTimer(Timer* timer)
+{
+    timer->_state     = Timer::State::PER_FRAME;
+    timer->_listIndex = static_cast<uint32_t>(_perFrameTimers.size());
+    _perFrameTimers.emplace_back(timer);
+}
+
+void Scheduler::armPendingTimers()
+{
+    // arming is the timer's first update: the current frame's dt doesn't count towards it
+    for (auto timer : _pendingTimers)
+    {
+        if (!timer)
+            continue;
+
+        if (timer->_interval > 0 || timer->_useDelay)
+        {
+            timer->_elapsed  = 0;
+            timer->_deadline = _timerClock + (timer->_useDelay ? timer->_delay : timer->_interval);
+            _timerWheel.insert(timer);
+        }
+        else
+        {
+            // Timer::update arms it during this frame's per-frame pass
+            timer->_elapsed = -1;
+            addPerFrameTimer(timer);
+        }
+    }
+    _pendingTimers.clear();
+}
+
+void Scheduler::fireTimer(Timer* timer)
+{
+    timer->_state = Timer::State::FIRING;
+    do
+    {
+        const float dt   = timer->_useDelay ? timer->_delay : timer->_interval;
+        timer->_useDelay = false;
+        timer->_deadline += timer->_interval;
+
+        timer->_timesExecuted += 1;  // important to increment before call trigger
+        timer->trigger(dt);
+
+        // a last callback that paused the target still ends the timer, as Timer::update does; a
+        // rescheduled timer starts over and is not exhausted
+        const bool active = timer->_state == Timer::State::FIRING || timer->_state == Timer::State::PARKED;
+        if (active && timer->isExhausted())
+        {
+            timer->cancel();
+            if (timer->_state == Timer::State::FIRING)
+                timer->_state = Timer::State::IDLE;
+            return;
+        }
+
+        // unscheduled, paused or rescheduled from its own callback
+        if (timer->_state != Timer::State::FIRING)
+            return;
+    } while (timer->_interval > 0 && timer->_deadline <= _timerClock);
+
+    if (timer->_interval > 0)
+    {
+        _timerWheel.insert(timer);
+        return;
+    }
+
+    // the delay of an interval 0 timer elapsed: like Timer::update, the time left over triggers
+    // right away, then it ticks every frame from the next one on
+    addPerFrameTimer(timer);
+    timer->_elapsed = static_cast<float>(_timerClock - timer->_deadline);
+    timer->update(0);
+}
+
+void Scheduler::updatePerFrameTimers(float dt)
+{
+    // entries appended by a callback of this pass (a resumed target) are updated this frame too
+    for (size_t i = 0; i < _perFrameTimers.size(); ++i)
+    {
+        auto timer = _perFrameTimers[i];
+        if (!timer)
+            continue;
+
+        // the callback may unschedule the timer, keep it alive until update returns
+        timer->retain();
+        timer->update(dt);
+        timer->release();
+    }
+
+    if (_perFrameHoles != 0)
+    {
+        size_t count = 0;
+        for (size_t i = 0; i < _perFrameTimers.size(); ++i)
+        {
+            if (auto timer = _perFrameTimers[i])
+            {
+                timer->_listIndex        = static_cast<uint32_t>(count);
+                _perFrameTimers[count++] = timer;
+            }
+        }
+        _perFrameTimers.resize(count);
+        _perFrameHoles = 0;
+    }
+}
+
 void Scheduler::priorityIn(axstd::pod_vector<SchedHandle*>& list,
                            const ccSchedulerFunc& callback,
                            void* target,
@@ -563,22 +902,13 @@ void Scheduler::unscheduleAllForTarget(std::unordered_map<void*, TimerHandle>::i
 {
     auto const target = timerIt->first;
     auto& timerHandle = timerIt->second;
-    if (timerHandle.timers.contains(timerHandle.currentTimer) && (!timerHandle.currentTimer->isAborted()))
+    for (auto timer : timerHandle.timers)
     {
-        timerHandle.currentTimer->retain();
-        timerHandle.currentTimer->setAborted();
+        detachTimer(timer);
     }
     timerHandle.timers.clear();
 
-    if (_currentTarget == &timerHandle)
-    {
-        _currentTargetSalvaged = true;
-        ++timerIt;
-    }
-    else
-    {
-        timerIt = _timersMap.erase(timerIt);
-    }
+    timerIt = _timersMap.erase(timerIt);
 
     unscheduleUpdate(target);
 }
@@ -612,9 +942,13 @@ void Scheduler::resumeTarget(void* target)
 
     // custom selectors
     auto timerIt = _timersMap.find(target);
-    if (timerIt != _timersMap.end())
+    if (timerIt != _timersMap.end() && timerIt->second.paused)
     {
         timerIt->second.paused = false;
+        for (auto timer : timerIt->second.timers)
+        {
+            unparkTimer(timer);
+        }
     }
 
     // update selector
@@ -631,9 +965,13 @@ void Scheduler::pauseTarget(void* target)
 
     // custom selectors
     auto timerIt = _timersMap.find(target);
-    if (timerIt != _timersMap.end())
+    if (timerIt != _timersMap.end() && !timerIt->second.paused)
     {
         timerIt->second.paused = true;
+        for (auto timer : timerIt->second.timers)
+        {
+            parkTimer(timer);
+        }
     }
 
     // update selector
@@ -677,7 +1015,14 @@ std::set<void*> Scheduler::pauseAllTargetsWithMinPriority(int minPriority)
     // Custom Selectors
     for (auto& [target, timerHandle] : _timersMap)
     {
-        timerHandle.paused = true;
+        if (!timerHandle.paused)
+        {
+            timerHandle.paused = true;
+            for (auto timer : timerHandle.timers)
+            {
+                parkTimer(timer);
+            }
+        }
         idsWithSelectors.insert(target);
     }
 
@@ -738,6 +1083,8 @@ void Scheduler::removeAllPendingActions()
 // main loop
 void Scheduler::update(float dt)
 {
+    AX_PROFILE_ZONE("Scheduler::update");
+
     // active waitlist
     if (!_waitList.empty())
         activeWaitList();
@@ -781,43 +1128,22 @@ void Scheduler::update(float dt)
         }
     }
 
-    // Iterate over all the custom selectors
-    for (auto it = _timersMap.begin(); it != _timersMap.end();)
-    {
-        auto elt               = &it->second;
-        _currentTarget         = elt;
-        _currentTargetSalvaged = false;
-
-        if (!_currentTarget->paused)
-        {
-            // The 'timers' array may change while inside this loop
-            for (elt->timerIndex = 0; elt->timerIndex < elt->timers.size(); ++(elt->timerIndex))
-            {
-                elt->currentTimer = elt->timers[elt->timerIndex];
-                AXASSERT(!elt->currentTimer->isAborted(), "An aborted timer should not be updated");
-
-                elt->currentTimer->update(dt);
-
-                if (elt->currentTimer->isAborted())
-                {
-                    // The currentTimer told the remove itself. To prevent the timer from
-                    // accidentally deallocating itself before finishing its step, we retained
-                    // it. Now that step is done, it's safe to release it.
-                    elt->currentTimer->release();
-                }
-
-                elt->currentTimer = nullptr;
-            }
-        }
+    // Custom selectors: only the timers whose deadline passed are visited
+    _timerClock += dt;
+    armPendingTimers();
+    updatePerFrameTimers(dt);
 
-        // only delete currentTarget if no actions were scheduled during the cycle (issue #481)
-        if (_currentTargetSalvaged && _currentTarget->timers.empty())
+    _timerWheel.advance(_timerClock, _dueTimers);
+    for (auto timer : _dueTimers)
+    {
+        // skip timers unscheduled, paused or rescheduled by an earlier callback of this frame
+        if (timer->_state == Timer::State::DUE)
         {
-            it = _timersMap.erase(it);
+            fireTimer(timer);
         }
-        else
-            ++it;
+        timer->release();
     }
+    _dueTimers.clear();
 
     // delete all updates that are removed in update
     for (auto&& sched : _updateDeleteVector)
@@ -829,7 +1155,6 @@ void Scheduler::update(float dt)
     _updateDeleteVector.clear();
 
     _indexMapLocked = false;
-    _currentTarget  = nullptr;
 
 #if AX_ENABLE_SCRIPT_BINDING
     //
@@ -904,15 +1229,17 @@ void Scheduler::schedule(SEL_SCHEDULE selector,
     }
     else
     {
-        auto timerIt = std::find_if(timers.begin(), timers.end(), [selector](Timer* const itimer) {
+        auto existing = std::find_if(timers.begin(), timers.end(), [selector](Timer* const itimer) {
             TimerTargetSelector* timer = dynamic_cast<TimerTargetSelector*>(itimer);
             return timer && !timer->isExhausted() && selector == timer->getSelector();
         });
-        if (timerIt != timers.end())
+        if (existing != timers.end())
         {
             AXLOGD("Scheduler#schedule. Reiniting timer with interval {:.4}, repeat {}, delay {:.4f}", interval, repeat,
                   delay);
-            (*timerIt)->setupTimerWithInterval(interval, repeat, delay);
+            (*existing)->setupTimerWithInterval(interval, repeat, delay);
+            unlinkTimer(*existing);
+            enqueueTimer(*existing, timerIt->second.paused);
             return;
         }
     }
@@ -921,6 +1248,8 @@ void Scheduler::schedule(SEL_SCHEDULE selector,
     timer->initWithSelector(this, selector, target, interval, repeat, delay);
     timers.pushBack(timer);
     timer->release();
+    // the target's state wins over the argument, which only the first timer of a target sets
+    enqueueTimer(timer, timerIt->second.paused);
 }
 
 void Scheduler::schedule(SEL_SCHEDULE selector, Object* target, float interval, bool paused)
@@ -968,30 +1297,12 @@ void Scheduler::unschedule(SEL_SCHEDULE selector, Object* target)
 
             if (timer && selector == timer->getSelector())
             {
-                if (timer == timerHandle.currentTimer && !timer->isAborted())
-                {
-                    timer->retain();
-                    timer->setAborted();
-                }
-
+                detachTimer(timer);
                 timers.erase(i);
 
-                // update timerIndex in case we are in tick:, looping over the actions
-                if (timerHandle.timerIndex >= i)
-                {
-                    timerHandle.timerIndex--;
-                }
-
                 if (timers.empty())
                 {
-                    if (_currentTarget == &timerHandle)
-                    {
-                        _currentTargetSalvaged = true;
-                    }
-                    else
-                    {
-                        _timersMap.erase(timerIt);
-                    }
+                    _timersMap.erase(timerIt);
                 }
 
                 return;
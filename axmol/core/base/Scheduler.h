@@ -32,6 +32,7 @@ THE SOFTWARE.
 #include <functional>
 #include <mutex>
 #include <set>
+#include <vector>
 #include "base/axstd.h"
 #include "base/Object.h"
 #include "base/Vector.h"
@@ -40,6 +41,7 @@ namespace ax
 {
 
 class Scheduler;
+class TimerWheel;
 
 typedef std::function<void(float)> ccSchedulerFunc;
 
@@ -48,7 +50,22 @@ typedef std::function<void(float)> ccSchedulerFunc;
  */
 class AX_DLL Timer : public Object
 {
+    friend class Scheduler;
+    friend class TimerWheel;
+
 protected:
+    // where the scheduler currently keeps this timer
+    enum class State : uint8_t
+    {
+        IDLE,       // not owned by any scheduler list
+        PENDING,    // scheduled, armed on the next Scheduler::update
+        WHEEL,      // waiting in the timing wheel for its deadline
+        DUE,        // collected from the wheel, about to fire this frame
+        FIRING,     // currently inside trigger()
+        PER_FRAME,  // interval 0, ticked every frame through update()
+        PARKED,     // target paused, _deadline holds the remaining time
+    };
+
     Timer();
 
 public:
@@ -73,6 +90,12 @@ protected:
     float _delay;
     float _interval;
     bool _aborted;
+
+    // scheduler bookkeeping
+    double _deadline;     // scheduler time of the next fire (remaining time while parked)
+    uint32_t _listIndex;  // index inside the wheel slot or scheduler list holding this timer
+    uint16_t _wheelSlot;  // flat wheel slot index, valid while State::WHEEL
+    State _state;
 };
 
 class AX_DLL TimerTargetSelector : public Timer
@@ -126,6 +149,49 @@ protected:
     std::string _key;
 };
 
+/** Hierarchical timing wheel holding the interval and delayed timers of a Scheduler.
+
+    Deadlines are bucketed in 1ms ticks: a 256 slot inner wheel followed by four 64 slot outer
+    wheels, whose slots are cascaded inwards as the inner wheel wraps. Advancing the wheel only
+    visits the slots covering the elapsed ticks, so the per-frame cost depends on the number of
+    timers firing rather than the number of timers scheduled.
+ */
+class AX_DLL TimerWheel
+{
+public:
+    static constexpr double TICKS_PER_SECOND = 1000.0;
+
+    TimerWheel();
+
+    void insert(Timer* timer);
+    void remove(Timer* timer);
+
+    /** Moves every timer whose deadline is <= now into due, in no particular order.
+        Collected timers are retained and flagged Timer::State::DUE. */
+    void advance(double now, axstd::pod_vector<Timer*>& due);
+
+    size_t size() const { return _size; }
+
+private:
+    static constexpr int INNER_BITS  = 8;
+    static constexpr int OUTER_BITS  = 6;
+    static constexpr int OUTER_WHEELS = 4;
+    static constexpr int INNER_SLOTS = 1 << INNER_BITS;
+    static constexpr int OUTER_SLOTS = 1 << OUTER_BITS;
+    static constexpr uint64_t MAX_SPAN = uint64_t{1} << (INNER_BITS + OUTER_WHEELS * OUTER_BITS);
+
+    static uint64_t toTick(double time);
+
+    void place(Timer* timer, uint64_t expiry);
+    void cascade(int wheel);
+    void rebuild(uint64_t tick);
+    void unlink(Timer* timer);
+
+    std::vector<axstd::pod_vector<Timer*>> _slots;
+    uint64_t _tick;
+    size_t _size;
+};
+
 #if AX_ENABLE_SCRIPT_BINDING
 
 class AX_DLL TimerScriptHandler : public Timer
@@ -172,8 +238,6 @@ struct SchedHandle
 struct TimerHandle
 {
     Vector<Timer*> timers;
-    int timerIndex;
-    Timer* currentTimer;
     bool paused;
 };
 
@@ -504,6 +568,17 @@ protected:
 
     void unscheduleAllForTarget(std::unordered_map<void*, TimerHandle>::iterator& timerIt);
 
+    // custom selector timers
+    void enqueueTimer(Timer* timer, bool paused);
+    void unlinkTimer(Timer* timer);
+    void detachTimer(Timer* timer);
+    void parkTimer(Timer* timer);
+    void unparkTimer(Timer* timer);
+    void addPerFrameTimer(Timer* timer);
+    void armPendingTimers();
+    void fireTimer(Timer* timer);
+    void updatePerFrameTimers(float dt);
+
     float _timeScale;
 
     axstd::pod_vector<SchedHandle*> _waitList; // list wait active
@@ -522,8 +597,15 @@ protected:
 
     // Used for "selectors with interval"
     std::unordered_map<void*, TimerHandle> _timersMap;
-    struct TimerHandle* _currentTarget;
-    bool _currentTargetSalvaged;
+    // interval and delayed timers, keyed on their deadline in scaled scheduler time
+    TimerWheel _timerWheel;
+    double _timerClock;
+    // timers scheduled since the last update, armed at the start of the next one
+    axstd::pod_vector<Timer*> _pendingTimers;
+    // interval 0 timers, removed entries are nulled and compacted after each pass
+    axstd::pod_vector<Timer*> _perFrameTimers;
+    size_t _perFrameHoles;
+    axstd::pod_vector<Timer*> _dueTimers;
     // If true unschedule will not remove anything from a hash. Elements will only be marked for deletion.
     bool _indexMapLocked;
 
@@ -325,6 +325,18 @@ bool UTF8ToUTF32(std::string_view utf8, std::u32string& outUtf32)
     return utfConvert(utf8, outUtf32, ConvertUTF8toUTF32);
 }
 
+bool UTF8ToUTF32(std::string_view utf8, char32_t* outUtf32, size_t& outLength)
+{
+    auto inbeg  = reinterpret_cast<const UTF8*>(utf8.data());
+    auto outbeg = reinterpret_cast<UTF32*>(outUtf32);
+    auto r      = ConvertUTF8toUTF32(&inbeg, inbeg + utf8.length(), &outbeg, outbeg + utf8.length(), strictConversion);
+    if (r != conversionOK)
+        return false;
+
+    outLength = reinterpret_cast<char32_t*>(outbeg) - outUtf32;
+    return true;
+}
+
 bool UTF16ToUTF8(std::u16string_view utf16, std::string& outUtf8)
 {
     return utfConvert(utf16, outUtf8, ConvertUTF16toUTF8);
@@ -100,6 +100,14 @@ AX_DLL bool UTF8ToUTF16(std::string_view inUtf8, std::u16string& outUtf16);
  */
 AX_DLL bool UTF8ToUTF32(std::string_view inUtf8, std::u32string& outUtf32);
 
+/**
+ *  @brief Same as \a UTF8ToUTF32 but decodes into a caller provided buffer, without allocating.
+ *
+ *  @param outUtf32 Buffer of at least inUtf8.length() characters.
+ *  @param outLength Number of characters written on success.
+ */
+AX_DLL bool UTF8ToUTF32(std::string_view inUtf8, char32_t* outUtf32, size_t& outLength);
+
 /**
  *  @brief Same as \a UTF8ToUTF16 but converts form UTF16 to UTF8.
  *
@@ -229,6 +229,27 @@ void MathUtil::transposeMatrix(const float* m, float* dst)
 #endif
 }
 
+void MathUtil::multiplyMatrixRows3x4(const float* m1, const float* m2, float* dst)
+{
+#if defined(AX_SSE_INTRINSICS)
+    MathUtilSSE::multiplyMatrixRows3x4(reinterpret_cast<const _xm128_t*>(m1), reinterpret_cast<const _xm128_t*>(m2),
+                                       dst);
+#elif defined(AX_NEON_INTRINSICS)
+#    if AX_64BITS || AX_NEON_INTRINSICS > 1
+    MathUtilNeon::multiplyMatrixRows3x4(reinterpret_cast<const _xm128_t*>(m1), reinterpret_cast<const _xm128_t*>(m2),
+                                        dst);
+#    else
+    if (isNeon32Enabled())
+        MathUtilNeon::multiplyMatrixRows3x4(reinterpret_cast<const _xm128_t*>(m1),
+                                            reinterpret_cast<const _xm128_t*>(m2), dst);
+    else
+        MathUtilC::multiplyMatrixRows3x4(m1, m2, dst);
+#    endif
+#else
+    MathUtilC::multiplyMatrixRows3x4(m1, m2, dst);
+#endif
+}
+
 void MathUtil::transformVec4(const float* m, float x, float y, float z, float w, float* dst /*vec3*/)
 {
 #if defined(AX_SSE_INTRINSICS)
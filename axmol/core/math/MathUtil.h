@@ -50,6 +50,9 @@ class AX_DLL MathUtil
     friend class Mat4;
     friend class Vec3;
     friend class Renderer;
+    friend class MeshSkin;
+    friend class Bone3D;
+    friend class SkinningStage;
 
 public:
     /**
@@ -112,6 +115,9 @@ private:
 
     static void transposeMatrix(const float* m, float* dst);
 
+    // dst receives the first three rows of m1 * m2, the 3x4 layout of a skinning palette entry
+    static void multiplyMatrixRows3x4(const float* m1, const float* m2, float* dst);
+
     static void transformVec4(const float* m, float x, float y, float z, float w, float* dst/*vec3*/);
 
     static void transformVec4(const float* m, const float* v, float* dst/*vec4*/);
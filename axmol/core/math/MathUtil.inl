@@ -159,6 +159,19 @@ public:
         memcpy(dst, t, sizeof(t));
     }
 
+    inline static void multiplyMatrixRows3x4(const float* m1, const float* m2, float* dst)
+    {
+        float product[16];
+        multiplyMatrix(m1, m2, product);
+        for (int r = 0; r < 3; ++r)
+        {
+            dst[r * 4 + 0] = product[r];
+            dst[r * 4 + 1] = product[4 + r];
+            dst[r * 4 + 2] = product[8 + r];
+            dst[r * 4 + 3] = product[12 + r];
+        }
+    }
+
     inline static void transformVec4(const float* m, float x, float y, float z, float w, float* dst)
     {
         dst[0] = x * m[0] + y * m[4] + z * m[8] + w * m[12];
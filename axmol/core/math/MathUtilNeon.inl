@@ -102,6 +102,22 @@ struct MathUtilNeon
         dst[3] = tmp3.val[1];
     }
 
+    inline static void multiplyMatrixRows3x4(const _xm128_t* m1, const _xm128_t* m2, float* dst)
+    {
+        _xm128_t product[4];
+        multiplyMatrix(m1, m2, product);
+
+        // rows of the column-major product, the fourth (0,0,0,1) row is never stored
+        auto tmp0 = vzipq_f32(product[0], product[2]);
+        auto tmp1 = vzipq_f32(product[1], product[3]);
+        auto tmp2 = vzipq_f32(tmp0.val[0], tmp1.val[0]);
+        auto tmp3 = vzipq_f32(tmp0.val[1], tmp1.val[1]);
+
+        vst1q_f32(dst, tmp2.val[0]);
+        vst1q_f32(dst + 4, tmp2.val[1]);
+        vst1q_f32(dst + 8, tmp3.val[0]);
+    }
+
     inline static void transformVec4(const _xm128_t* m, float x, float y, float z, float w, float* dst/*vec3*/)
     {
         auto v0 = vmulq_n_f32(m[0], x);
@@ -168,6 +168,22 @@ struct MathUtilSSE
         dst[3] = _mm_shuffle_ps(tmp2, tmp3, 0xDD);
     }
 
+    static void multiplyMatrixRows3x4(const __m128 m1[4], const __m128 m2[4], float* dst)
+    {
+        __m128 product[4];
+        multiplyMatrix(m1, m2, product);
+
+        // rows of the column-major product, the fourth (0,0,0,1) row is never stored
+        __m128 tmp0 = _mm_shuffle_ps(product[0], product[1], 0x44);
+        __m128 tmp2 = _mm_shuffle_ps(product[0], product[1], 0xEE);
+        __m128 tmp1 = _mm_shuffle_ps(product[2], product[3], 0x44);
+        __m128 tmp3 = _mm_shuffle_ps(product[2], product[3], 0xEE);
+
+        _mm_storeu_ps(dst, _mm_shuffle_ps(tmp0, tmp1, 0x88));
+        _mm_storeu_ps(dst + 4, _mm_shuffle_ps(tmp0, tmp1, 0xDD));
+        _mm_storeu_ps(dst + 8, _mm_shuffle_ps(tmp2, tmp3, 0x88));
+    }
+
     static void transformVec4(const __m128 m[4], float x, float y, float z, float w, float* dst /*vec3*/)
     {
         //__m128 res = _mm_set_ps(w, z, y, x);
@@ -24,6 +24,7 @@
  ****************************************************************************/
 #include "renderer/CallbackCommand.h"
 #include "renderer/backend/DriverBase.h"
+#include "base/Director.h"
 
 namespace ax
 {
@@ -45,8 +46,14 @@ void CallbackCommand::init(float globalOrder, const Mat4& transform, unsigned in
     RenderCommand::init(globalOrder, transform, flags);
 }
 
+FrameArena* CallbackCommand::getFrameArena()
+{
+    return Director::getInstance()->getFrameArena();
+}
+
 void CallbackCommand::reset()
 {
+    func = nullptr;
     _globalOrder = 0.0f;
     _isTransparent = true;
     _skipBatching = false;
@@ -57,7 +64,11 @@ void CallbackCommand::reset()
 void CallbackCommand::execute()
 {
     if (func)
+    {
         func();
+        // drop captured references now rather than whenever the command gets reused
+        func = nullptr;
+    }
 }
 
 }
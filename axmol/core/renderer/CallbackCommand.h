@@ -27,6 +27,8 @@
 #include "renderer/backend/PixelBufferDescriptor.h"
 #include "renderer/RenderCommand.h"
 #include "base/RefPtr.h"
+#include "base/InlineFunction.h"
+#include "base/FrameArena.h"
 
 /**
  * @addtogroup renderer
@@ -51,10 +53,48 @@ class AX_DLL CallbackCommand : public RenderCommand
 {
     // only allow render to manage the callbackCommand
     friend class Renderer;
+    template <class T, size_t>
+    friend class RenderCommandPool;
     CallbackCommand();
     ~CallbackCommand(){};
 
+    static FrameArena* getFrameArena();
+
 public:
+    /** Callables up to this size are stored inside the command itself */
+    static constexpr size_t CALLBACK_CAPACITY = 64;
+
+    /**
+     * Storage for the callback. Small callables live inline; larger ones, like lambdas capturing a
+     * couple of matrices, are moved into the frame arena and only a pointer is kept inline. Assigning
+     * a callback therefore never allocates from the heap once the frame arena has warmed up.
+     */
+    class Callback : public InlineFunction<void(), CALLBACK_CAPACITY>
+    {
+        using Base = InlineFunction<void(), CALLBACK_CAPACITY>;
+
+    public:
+        using Base::operator=;
+
+        template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Callback> &&
+                                                          !std::is_same_v<std::decay_t<F>, std::nullptr_t>>>
+        Callback& operator=(F&& f)
+        {
+            using T = std::decay_t<F>;
+            if constexpr (Base::template fits<T>)
+            {
+                Base::operator=(std::forward<F>(f));
+            }
+            else
+            {
+                // the arena outlives the frame the command executes in
+                auto callable = getFrameArena()->create<T>(std::forward<F>(f));
+                Base::operator=([callable]() { (*callable)(); });
+            }
+            return *this;
+        }
+    };
+
     void init(float globalZOrder);
     void init(float globalZorder, const Mat4& transform, unsigned int);
 
@@ -68,8 +108,8 @@ public:
      Execute the render command and call callback functions.
      */
     void execute();
-    /**Callback function.*/
-    std::function<void()> func;
+    /**Callback function, released once it has run.*/
+    Callback func;
 };
 
 }
@@ -26,73 +26,56 @@
 #pragma once
 /// @cond DO_NOT_SHOW
 
-#include <list>
+#include <vector>
 
 #include "platform/PlatformMacros.h"
 
 namespace ax
 {
 
-template <class T>
+/**
+ * Typed bump arena for transient render commands. Commands are constructed once, in blocks of
+ * BlockSize, and handed out in order; reset() makes all of them available again at once, which the
+ * Renderer does in endFrame(), once every render pass of the frame is done. Steady frames therefore
+ * reuse the same commands without touching the heap. Callers reset the state of a command they get.
+ */
+template <class T, size_t BlockSize = 32>
 class RenderCommandPool
 {
 public:
     RenderCommandPool() {}
-    ~RenderCommandPool()
-    {
-        //        if( 0 != _usedPool.size())
-        //        {
-        //            AXLOGD("All RenderCommand should not be used when Pool is released!");
-        //        }
-        _freePool.clear();
-        for (auto&& allocatedPoolBlock : _allocatedPoolBlocks)
-        {
-            delete[] allocatedPoolBlock;
-            allocatedPoolBlock = nullptr;
-        }
-        _allocatedPoolBlocks.clear();
-    }
+    ~RenderCommandPool() { clear(); }
 
     T* generateCommand()
     {
-        T* result = nullptr;
-        if (_freePool.empty())
-        {
-            AllocateCommands();
-        }
-        result = _freePool.front();
-        _freePool.pop_front();
-        //_usedPool.insert(result);
-        return result;
+        if (_used == _blocks.size() * BlockSize)
+            _blocks.emplace_back(new T[BlockSize]);
+        T* command = _blocks[_used / BlockSize] + _used % BlockSize;
+        ++_used;
+        return command;
     }
 
-    void pushBackCommand(T* ptr)
-    {
-        //        if(_usedPool.find(ptr) == _usedPool.end())
-        //        {
-        //            AXLOGD("push Back Wrong command!");
-        //            return;
-        //        }
-
-        _freePool.emplace_back(ptr);
-        //_usedPool.erase(ptr);
-    }
+    /** kept for compatibility, commands are reclaimed together by reset() */
+    void pushBackCommand(T* /*ptr*/) {}
 
-private:
-    void AllocateCommands()
+    /** every command handed out so far may be handed out again */
+    void reset() { _used = 0; }
+
+    /** destroys all commands */
+    void clear()
     {
-        static const int COMMANDS_ALLOCATE_BLOCK_SIZE = 32;
-        T* commands                                   = new T[COMMANDS_ALLOCATE_BLOCK_SIZE];
-        _allocatedPoolBlocks.emplace_back(commands);
-        for (int index = 0; index < COMMANDS_ALLOCATE_BLOCK_SIZE; ++index)
-        {
-            _freePool.emplace_back(commands + index);
-        }
+        for (auto&& block : _blocks)
+            delete[] block;
+        _blocks.clear();
+        _used = 0;
     }
 
-    std::list<T*> _allocatedPoolBlocks;
-    std::list<T*> _freePool;
-    // std::set<T*> _usedPool;
+    size_t getUsedCount() const { return _used; }
+    size_t getCapacity() const { return _blocks.size() * BlockSize; }
+
+private:
+    std::vector<T*> _blocks;
+    size_t _used = 0;
 };
 
 }
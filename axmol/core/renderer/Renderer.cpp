@@ -42,6 +42,8 @@
 #include "base/EventDispatcher.h"
 #include "base/EventListenerCustom.h"
 #include "base/EventType.h"
+#include "base/FrameProfiler.h"
+#include "base/FrameStats.h"
 #include "2d/Camera.h"
 #include "2d/Scene.h"
 #include "xxhash.h"
@@ -177,12 +179,7 @@ Renderer::~Renderer()
 {
     _renderGroups.clear();
 
-    for (auto&& clearCommand : _callbackCommandsPool)
-        delete clearCommand;
-    _callbackCommandsPool.clear();
-
-    for (auto&& clearCommand : _groupCommandPool)
-        delete clearCommand;
+    _callbackCommandPool.clear();
     _groupCommandPool.clear();
 
     _groupCommandManager->release();
@@ -242,19 +239,13 @@ void Renderer::addCommand(RenderCommand* command, int renderQueueID)
     AXASSERT(command->getType() != RenderCommand::Type::UNKNOWN_COMMAND, "Invalid Command Type");
 
     _renderGroups[renderQueueID].emplace_back(command);
+    _lastCommand = command;
 }
 
 GroupCommand* Renderer::getNextGroupCommand()
 {
-    if (_groupCommandPool.empty())
-    {
-        return new GroupCommand();
-    }
-
-    auto* command = _groupCommandPool.back();
-    _groupCommandPool.pop_back();
+    auto* command = _groupCommandPool.generateCommand();
     command->reset();
-
     return command;
 }
 
@@ -262,12 +253,14 @@ void Renderer::pushGroup(int renderQueueID)
 {
     AXASSERT(!_isRendering, "Cannot change render queue while rendering");
     _commandGroupStack.push(renderQueueID);
+    _lastCommand = nullptr;
 }
 
 void Renderer::popGroup()
 {
     AXASSERT(!_isRendering, "Cannot change render queue while rendering");
     _commandGroupStack.pop();
+    _lastCommand = nullptr;
 }
 
 int Renderer::createRenderQueue()
@@ -333,7 +326,6 @@ void Renderer::processRenderCommand(RenderCommand* command)
         break;
     case RenderCommand::Type::GROUP_COMMAND:
         processGroupCommand(static_cast<GroupCommand*>(command));
-        _groupCommandPool.emplace_back(static_cast<GroupCommand*>(command));
         break;
     case RenderCommand::Type::CUSTOM_COMMAND:
         flush();
@@ -342,7 +334,6 @@ void Renderer::processRenderCommand(RenderCommand* command)
     case RenderCommand::Type::CALLBACK_COMMAND:
         flush();
         static_cast<CallbackCommand*>(command)->execute();
-        _callbackCommandsPool.emplace_back(static_cast<CallbackCommand*>(command));
         break;
     default:
         assert(false);
@@ -404,6 +395,9 @@ void Renderer::doVisitRenderQueue(const std::vector<RenderCommand*>& renderComma
 
 void Renderer::render()
 {
+    AX_PROFILE_ZONE("Renderer::render");
+    FrameStats::PhaseScope phase(Director::getInstance()->getFrameStats(), FrameStats::Phase::RENDER);
+
     // TODO: setup camera or MVP
     _isRendering = true;
 
@@ -435,6 +429,11 @@ void Renderer::endFrame()
 #endif
     _queuedTotalIndexCount  = 0;
     _queuedTotalVertexCount = 0;
+
+    // render() and clean() run once per camera and again for every captureNode or RenderTexture pass, while
+    // nodes may keep a transient command across them; only at the end of the frame are they all consumed
+    _callbackCommandPool.reset();
+    _groupCommandPool.reset();
 }
 
 void Renderer::clean()
@@ -452,6 +451,8 @@ void Renderer::clean()
 
     // Clear batch commands
     _queuedTriangleCommands.clear();
+    _lastCommand = nullptr;
+    ++_cleanCount;
 }
 
 void Renderer::setDepthTest(bool value)
@@ -892,15 +893,8 @@ void Renderer::clear(ClearFlag flags, const Color4F& color, float depth, unsigne
 
 CallbackCommand* Renderer::nextCallbackCommand()
 {
-    CallbackCommand* cmd = nullptr;
-    if (!_callbackCommandsPool.empty())
-    {
-        cmd = _callbackCommandsPool.back();
-        cmd->reset();
-        _callbackCommandsPool.pop_back();
-    }
-    else
-        cmd = new CallbackCommand();
+    auto* cmd = _callbackCommandPool.generateCommand();
+    cmd->reset();
     return cmd;
 }
 
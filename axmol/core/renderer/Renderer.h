@@ -30,9 +30,13 @@
 #include <array>
 #include <deque>
 #include <optional>
+#include <functional>
+#include <type_traits>
 
 #include "platform/PlatformMacros.h"
 #include "renderer/RenderCommand.h"
+#include "renderer/CallbackCommand.h"
+#include "renderer/RenderCommandPool.h"
 #include "renderer/backend/Types.h"
 #include "renderer/backend/ProgramManager.h"
 
@@ -151,12 +155,36 @@ public:
 
     void addCallbackCommand(std::function<void()> func, float globalZOrder = 0.0f);
 
+    /** Adds a callback that runs when the command is processed.
+     * The callable goes straight into the command's inline storage (or the frame arena when it is too
+     * large), without the heap allocation wrapping it into a std::function may cost.
+     */
+    template <typename F,
+              typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, std::function<void()>>>>
+    void addCallbackCommand(F&& func, float globalZOrder = 0.0f)
+    {
+        auto cmd = nextCallbackCommand();
+        cmd->init(globalZOrder);
+        cmd->func = std::forward<F>(func);
+        addCommand(cmd);
+    }
+
     /** Adds a `RenderComamnd` into the renderer */
     void addCommand(RenderCommand* command);
 
     /** Adds a `RenderComamnd` into the renderer specifying a particular render queue ID */
     void addCommand(RenderCommand* command, int renderQueueID);
 
+    /** Returns the last command added to the current render queue, nullptr once a group was pushed or popped since.
+     * Lets a node extend the command it queued before instead of adding another one when nothing was drawn in between.
+     */
+    RenderCommand* getLastCommand() const { return _lastCommand; }
+
+    /** Returns how many times the queued commands were rendered and cleared, once per camera and render pass.
+     * A node keeping state for the commands it queued can drop it once this changed.
+     */
+    unsigned int getCleanCount() const { return _cleanCount; }
+
     /** Get a `GroupCommand` from a GroupCommand pool or creates a new command if the pool is empty */
     GroupCommand* getNextGroupCommand();
 
@@ -183,8 +211,16 @@ public:
     ssize_t getDrawnVertices() const { return _drawnVertices; }
     /* RenderCommands (except) TrianglesCommand should update this value */
     void addDrawnVertices(ssize_t number) { _drawnVertices += number; };
+    /* returns the number of nodes rejected by frustum culling in the last frame */
+    ssize_t getCulledNodes() const { return _culledNodes; }
+    /* nodes that frustum-cull themselves (Sprite, Label, MeshRenderer) should update this value */
+    void addCulledNodes(ssize_t number) { _culledNodes += number; }
+    /* returns the number of frustum-tested nodes that were drawn in the last frame */
+    ssize_t getDrawnNodes() const { return _drawnNodes; }
+    /* nodes that frustum-cull themselves (Sprite, Label, MeshRenderer) should update this value */
+    void addDrawnNodes(ssize_t number) { _drawnNodes += number; }
     /* clear draw stats */
-    void clearDrawStats() { _drawnBatches = _drawnVertices = 0; }
+    void clearDrawStats() { _drawnBatches = _drawnVertices = _culledNodes = _drawnNodes = 0; }
 
     /**
      Set render targets. If not set, will use default render targets. It will effect all commands.
@@ -498,15 +534,16 @@ protected:
     Winding _winding   = Winding::COUNTER_CLOCK_WISE;  // default front face is CCW in GL
 
     std::stack<int> _commandGroupStack;
+    RenderCommand* _lastCommand = nullptr;
+    unsigned int _cleanCount    = 0;
 
     std::vector<RenderQueue> _renderGroups;
 
     std::vector<TrianglesCommand*> _queuedTriangleCommands;
 
-    // the pool for callback commands
-    std::vector<CallbackCommand*> _callbackCommandsPool;
-
-    std::vector<GroupCommand*> _groupCommandPool;
+    // transient commands, recycled all at once in endFrame()
+    RenderCommandPool<CallbackCommand> _callbackCommandPool;
+    RenderCommandPool<GroupCommand, 8> _groupCommandPool;  // each one owns a render queue
 
     // for TrianglesCommand
     V3F_C4B_T2F _verts[VBO_SIZE];
@@ -543,6 +580,8 @@ protected:
     // stats
     size_t _drawnBatches  = 0;
     size_t _drawnVertices = 0;
+    size_t _culledNodes   = 0;
+    size_t _drawnNodes    = 0;
     // the flag for checking whether renderer is rendering
     bool _isRendering      = false;
     bool _isDepthTestFor2D = false;
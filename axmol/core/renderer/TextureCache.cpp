@@ -39,6 +39,7 @@ THE SOFTWARE.
 #include "base/UTF8.h"
 #include "base/Director.h"
 #include "base/Scheduler.h"
+#include "base/FrameProfiler.h"
 #include "platform/FileUtils.h"
 #include "base/Utils.h"
 #include "base/NinePatchImageParser.h"
@@ -254,6 +255,8 @@ void TextureCache::unbindAllImageAsync()
 
 void TextureCache::loadImage()
 {
+    AX_PROFILE_THREAD("TextureCache");
+
     AsyncStruct* asyncStruct = nullptr;
     while (!_needQuit)
     {
@@ -280,6 +283,8 @@ void TextureCache::loadImage()
         }
         ul.unlock();
 
+        AX_PROFILE_ZONE("TextureCache::loadImage");
+
         // load image
         asyncStruct->loadSuccess = asyncStruct->image.initWithImageFileThreadSafe(asyncStruct->filename);
 
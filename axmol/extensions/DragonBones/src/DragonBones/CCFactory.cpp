@@ -200,6 +200,11 @@ CCArmatureDisplay* CCFactory::buildArmatureDisplay(std::string_view armatureName
     const auto armature = buildArmature(armatureName, dragonBonesName, skinName, textureAtlasName);
     if (armature != nullptr)
     {
+        if (_cacheFrameRate > 0 && armature->getCacheFrameRate() == 0)
+        {
+            bakeArmatureFrames(armatureName, dragonBonesName, _cacheFrameRate);
+        }
+
         _dragonBones->getClock()->add(armature);
 
         return static_cast<CCArmatureDisplay*>(armature->getDisplay());
@@ -208,6 +213,53 @@ CCArmatureDisplay* CCFactory::buildArmatureDisplay(std::string_view armatureName
     return nullptr;
 }
 
+bool CCFactory::bakeArmatureFrames(std::string_view armatureName,
+                                   std::string_view dragonBonesName,
+                                   unsigned frameRate) const
+{
+    const auto armatureData = getArmatureData(armatureName, dragonBonesName);
+    if (armatureData == nullptr)
+    {
+        return false;
+    }
+
+    // A scratch instance, kept off the clock, plays every clip once to fill the shared tables. Frames it misses
+    // are still cached lazily by the first instance that reaches them.
+    const auto armature = buildArmature(armatureName, dragonBonesName);
+    if (armature == nullptr)
+    {
+        return false;
+    }
+
+    armature->setCacheFrameRate(frameRate > 0 ? frameRate : armatureData->frameRate);
+
+    const auto animation = armature->getAnimation();
+    for (const auto& animationName : armatureData->getAnimationNames())
+    {
+        const auto animationData = armatureData->getAnimation(animationName);
+        if (animationData == nullptr || animationData->cacheFrameRate <= 0.0f)
+        {
+            continue;
+        }
+
+        // caching starts once the fade in is done, half frame steps land on every cache index
+        animation->fadeIn(animationName, 0.0f, 1);
+        armature->advanceTime(0.0f);
+
+        const auto step       = 0.5f / animationData->cacheFrameRate;
+        const auto frameCount = animationData->cachedFrames.size();
+        for (std::size_t i = 0; i < frameCount * 2; ++i)
+        {
+            armature->advanceTime(step);
+        }
+    }
+
+    // returned to the pool by the next DragonBones::advanceTime, before its buffered events are dispatched
+    armature->dispose();
+
+    return true;
+}
+
 ax::Sprite* CCFactory::getTextureDisplay(std::string_view textureName, std::string_view dragonBonesName) const
 {
     const auto textureData = static_cast<CCTextureData*>(_getTextureData(dragonBonesName, textureName));
@@ -69,12 +69,13 @@ public:
 
 protected:
     std::string _prevPath;
+    unsigned _cacheFrameRate;
 
 public:
     /**
      * @inheritDoc
      */
-    CCFactory() : _prevPath()
+    CCFactory() : _prevPath(), _cacheFrameRate(0)
     {
         if (_dragonBonesInstance == nullptr)
         {
@@ -172,6 +173,31 @@ public:
                                                     std::string_view dragonBonesName  = "",
                                                     std::string_view skinName         = "",
                                                     std::string_view textureAtlasName = "") const;
+    /**
+     * - Sample every animation of an armature once at a fixed frame rate into the frame cache shared by all its
+     * instances. Instances playing a baked clip then replay the cached bone transforms by frame index instead of
+     * evaluating the bone timelines, so many identical characters cost about as much as one. Cached animations
+     * lose the features the runtime cache doesn't support, such as bone offsets.
+     * @param armatureName - The armature data name.
+     * @param dragonBonesName - The cached name of the DragonBonesData instance. (If not set, all DragonBonesData
+     * instances are retrieved, and when multiple DragonBonesData instances contain a the same name armature data,
+     * it may not be possible to accurately get the corresponding armature data)
+     * @param frameRate - The sampling frame rate. (Use the frame rate of the armature data when 0)
+     * @returns Whether the armature data was found.
+     * @see dragonBones.Armature#cacheFrameRate
+     * @language en_US
+     */
+    bool bakeArmatureFrames(std::string_view armatureName,
+                            std::string_view dragonBonesName = "",
+                            unsigned frameRate               = 0) const;
+    /**
+     * - Bake and cache the frames of every armature built by buildArmatureDisplay() from now on, see
+     * bakeArmatureFrames(). Each armature data is baked the first time it is built. (0 turns the cache mode off for
+     * armature data that isn't cached yet, default: 0)
+     * @language en_US
+     */
+    void setCacheFrameRate(unsigned frameRate) { _cacheFrameRate = frameRate; }
+    unsigned getCacheFrameRate() const { return _cacheFrameRate; }
     /**
      * - Create the display object with the specified texture.
      * @param textureName - The texture data name.
@@ -1,6 +1,8 @@
 
 #include "EffekseerForCocos2d-x.h"
 #include "base/Utils.h"
+#include "base/JobSystem.h"
+#include <algorithm>
 
 #ifdef AX_USE_METAL
 #include "renderer/backend/DriverBase.h"
@@ -709,6 +711,13 @@ void EffectEmitter::draw(cocos2d::Renderer* renderer, const cocos2d::Mat4& paren
     }
 #endif
 
+    if (manager->isBatchingEnabled)
+    {
+        manager->drawBatched(renderer, handle, _globalZOrder);
+        cocos2d::Node::draw(renderer, parentTransform, parentFlags);
+        return;
+    }
+
     auto renderCommand = renderer->nextCallbackCommand();
     
 	renderCommand->init(_globalZOrder);
@@ -777,6 +786,80 @@ void EffectManager::setRotation(::Effekseer::Handle handle, float x, float y, fl
 
 void EffectManager::setScale(::Effekseer::Handle handle, float x, float y, float z) { manager2d->SetScale(handle, x, y, z); }
 
+void EffectManager::drawBatched(cocos2d::Renderer* renderer, ::Effekseer::Handle handle, float globalZOrder)
+{
+	// The batches queued before the last clean have been rendered, once per camera or render pass
+	auto clean = renderer->getCleanCount();
+	if (clean != drawBatchClean_)
+	{
+		drawBatchClean_ = clean;
+		drawBatchCount_ = 0;
+	}
+
+	Effekseer::Matrix44 mCamera = renderer2d->GetCameraMatrix();
+	Effekseer::Matrix44 mProj = renderer2d->GetProjectionMatrix();
+
+	// Only extend the last batch while nothing else was queued after it, so the draw order is kept
+	if (drawBatchCount_ > 0)
+	{
+		auto& batch = drawBatches_[drawBatchCount_ - 1];
+		if (renderer->getLastCommand() == batch.command && batch.globalZOrder == globalZOrder &&
+			memcmp(batch.cameraMatrix.Values, mCamera.Values, sizeof(mCamera.Values)) == 0 &&
+			memcmp(batch.projectionMatrix.Values, mProj.Values, sizeof(mProj.Values)) == 0)
+		{
+			batch.handles.push_back(handle);
+			return;
+		}
+	}
+
+	if (drawBatchCount_ == drawBatches_.size())
+	{
+		drawBatches_.emplace_back();
+	}
+
+	auto index = drawBatchCount_++;
+	auto& batch = drawBatches_[index];
+	batch.globalZOrder = globalZOrder;
+	batch.cameraMatrix = mCamera;
+	batch.projectionMatrix = mProj;
+	batch.handles.clear();
+	batch.handles.push_back(handle);
+
+	batch.command = renderer->nextCallbackCommand();
+	batch.command->init(globalZOrder);
+	batch.command->func = [this, renderer, index]() -> void { renderBatch(renderer, index); };
+	renderer->addCommand(batch.command);
+}
+
+void EffectManager::renderBatch(cocos2d::Renderer* renderer, size_t index)
+{
+	const auto& batch = drawBatches_[index];
+
+	renderer2d->SetCameraMatrix(batch.cameraMatrix);
+	renderer2d->SetProjectionMatrix(batch.projectionMatrix);
+
+#ifdef AX_USE_METAL
+	EffectEmitter::beforeRender(renderer2d, commandList_);
+#endif
+	renderer2d->SetRestorationOfStatesFlag(true);
+	renderer2d->BeginRendering();
+	for (auto handle : batch.handles)
+	{
+		manager2d->DrawHandle(handle);
+	}
+	renderer2d->EndRendering();
+
+	// Count drawcall and vertex
+	renderer->addDrawnBatches(renderer2d->GetDrawCallCount());
+	renderer->addDrawnVertices(renderer2d->GetDrawVertexCount());
+	renderer2d->ResetDrawCallCount();
+	renderer2d->ResetDrawVertexCount();
+
+#ifdef AX_USE_METAL
+	EffectEmitter::afterRender(renderer2d, commandList_);
+#endif
+}
+
 bool EffectManager::Initialize(cocos2d::Size visibleSize)
 {
 	int32_t spriteSize = 4000;
@@ -830,6 +913,8 @@ EffectManager::EffectManager() {}
 
 EffectManager::~EffectManager()
 {
+	setIsParallelUpdateEnabled(false);
+
 	if (distortingCallback != nullptr &&
         renderer2d->GetDistortingCallback() != distortingCallback)
 	{
@@ -868,6 +953,59 @@ void EffectManager::setIsDistortionEnabled(bool value)
     }
 }
 
+void EffectManager::setIsBatchingEnabled(bool value) { isBatchingEnabled = value; }
+
+static std::vector<EffectManager*> g_parallelManagers;
+static constexpr std::string_view PARALLEL_UPDATE_KEY = "EffectManager::updateAll";
+
+void EffectManager::setIsParallelUpdateEnabled(bool value)
+{
+	if (isParallelUpdateEnabled == value)
+		return;
+
+	isParallelUpdateEnabled = value;
+
+	// The managers are spread over the engine's job system only, Effekseer's own worker threads stay off
+	auto scheduler = cocos2d::Director::getInstance()->getScheduler();
+	if (isParallelUpdateEnabled)
+	{
+		if (g_parallelManagers.empty())
+		{
+			scheduler->schedule(&EffectManager::updateAll, &g_parallelManagers, 0.0f, false, PARALLEL_UPDATE_KEY);
+		}
+		g_parallelManagers.push_back(this);
+	}
+	else
+	{
+		g_parallelManagers.erase(std::find(g_parallelManagers.begin(), g_parallelManagers.end(), this));
+		if (g_parallelManagers.empty())
+		{
+			scheduler->unschedule(PARALLEL_UPDATE_KEY, &g_parallelManagers);
+		}
+	}
+}
+
+void EffectManager::updateAll(float delta)
+{
+	if (g_parallelManagers.empty())
+		return;
+
+	// Managers share no state while updating, so each one goes to its own job
+	cocos2d::Director::getInstance()->getJobSystem()->parallelFor(
+		g_parallelManagers.size(), 1, [](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++)
+			{
+				g_parallelManagers[i]->manager2d->Update();
+			}
+		});
+
+	for (auto manager : g_parallelManagers)
+	{
+		manager->time_ += delta;
+		manager->renderer2d->SetTime(manager->time_);
+	}
+}
+
 void EffectManager::begin(cocos2d::Renderer* renderer, float globalZOrder)
 {
 	if (isDistortionEnabled)
@@ -940,6 +1078,10 @@ void EffectManager::setProjectionMatrix(const cocos2d::Mat4& mat)
 
 void EffectManager::update(float delta)
 {
+	// updateAll already updates it from the scheduler
+	if (isParallelUpdateEnabled)
+		return;
+
 	manager2d->Update();
 	time_ += delta;
 	renderer2d->SetTime(time_);
@@ -86,8 +86,8 @@ private:
 
 	// cocos2d::CallbackCommand renderCommand;
 	
-	void beforeRender(EffekseerRenderer::RendererRef, Effekseer::RefPtr<EffekseerRenderer::CommandList>);
-    void afterRender(EffekseerRenderer::RendererRef, Effekseer::RefPtr<EffekseerRenderer::CommandList>);
+	static void beforeRender(EffekseerRenderer::RendererRef, Effekseer::RefPtr<EffekseerRenderer::CommandList>);
+    static void afterRender(EffekseerRenderer::RendererRef, Effekseer::RefPtr<EffekseerRenderer::CommandList>);
 
 public:
 	/**
@@ -319,6 +319,8 @@ private:
     ::Effekseer::RefPtr<::EffekseerRenderer::CommandList> commandList_ = nullptr;
     
 	bool isDistortionEnabled = false;
+	bool isBatchingEnabled = false;
+	bool isParallelUpdateEnabled = false;
 
 	bool isDistorted = false;
 	float time_ = 0.0f;
@@ -328,6 +330,26 @@ private:
 	cocos2d::CustomCommand beginCommand;
 	cocos2d::CustomCommand endCommand;
 
+	//! emitters drawn one after another, rendered between a single BeginRendering and EndRendering
+	struct DrawBatch
+	{
+		cocos2d::CallbackCommand* command = nullptr;
+		float globalZOrder = 0.0f;
+		::Effekseer::Matrix44 cameraMatrix;
+		::Effekseer::Matrix44 projectionMatrix;
+		std::vector<::Effekseer::Handle> handles;
+	};
+
+	std::vector<DrawBatch> drawBatches_;
+	size_t drawBatchCount_ = 0;
+	unsigned int drawBatchClean_ = 0;
+
+	void drawBatched(cocos2d::Renderer* renderer, ::Effekseer::Handle handle, float globalZOrder);
+
+	void renderBatch(cocos2d::Renderer* renderer, size_t index);
+
+	static void updateAll(float delta);
+
 	::Effekseer::Handle play(Effect* effect, float x, float y, float z);
 
 	::Effekseer::Handle play(Effect* effect, float x, float y, float z, int startTime);
@@ -378,6 +400,24 @@ public:
 	*/
 	void setIsDistortionEnabled(bool value);
 
+	/**
+		@brief
+		\~English	Set whether emitters drawn one after another are merged into a single render command.
+		Effekseer then batches their particles by render state instead of restarting for each emitter.
+	*/
+	void setIsBatchingEnabled(bool value);
+
+	bool getIsBatchingEnabled() const { return isBatchingEnabled; }
+
+	/**
+		@brief
+		\~English	Set whether the manager is updated by the scheduler, together with every other manager that enabled it,
+		in one pass of the job system. update then does nothing.
+	*/
+	void setIsParallelUpdateEnabled(bool value);
+
+	bool getIsParallelUpdateEnabled() const { return isParallelUpdateEnabled; }
+
 	/**
 		@brief
 		\~English	Inherit visit and add a process before drawing the layer.
@@ -400,7 +440,7 @@ public:
     
 	/**
 		@brief
-		\~English	Update the manager every frame.
+		\~English	Update the manager every frame, unless parallel update is enabled.
 		\~Japanese	毎フレーム実行する。
 		@param delta
 		\~English	In seconds.
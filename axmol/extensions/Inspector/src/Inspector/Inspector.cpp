@@ -9,6 +9,9 @@
 #endif
 
 #include "fmt/format.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
 #include <memory>
 #include "misc/cpp/imgui_stdlib.h"
 
@@ -391,79 +394,302 @@ std::string Inspector::getNodeTypeName(Node* node)
     return demangle(typeid(*node).name());
 }
 
-void Inspector::drawTreeRecursive(Node* node, int index)
+void Inspector::setSummaryBudget(int summariesPerFrame, unsigned int refreshFrames)
 {
-    if (!_showInvisible && !node->isVisible())
-    {
-        return;
-    }
+    _summaryBudget        = std::max(1, summariesPerFrame);
+    _summaryRefreshFrames = std::max(1u, refreshFrames);
+}
 
-    std::string str = fmt::format("[{}] {}", index, getNodeTypeName(node));
+void Inspector::setSearchIndexBudget(int nodesPerFrame)
+{
+    _indexBudget = std::max(1, nodesPerFrame);
+}
 
-    if (node->getTag() != -1)
-    {
-        fmt::format_to(std::back_inserter(str), " ({})", node->getTag());
-    }
+void Inspector::resetTreeState()
+{
+    _treeRows.clear();
+    _expandedNodes.clear();
+    _summaries.clear();
+    _searchIndex.clear();
+    _pendingIndex.clear();
+    _indexStack.clear();
+    _searchResults.clear();
+    _searchResultsDirty = true;
+    _indexBuiltFrame    = 0;
+}
+
+void Inspector::buildTreeRows()
+{
+    _treeRows.clear();
+    if (!_target)
+        return;
 
-    const auto nodeName = node->getName();
-    if (!nodeName.empty())
+    // Children are pushed in reverse so they pop in scene order
+    std::vector<TreeRow> stack{{_target, 0, 0}};
+    while (!stack.empty())
     {
-        fmt::format_to(std::back_inserter(str), " \"{}\"", nodeName);
+        auto row = stack.back();
+        stack.pop_back();
+        _treeRows.push_back(row);
+
+        if (!_expandedNodes.contains(row.node))
+            continue;
+
+        const auto& children = row.node->getChildren();
+        for (int i = static_cast<int>(children.size()) - 1; i >= 0; --i)
+        {
+            auto* child = children.at(i);
+            if (!child || (!_showInvisible && !child->isVisible()))
+                continue;
+            stack.push_back({child, row.depth + 1, i});
+        }
     }
+}
 
-    const auto childrenCount = node->getChildrenCount();
-    if (childrenCount != 0)
+const std::string& Inspector::getNodeSummary(Node* node)
+{
+    auto& summary = _summaries[node];
+    summary.seenFrame = _frame;
+
+    const auto* type = &typeid(*node);
+    const bool stale = summary.type == type && _frame - summary.refreshedFrame >= _summaryRefreshFrames;
+    // A missing summary is always built, stale ones wait for budget
+    if (summary.type != type || (stale && _summariesRefreshed < _summaryBudget))
     {
-        fmt::format_to(std::back_inserter(str), " {{{}}}", childrenCount);
+        if (summary.type == type)
+            ++_summariesRefreshed;
+
+        summary.type           = type;
+        summary.refreshedFrame = _frame;
+        summary.label          = demangle(type->name());
+
+        if (node->getTag() != -1)
+        {
+            fmt::format_to(std::back_inserter(summary.label), " ({})", node->getTag());
+        }
+
+        const auto nodeName = node->getName();
+        if (!nodeName.empty())
+        {
+            fmt::format_to(std::back_inserter(summary.label), " \"{}\"", nodeName);
+        }
+
+        const auto childrenCount = node->getChildrenCount();
+        if (childrenCount != 0)
+        {
+            fmt::format_to(std::back_inserter(summary.label), " {{{}}}", childrenCount);
+        }
     }
+    return summary.label;
+}
 
-    auto flags = ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_SpanFullWidth;
-    if (_selected_node == node)
+void Inspector::drawTreeRows()
+{
+    buildTreeRows();
+    _summariesRefreshed = 0;
+
+    const float indent = ImGui::GetStyle().IndentSpacing;
+    const float startX = ImGui::GetCursorPosX();
+
+    if (_scrollToSelected)
     {
-        flags |= ImGuiTreeNodeFlags_Selected;
+        _scrollToSelected = false;
+        for (size_t i = 0; i < _treeRows.size(); ++i)
+        {
+            if (_treeRows[i].node == _selected_node)
+            {
+                ImGui::SetScrollY(i * ImGui::GetTextLineHeightWithSpacing());
+                break;
+            }
+        }
     }
-    if (node->getChildrenCount() == 0)
+
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(_treeRows.size()));
+    while (clipper.Step())
     {
-        flags |= ImGuiTreeNodeFlags_Leaf;
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+        {
+            auto* node = _treeRows[i].node;
+            const bool expanded = _expandedNodes.contains(node);
+
+            auto flags = ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_SpanFullWidth |
+                         ImGuiTreeNodeFlags_NoTreePushOnOpen;
+            if (_selected_node == node)
+            {
+                flags |= ImGuiTreeNodeFlags_Selected;
+            }
+            if (node->getChildrenCount() == 0)
+            {
+                flags |= ImGuiTreeNodeFlags_Leaf;
+            }
+
+            ImGui::SetCursorPosX(startX + _treeRows[i].depth * indent);
+            ImGui::SetNextItemOpen(expanded);
+            const bool is_open =
+                ImGui::TreeNodeEx(node, flags, "[%d] %s", _treeRows[i].index, getNodeSummary(node).c_str());
+
+            if (is_open != expanded)
+            {
+                if (is_open)
+                    _expandedNodes.try_emplace(node, node);
+                else
+                    _expandedNodes.erase(node);
+            }
+
+            // Track hovered node
+            if (ImGui::IsItemHovered())
+            {
+                _hovered_node = node;
+            }
+
+            if (ImGui::IsItemClicked())
+            {
+                if (_lockSelection)
+                {
+                    // ignore selection changes when locked
+                }
+                else if (node == _selected_node && ImGui::GetIO().KeyAlt)
+                {
+                    _selected_node = nullptr;
+                }
+                else
+                {
+                    _selected_node = node;
+                }
+            }
+        }
     }
 
-    const bool is_open = ImGui::TreeNodeEx(node, flags, "%s", str.c_str());
+    // Forget summaries of nodes that have not been on screen for a while
+    if (_frame % 300 == 0)
+        std::erase_if(_summaries, [this](const auto& entry) { return _frame - entry.second.seenFrame > 300; });
 
-    // Track hovered node
-    if (ImGui::IsItemHovered())
+    // Forget expanded nodes that left the scene, but keep those under a collapsed parent
+    if (_frame % 30 == 0)
     {
-        _hovered_node = node;
+        std::erase_if(_expandedNodes, [this](const auto& entry) {
+            if (entry.second->getReferenceCount() == 1)
+                return true;
+            auto* parent = entry.first;
+            while (parent && parent != _target)
+                parent = parent->getParent();
+            return parent == nullptr;
+        });
     }
+}
 
-    if (ImGui::IsItemClicked())
+void Inspector::updateSearchIndex()
+{
+    AX_PROFILE_ZONE("Inspector::updateSearchIndex");
+
+    if (_indexStack.empty())
     {
-        if (_lockSelection)
+        // The current index stays searchable while the next one is built
+        if (!_pendingIndex.empty())
         {
-            // ignore selection changes when locked
+            _searchIndex.swap(_pendingIndex);
+            _pendingIndex.clear();
+            _indexBuiltFrame    = _frame;
+            _searchResultsDirty = true;
         }
-        else if (node == _selected_node && ImGui::GetIO().KeyAlt)
+        if (!_target || (!_searchIndex.empty() && _frame - _indexBuiltFrame < _indexRebuildFrames))
+            return;
+
+        _indexStack.emplace_back(_target, -1);
+    }
+
+    for (int budget = _indexBudget; budget > 0 && !_indexStack.empty(); --budget)
+    {
+        auto [node, parent] = std::move(_indexStack.back());
+        _indexStack.pop_back();
+
+        std::string name{node->getName()};
+        std::string key = name;
+        std::transform(key.begin(), key.end(), key.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+        const int entry = static_cast<int>(_pendingIndex.size());
+        _pendingIndex.push_back({std::move(name), std::move(key), node.get(), parent});
+
+        const auto& children = node->getChildren();
+        for (auto it = children.rbegin(); it != children.rend(); ++it)
         {
-            _selected_node = nullptr;
+            if (*it)
+                _indexStack.emplace_back(*it, entry);
         }
-        else
+    }
+}
+
+bool Inspector::isIndexedNodeAlive(int entry) const
+{
+    // Only dereference nodes whose parent was already found alive, starting from the scene
+    std::vector<int> chain;
+    for (int i = entry; i != -1; i = _searchIndex[i].parent)
+        chain.push_back(i);
+
+    if (_searchIndex[chain.back()].node != _target)
+        return false;
+
+    for (size_t i = chain.size() - 1; i > 0; --i)
+    {
+        const auto& children = _searchIndex[chain[i]].node->getChildren();
+        if (std::find(children.begin(), children.end(), _searchIndex[chain[i - 1]].node) == children.end())
+            return false;
+    }
+    return true;
+}
+
+void Inspector::revealNode(Node* node)
+{
+    for (auto* parent = node->getParent(); parent; parent = parent->getParent())
+    {
+        _expandedNodes.try_emplace(parent, parent);
+        if (parent == _target)
+            break;
+    }
+    _scrollToSelected = true;
+}
+
+void Inspector::drawSearchResults()
+{
+    if (_searchResultsDirty || _searchQuery != _searchedQuery)
+    {
+        _searchedQuery = _searchQuery;
+        _searchResultsDirty = false;
+        _searchResults.clear();
+
+        std::string query = _searchQuery;
+        std::transform(query.begin(), query.end(), query.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        for (int i = 0; i < static_cast<int>(_searchIndex.size()); ++i)
         {
-            _selected_node = node;
+            if (_searchIndex[i].key.find(query) != std::string::npos)
+                _searchResults.push_back(i);
         }
     }
 
-    if (is_open)
+    ImGui::TextDisabled("%d matches in %d nodes%s", static_cast<int>(_searchResults.size()),
+                        static_cast<int>(_searchIndex.size()), _indexStack.empty() ? "" : " (indexing)");
+
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(_searchResults.size()));
+    while (clipper.Step())
     {
-        const auto &children = node->getChildren();
-        for (int i = 0; auto* child : children)
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
         {
-            if(!child)
+            const int entry = _searchResults[i];
+            ImGui::PushID(entry);
+            // Names are shown from the index; the node itself is only touched once it is checked to be alive
+            if (ImGui::Selectable(_searchIndex[entry].name.c_str(), _selected_node == _searchIndex[entry].node) &&
+                !_lockSelection && isIndexedNodeAlive(entry))
             {
-                continue;
+                _selected_node = _searchIndex[entry].node;
+                revealNode(_selected_node);
+                _searchQuery.clear();
             }
-            drawTreeRecursive(child, i);
-            i++;
+            ImGui::PopID();
         }
-        ImGui::TreePop();
     }
 }
 
@@ -550,6 +776,7 @@ void Inspector::openForScene(Scene* target)
         return;
 
     _target = target;
+    resetTreeState();
 
     if (_target == nullptr)
     {
@@ -589,6 +816,7 @@ void Inspector::close()
     }
 
     _target = nullptr;
+    resetTreeState();
 
     auto presenter = ImGuiPresenter::getInstance();
     presenter->removeRenderLoop("#insp");
@@ -633,6 +861,11 @@ void Inspector::mainLoop()
         return;
     }
 
+    AX_PROFILE_ZONE("Inspector::mainLoop");
+
+    const auto loopStart = std::chrono::steady_clock::now();
+    ++_frame;
+
     // Reset hovered node at the start of each frame
     _hovered_node = nullptr;
 
@@ -667,6 +900,8 @@ void Inspector::mainLoop()
 
     // Update bounds visualization
     updateBoundsVisualization();
+
+    _lastLoopMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - loopStart).count();
 }
 bool Inspector::addPage(std::string_view id, std::unique_ptr<Page> page)
 {
@@ -683,9 +918,29 @@ void Inspector::removePage(const std::string& id)
 void Inspector::drawTreePage()
 {
     const auto avail = ImGui::GetContentRegionAvail();
-    if (ImGui::BeginChild("insp.tree.left", ImVec2(avail.x * 0.5f, 0), false, ImGuiWindowFlags_HorizontalScrollbar))
+    if (ImGui::BeginChild("insp.tree.left", ImVec2(avail.x * 0.5f, 0), false))
     {
-        drawTreeRecursive(_target);
+        ImGui::SetNextItemWidth(-FLT_MIN);
+        ImGui::InputTextWithHint("##insp.search", "Search node names", &_searchQuery);
+        // Indexing starts as soon as the box is focused, so results are ready by the time a query is typed
+        const bool searching = !_searchQuery.empty() || ImGui::IsItemActive();
+        if (searching)
+            updateSearchIndex();
+        else if (!_indexStack.empty())
+        {
+            // Abandon a partial rebuild instead of keeping its nodes alive
+            _indexStack.clear();
+            _pendingIndex.clear();
+        }
+
+        if (ImGui::BeginChild("insp.tree.rows", ImVec2(0, 0), false, ImGuiWindowFlags_HorizontalScrollbar))
+        {
+            if (_searchQuery.empty())
+                drawTreeRows();
+            else
+                drawSearchResults();
+        }
+        ImGui::EndChild();
     }
     ImGui::EndChild();
 
@@ -800,6 +1055,24 @@ void Inspector::drawSettingsPage()
     ImGui::Checkbox("Show Invisible Nodes", &_showInvisible);
     ImGui::Checkbox("Lock Selection", &_lockSelection);
     ImGui::Checkbox("Show Bounds", &_showBounds);
+
+    // Budgets keep the inspector's own cost flat in large scenes
+    ImGui::Separator();
+    int summaryBudget = _summaryBudget;
+    int refreshFrames = static_cast<int>(_summaryRefreshFrames);
+    bool summaryChanged = ImGui::DragInt("Summaries / Frame", &summaryBudget, 1.0f, 1, 1024);
+    summaryChanged |= ImGui::DragInt("Summary Refresh (frames)", &refreshFrames, 1.0f, 1, 600);
+    if (summaryChanged)
+    {
+        setSummaryBudget(summaryBudget, static_cast<unsigned int>(std::max(1, refreshFrames)));
+    }
+    int indexBudget = _indexBudget;
+    if (ImGui::DragInt("Indexed Nodes / Frame", &indexBudget, 4.0f, 1, 65536))
+    {
+        setSearchIndexBudget(indexBudget);
+    }
+    ImGui::Text("Inspector: %.2f ms last frame, %d rows, %d summaries", _lastLoopMs,
+                static_cast<int>(_treeRows.size()), static_cast<int>(_summaries.size()));
 }
 
 void Inspector::applyTheme()
@@ -4,7 +4,10 @@
 #include "extensions/ExtensionMacros.h"
 #include "base/Config.h"
 #include <string>
+#include <typeinfo>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include "EventListenerCustom.h"
 #include "RefPtr.h"
 #include "2d/Node.h"
@@ -79,6 +82,11 @@ class Inspector
     float getFontSize() const { return _fontSize; }
     void setFontPath(std::string_view fontPath);
     void setFontSize(float fontSize);
+
+    /** Node summaries rebuilt per frame once they are older than the refresh interval, in frames */
+    void setSummaryBudget(int summariesPerFrame, unsigned int refreshFrames);
+    /** Nodes added to the name search index per frame */
+    void setSearchIndexBudget(int nodesPerFrame);
     class Page {
     public:
             virtual ~Page() = default;
@@ -92,7 +100,14 @@ class Inspector
     void init();
     void cleanup();
     void mainLoop();
-        void drawTreeRecursive(Node*, int index = 0);
+        void buildTreeRows();
+        void drawTreeRows();
+        const std::string& getNodeSummary(Node*);
+        void updateSearchIndex();
+        void drawSearchResults();
+        bool isIndexedNodeAlive(int entry) const;
+        void revealNode(Node*);
+        void resetTreeState();
         void drawProperties();
         void drawTreePage();
         void drawPreviewPage();
@@ -108,6 +123,50 @@ class Inspector
     ax::Scene* _target = nullptr;
     ax::RefPtr<ax::DrawNode> _boundsDrawNode = nullptr;
 
+    // Visible rows of the tree: only the children of expanded nodes are walked
+    struct TreeRow
+    {
+        Node* node;
+        int depth;
+        int index;
+    };
+    struct NodeSummary
+    {
+        std::string label;
+        const std::type_info* type = nullptr;  // detects a new node reusing a freed address
+        unsigned int refreshedFrame = 0;
+        unsigned int seenFrame = 0;
+    };
+    struct SearchEntry
+    {
+        std::string name;
+        std::string key;  // lower case name
+        Node* node;
+        int parent;  // entry of the parent, -1 for the scene
+    };
+    std::vector<TreeRow> _treeRows;
+    // Holds references so expanded nodes can be checked against the scene after they were removed from it
+    std::unordered_map<Node*, RefPtr<Node>> _expandedNodes;
+    std::unordered_map<Node*, NodeSummary> _summaries;
+    int _summaryBudget = 64;
+    int _summariesRefreshed = 0;
+    unsigned int _summaryRefreshFrames = 30;
+    unsigned int _frame = 0;
+    bool _scrollToSelected = false;
+
+    // Built a few nodes per frame; the pending stack holds references so its nodes stay valid between frames
+    std::vector<SearchEntry> _searchIndex;
+    std::vector<SearchEntry> _pendingIndex;
+    std::vector<std::pair<RefPtr<Node>, int>> _indexStack;
+    std::vector<int> _searchResults;
+    std::string _searchQuery;
+    std::string _searchedQuery;
+    int _indexBudget = 256;
+    unsigned int _indexRebuildFrames = 120;
+    unsigned int _indexBuiltFrame = 0;
+    bool _searchResultsDirty = true;
+    float _lastLoopMs = 0.0f;
+
     std::unordered_map<std::string, std::unique_ptr<InspectPropertyHandler>> _propertyHandlers;
     std::unordered_map<std::string, std::unique_ptr<Page>> _pages;
     RefPtr<EventListenerCustom> _beforeNewSceneEventListener;
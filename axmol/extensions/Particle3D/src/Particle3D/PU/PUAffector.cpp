@@ -26,6 +26,7 @@
 
 #include "Particle3D/PU/PUAffector.h"
 #include "Particle3D/PU/PUEmitter.h"
+#include "Particle3D/PU/PUParticleBatch.h"
 #include "Particle3D/PU/PUParticleSystem3D.h"
 
 namespace ax
@@ -201,4 +202,38 @@ void PUAffector::process(PUParticle3D* particle, float delta, bool firstParticle
     updatePUAffector(particle, delta);
 }
 
+void PUAffector::processBatch(PUParticleBatch& batch, float delta, bool firstParticle)
+{
+    if (batch.empty())
+        return;
+
+    if (firstParticle)
+    {
+        firstParticleUpdate(batch.getParticle(0), delta);
+    }
+
+    updatePUAffectorBatch(batch, delta);
+}
+
+const float* PUAffector::calculateAffectSpecialisationFactors(PUParticleBatch& batch)
+{
+    if (_affectSpecialisation != AFSP_TTL_INCREASE && _affectSpecialisation != AFSP_TTL_DECREASE)
+        return nullptr;
+
+    float* factors            = batch.getScratch(0);
+    const float* timeFraction = batch.timeFraction.data();
+    const size_t count        = batch.paddedSize();
+    if (_affectSpecialisation == AFSP_TTL_INCREASE)
+    {
+        for (size_t i = 0; i < count; ++i)
+            factors[i] = timeFraction[i];
+    }
+    else
+    {
+        for (size_t i = 0; i < count; ++i)
+            factors[i] = 1.0f - timeFraction[i];
+    }
+    return factors;
+}
+
 }
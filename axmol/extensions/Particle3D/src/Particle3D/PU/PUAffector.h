@@ -37,6 +37,7 @@ namespace ax
 
 struct PUParticle3D;
 class PUParticleSystem3D;
+class PUParticleBatch;
 
 class AX_EX_DLL PUAffector : public Particle3DAffector
 {
@@ -68,6 +69,15 @@ public:
     virtual void initParticleForEmission(PUParticle3D* particle);
     void process(PUParticle3D* particle, float delta, bool firstParticle);
 
+    /** Fields of PUParticleBatch read or written by updatePUAffectorBatch, 0 when the affector has no batched version.
+     */
+    virtual uint32_t getBatchFields() const { return 0; }
+    /** Same as updatePUAffector for every particle of the batch. Only called when getBatchFields is not 0.
+     */
+    virtual void updatePUAffectorBatch(PUParticleBatch& /*batch*/, float /*delta*/) {}
+    bool isBatchable() const { return getBatchFields() != 0 && _excludedEmitters.empty(); }
+    void processBatch(PUParticleBatch& batch, float delta, bool firstParticle);
+
     void setLocalPosition(const Vec3& pos) { _position = pos; };
     const Vec3 getLocalPosition() const { return _position; };
     void setMass(float mass);
@@ -115,6 +125,10 @@ public:
 
 protected:
     float calculateAffectSpecialisationFactor(const PUParticle3D* particle);
+    /** Batched calculateAffectSpecialisationFactor, nullptr when the factor is 1 for every particle.
+        The batch needs TIME_FRACTION unless the specialisation is AFSP_DEFAULT.
+    */
+    const float* calculateAffectSpecialisationFactors(PUParticleBatch& batch);
 
 protected:
     Vec3 _position;
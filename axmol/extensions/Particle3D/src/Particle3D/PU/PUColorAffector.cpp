@@ -26,6 +26,7 @@
 
 #include "PUColorAffector.h"
 #include "Particle3D/PU/PUParticleSystem3D.h"
+#include "Particle3D/PU/PUParticleBatch.h"
 
 namespace ax
 {
@@ -123,6 +124,71 @@ void PUColorAffector::updatePUAffector(PUParticle3D* particle, float /*deltaTime
     }
 }
 
+uint32_t PUColorAffector::getBatchFields() const
+{
+    return PUParticleBatch::COLOR | PUParticleBatch::TIME_FRACTION |
+           (_colorOperation == CAO_MULTIPLY ? PUParticleBatch::ORIGINAL_COLOR : 0);
+}
+
+void PUColorAffector::updatePUAffectorBatch(PUParticleBatch& batch, float /*deltaTime*/)
+{
+    typedef PULane4 L;
+
+    // Fast rejection
+    if (_colorMap.empty())
+        return;
+
+    // Flatten the map once, it only holds a handful of keys
+    _batchKeys.clear();
+    _batchColors.clear();
+    for (auto&& it : _colorMap)
+    {
+        _batchKeys.emplace_back(it.first);
+        _batchColors.emplace_back(it.second);
+    }
+    const size_t keyCount = _batchKeys.size();
+
+    const float* timeFraction = batch.timeFraction.data();
+    for (size_t i = 0, count = batch.size(); i < count; ++i)
+    {
+        // Same search as findNearestColorMapIterator: the last key at or before the time, or the first key
+        size_t k = 0;
+        while (k < keyCount && !(timeFraction[i] < _batchKeys[k]))
+            ++k;
+        size_t k1 = k == 0 ? 0 : k - 1;
+
+        Vec4 color;
+        if (k1 + 1 < keyCount)
+        {
+            // Interpolate colour
+            float t = (timeFraction[i] - _batchKeys[k1]) / (_batchKeys[k1 + 1] - _batchKeys[k1]);
+            color   = _batchColors[k1] + ((_batchColors[k1 + 1] - _batchColors[k1]) * t);
+        }
+        else
+        {
+            color = _batchColors[k1];
+        }
+        batch.colorR[i] = color.x;
+        batch.colorG[i] = color.y;
+        batch.colorB[i] = color.z;
+        batch.colorA[i] = color.w;
+    }
+
+    if (_colorOperation == CAO_MULTIPLY)
+    {
+        float* channels[4]               = {batch.colorR.data(), batch.colorG.data(), batch.colorB.data(),
+                                            batch.colorA.data()};
+        const float* originalChannels[4] = {batch.originalColorR.data(), batch.originalColorG.data(),
+                                            batch.originalColorB.data(), batch.originalColorA.data()};
+        for (int c = 0; c < 4; ++c)
+        {
+            for (size_t i = 0, n = batch.paddedSize(); i < n; i += 4)
+                L::store(channels[c] + i, L::mul(L::load(channels[c] + i), L::load(originalChannels[c] + i)));
+        }
+    }
+    batch.markWritten(PUParticleBatch::COLOR);
+}
+
 PUColorAffector* PUColorAffector::create()
 {
     auto pca = new PUColorAffector();
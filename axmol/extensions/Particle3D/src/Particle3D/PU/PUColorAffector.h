@@ -29,6 +29,7 @@
 #include "Particle3D/PU/PUAffector.h"
 #include "base/Types.h"
 #include <map>
+#include <vector>
 
 namespace ax
 {
@@ -50,6 +51,8 @@ public:
     static PUColorAffector* create();
 
     virtual void updatePUAffector(PUParticle3D* particle, float deltaTime) override;
+    virtual uint32_t getBatchFields() const override;
+    virtual void updatePUAffectorBatch(PUParticleBatch& batch, float deltaTime) override;
 
     /**
      */
@@ -83,6 +86,9 @@ protected:
 
 protected:
     ColorMap _colorMap;
+    // _colorMap flattened for updatePUAffectorBatch
+    std::vector<float> _batchKeys;
+    std::vector<Vec4> _batchColors;
     ColorOperation _colorOperation;
 };
 }
@@ -26,6 +26,7 @@
 
 #include "PUGravityAffector.h"
 #include "Particle3D/PU/PUParticleSystem3D.h"
+#include "Particle3D/PU/PUParticleBatch.h"
 
 namespace ax
 {
@@ -71,6 +72,45 @@ void PUGravityAffector::updatePUAffector(PUParticle3D* particle, float deltaTime
     }
 }
 
+uint32_t PUGravityAffector::getBatchFields() const
+{
+    return PUParticleBatch::POSITION | PUParticleBatch::DIRECTION | PUParticleBatch::MASS |
+           (_affectSpecialisation != AFSP_DEFAULT ? PUParticleBatch::TIME_FRACTION : 0);
+}
+
+void PUGravityAffector::updatePUAffectorBatch(PUParticleBatch& batch, float deltaTime)
+{
+    typedef PULane4 L;
+
+    const float* factors = calculateAffectSpecialisationFactors(batch);
+    float scaleVelocity  = (static_cast<PUParticleSystem3D*>(_particleSystem))->getParticleSystemScaleVelocity();
+
+    const L::Type centreX = L::splat(_derivedPosition.x);
+    const L::Type centreY = L::splat(_derivedPosition.y);
+    const L::Type centreZ = L::splat(_derivedPosition.z);
+    const L::Type gravity = L::splat(scaleVelocity * _gravity * _mass * deltaTime);
+    const L::Type zero    = L::splat(0.0f);
+
+    for (size_t i = 0, n = batch.paddedSize(); i < n; i += 4)
+    {
+        L::Type dx     = L::sub(centreX, L::load(&batch.positionX[i]));
+        L::Type dy     = L::sub(centreY, L::load(&batch.positionY[i]));
+        L::Type dz     = L::sub(centreZ, L::load(&batch.positionZ[i]));
+        L::Type length = L::add(L::add(L::mul(dx, dx), L::mul(dy, dy)), L::mul(dz, dz));
+
+        // force * deltaTime, left at 0 for particles sitting on the affector
+        L::Type force = L::div(L::mul(gravity, L::load(&batch.mass[i])), length);
+        if (factors)
+            force = L::mul(force, L::load(factors + i));
+        force = L::selectGreater(length, zero, force, zero);
+
+        L::store(&batch.directionX[i], L::add(L::load(&batch.directionX[i]), L::mul(force, dx)));
+        L::store(&batch.directionY[i], L::add(L::load(&batch.directionY[i]), L::mul(force, dy)));
+        L::store(&batch.directionZ[i], L::add(L::load(&batch.directionZ[i]), L::mul(force, dz)));
+    }
+    batch.markWritten(PUParticleBatch::DIRECTION);
+}
+
 void PUGravityAffector::preUpdateAffector(float /*deltaTime*/)
 {
     getDerivedPosition();
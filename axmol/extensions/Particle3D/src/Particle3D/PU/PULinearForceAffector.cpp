@@ -26,6 +26,7 @@
 
 #include "PULinearForceAffector.h"
 #include "Particle3D/PU/PUParticleSystem3D.h"
+#include "Particle3D/PU/PUParticleBatch.h"
 
 namespace ax
 {
@@ -55,6 +56,49 @@ void PULinearForceAffector::updatePUAffector(PUParticle3D* particle, float /*del
     }
 }
 
+uint32_t PULinearForceAffector::getBatchFields() const
+{
+    return PUParticleBatch::DIRECTION |
+           (_forceApplication == FA_ADD && _affectSpecialisation != AFSP_DEFAULT ? PUParticleBatch::TIME_FRACTION : 0);
+}
+
+void PULinearForceAffector::updatePUAffectorBatch(PUParticleBatch& batch, float /*deltaTime*/)
+{
+    typedef PULane4 L;
+
+    float* directions[3] = {batch.directionX.data(), batch.directionY.data(), batch.directionZ.data()};
+    const size_t n       = batch.paddedSize();
+    if (_forceApplication == FA_ADD)
+    {
+        const float* factors = calculateAffectSpecialisationFactors(batch);
+        const float force[3] = {_scaledVector.x, _scaledVector.y, _scaledVector.z};
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            const L::Type f = L::splat(force[axis]);
+            float* d        = directions[axis];
+            for (size_t i = 0; i < n; i += 4)
+            {
+                L::Type add = factors ? L::mul(f, L::load(factors + i)) : f;
+                L::store(d + i, L::add(L::load(d + i), add));
+            }
+        }
+    }
+    else
+    {
+        // Average of the direction and the force
+        const float force[3] = {_forceVector.x, _forceVector.y, _forceVector.z};
+        const L::Type half   = L::splat(0.5f);
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            const L::Type f = L::splat(force[axis]);
+            float* d        = directions[axis];
+            for (size_t i = 0; i < n; i += 4)
+                L::store(d + i, L::mul(L::add(L::load(d + i), f), half));
+        }
+    }
+    batch.markWritten(PUParticleBatch::DIRECTION);
+}
+
 PULinearForceAffector* PULinearForceAffector::create()
 {
     auto plfa = new PULinearForceAffector();
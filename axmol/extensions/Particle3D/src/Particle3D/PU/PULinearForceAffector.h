@@ -39,6 +39,8 @@ public:
 
     virtual void preUpdateAffector(float deltaTime) override;
     virtual void updatePUAffector(PUParticle3D* particle, float deltaTime) override;
+    virtual uint32_t getBatchFields() const override;
+    virtual void updatePUAffectorBatch(PUParticleBatch& batch, float deltaTime) override;
 
     virtual void copyAttributesTo(PUAffector* affector) override;
 
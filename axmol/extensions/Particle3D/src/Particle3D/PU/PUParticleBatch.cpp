@@ -0,0 +1,142 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "Particle3D/PU/PUParticleBatch.h"
+#include "Particle3D/PU/PUParticleSystem3D.h"
+
+namespace ax
+{
+
+namespace
+{
+// Fills one component array, zeroing the padding lanes
+template <typename Getter>
+void gatherField(std::vector<float>& values, const std::vector<PUParticle3D*>& particles, size_t padded, Getter get)
+{
+    values.resize(padded);
+    size_t i = 0;
+    for (auto&& particle : particles)
+        values[i++] = get(particle);
+    for (; i < padded; ++i)
+        values[i] = 0.0f;
+}
+}  // namespace
+
+void PUParticleBatch::clear()
+{
+    _particles.clear();
+    _gathered = 0;
+    _written  = 0;
+}
+
+void PUParticleBatch::gather(uint32_t fields)
+{
+    const size_t padded = paddedSize();
+    _gathered           = fields;
+    _written            = 0;
+
+    if (fields & POSITION)
+    {
+        gatherField(positionX, _particles, padded, [](PUParticle3D* p) { return p->position.x; });
+        gatherField(positionY, _particles, padded, [](PUParticle3D* p) { return p->position.y; });
+        gatherField(positionZ, _particles, padded, [](PUParticle3D* p) { return p->position.z; });
+    }
+    if (fields & DIRECTION)
+    {
+        gatherField(directionX, _particles, padded, [](PUParticle3D* p) { return p->direction.x; });
+        gatherField(directionY, _particles, padded, [](PUParticle3D* p) { return p->direction.y; });
+        gatherField(directionZ, _particles, padded, [](PUParticle3D* p) { return p->direction.z; });
+    }
+    if (fields & COLOR)
+    {
+        gatherField(colorR, _particles, padded, [](PUParticle3D* p) { return p->color.x; });
+        gatherField(colorG, _particles, padded, [](PUParticle3D* p) { return p->color.y; });
+        gatherField(colorB, _particles, padded, [](PUParticle3D* p) { return p->color.z; });
+        gatherField(colorA, _particles, padded, [](PUParticle3D* p) { return p->color.w; });
+    }
+    if (fields & ORIGINAL_COLOR)
+    {
+        gatherField(originalColorR, _particles, padded, [](PUParticle3D* p) { return p->originalColor.x; });
+        gatherField(originalColorG, _particles, padded, [](PUParticle3D* p) { return p->originalColor.y; });
+        gatherField(originalColorB, _particles, padded, [](PUParticle3D* p) { return p->originalColor.z; });
+        gatherField(originalColorA, _particles, padded, [](PUParticle3D* p) { return p->originalColor.w; });
+    }
+    if (fields & DIMENSIONS)
+    {
+        gatherField(width, _particles, padded, [](PUParticle3D* p) { return p->width; });
+        gatherField(height, _particles, padded, [](PUParticle3D* p) { return p->height; });
+        gatherField(depth, _particles, padded, [](PUParticle3D* p) { return p->depth; });
+    }
+    if (fields & MASS)
+        gatherField(mass, _particles, padded, [](PUParticle3D* p) { return p->mass; });
+    if (fields & TIME_FRACTION)
+        gatherField(timeFraction, _particles, padded, [](PUParticle3D* p) { return p->timeFraction; });
+    if (fields & ROTATION)
+        gatherField(zRotation, _particles, padded, [](PUParticle3D* p) { return p->zRotation; });
+    if (fields & TEXTURE_COORDS)
+    {
+        gatherField(lbU, _particles, padded, [](PUParticle3D* p) { return p->lb_uv.x; });
+        gatherField(lbV, _particles, padded, [](PUParticle3D* p) { return p->lb_uv.y; });
+        gatherField(rtU, _particles, padded, [](PUParticle3D* p) { return p->rt_uv.x; });
+        gatherField(rtV, _particles, padded, [](PUParticle3D* p) { return p->rt_uv.y; });
+    }
+}
+
+void PUParticleBatch::scatter()
+{
+    AXASSERT((_written & ~_gathered) == 0, "PUParticleBatch: a field was written without being gathered");
+
+    const size_t count = _particles.size();
+    if (_written & POSITION)
+    {
+        for (size_t i = 0; i < count; ++i)
+            _particles[i]->position.set(positionX[i], positionY[i], positionZ[i]);
+    }
+    if (_written & DIRECTION)
+    {
+        for (size_t i = 0; i < count; ++i)
+            _particles[i]->direction.set(directionX[i], directionY[i], directionZ[i]);
+    }
+    if (_written & COLOR)
+    {
+        for (size_t i = 0; i < count; ++i)
+            _particles[i]->color.set(colorR[i], colorG[i], colorB[i], colorA[i]);
+    }
+    if (_written & DIMENSIONS)
+    {
+        // Also flags the dimensions as the particle's own and updates the bounding radius
+        for (size_t i = 0; i < count; ++i)
+            _particles[i]->setOwnDimensions(width[i], height[i], depth[i]);
+    }
+    _written = 0;
+}
+
+float* PUParticleBatch::getScratch(int slot)
+{
+    auto& scratch = _scratch[slot];
+    scratch.resize(paddedSize());
+    return scratch.data();
+}
+
+}
@@ -0,0 +1,163 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "platform/PlatformConfig.h"
+#include "extensions/ExtensionExport.h"
+#include <stdint.h>
+#include <vector>
+
+namespace ax
+{
+
+struct PUParticle3D;
+
+/** Four floats processed together, with SSE or NEON when the build enables them.
+ */
+struct PULane4
+{
+#if defined(AX_SSE_INTRINSICS)
+    typedef __m128 Type;
+
+    static Type load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, Type v) { _mm_storeu_ps(p, v); }
+    static Type splat(float f) { return _mm_set1_ps(f); }
+    static Type add(Type a, Type b) { return _mm_add_ps(a, b); }
+    static Type sub(Type a, Type b) { return _mm_sub_ps(a, b); }
+    static Type mul(Type a, Type b) { return _mm_mul_ps(a, b); }
+    static Type div(Type a, Type b) { return _mm_div_ps(a, b); }
+    //! a > b ? x : y for each lane
+    static Type selectGreater(Type a, Type b, Type x, Type y)
+    {
+        Type mask = _mm_cmpgt_ps(a, b);
+        return _mm_or_ps(_mm_and_ps(mask, x), _mm_andnot_ps(mask, y));
+    }
+#elif defined(AX_NEON_INTRINSICS)
+    typedef float32x4_t Type;
+
+    static Type load(const float* p) { return vld1q_f32(p); }
+    static void store(float* p, Type v) { vst1q_f32(p, v); }
+    static Type splat(float f) { return vdupq_n_f32(f); }
+    static Type add(Type a, Type b) { return vaddq_f32(a, b); }
+    static Type sub(Type a, Type b) { return vsubq_f32(a, b); }
+    static Type mul(Type a, Type b) { return vmulq_f32(a, b); }
+    static Type div(Type a, Type b)
+    {
+#    if defined(__aarch64__) || defined(_M_ARM64)
+        return vdivq_f32(a, b);
+#    else
+        // ARMv7 has no vector division, refine the reciprocal estimate twice
+        Type r = vrecpeq_f32(b);
+        r      = vmulq_f32(vrecpsq_f32(b, r), r);
+        r      = vmulq_f32(vrecpsq_f32(b, r), r);
+        return vmulq_f32(a, r);
+#    endif
+    }
+    static Type selectGreater(Type a, Type b, Type x, Type y) { return vbslq_f32(vcgtq_f32(a, b), x, y); }
+#else
+    struct Type
+    {
+        float v[4];
+    };
+
+    static Type load(const float* p) { return {{p[0], p[1], p[2], p[3]}}; }
+    static void store(float* p, Type v)
+    {
+        for (int i = 0; i < 4; ++i)
+            p[i] = v.v[i];
+    }
+    static Type splat(float f) { return {{f, f, f, f}}; }
+    static Type add(Type a, Type b) { return {{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}}; }
+    static Type sub(Type a, Type b) { return {{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]}}; }
+    static Type mul(Type a, Type b) { return {{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]}}; }
+    static Type div(Type a, Type b) { return {{a.v[0] / b.v[0], a.v[1] / b.v[1], a.v[2] / b.v[2], a.v[3] / b.v[3]}}; }
+    static Type selectGreater(Type a, Type b, Type x, Type y)
+    {
+        Type r;
+        for (int i = 0; i < 4; ++i)
+            r.v[i] = a.v[i] > b.v[i] ? x.v[i] : y.v[i];
+        return r;
+    }
+#endif
+};
+
+/** Structure-of-arrays copy of the live particles of a pool.
+ *
+ * Affectors that support it run one loop over whole lanes of particles instead of a virtual call for each one.
+ * Only the requested fields are gathered and only the written ones are copied back. Arrays are padded to a
+ * multiple of 4 with zeros, which kernels may process but must never copy back.
+ */
+class AX_EX_DLL PUParticleBatch
+{
+public:
+    enum Field : uint32_t
+    {
+        POSITION       = 1 << 0,
+        DIRECTION      = 1 << 1,
+        COLOR          = 1 << 2,
+        ORIGINAL_COLOR = 1 << 3,
+        DIMENSIONS     = 1 << 4,
+        MASS           = 1 << 5,
+        TIME_FRACTION  = 1 << 6,
+        ROTATION       = 1 << 7,
+        TEXTURE_COORDS = 1 << 8,
+    };
+
+    void clear();
+    void add(PUParticle3D* particle) { _particles.emplace_back(particle); }
+
+    size_t size() const { return _particles.size(); }
+    size_t paddedSize() const { return (_particles.size() + 3) & ~size_t(3); }
+    bool empty() const { return _particles.empty(); }
+    PUParticle3D* getParticle(size_t index) const { return _particles[index]; }
+
+    /** Copies the given fields of every added particle into the arrays. */
+    void gather(uint32_t fields);
+    /** Marks fields changed by a kernel, so scatter copies them back. */
+    void markWritten(uint32_t fields) { _written |= fields; }
+    /** Copies the written fields back into the particles. */
+    void scatter();
+
+    /** Scratch array of paddedSize() floats, e.g. for per-particle factors. */
+    float* getScratch(int slot);
+
+    std::vector<float> positionX, positionY, positionZ;
+    std::vector<float> directionX, directionY, directionZ;
+    std::vector<float> colorR, colorG, colorB, colorA;
+    std::vector<float> originalColorR, originalColorG, originalColorB, originalColorA;
+    std::vector<float> width, height, depth;
+    std::vector<float> mass;
+    std::vector<float> timeFraction;
+    std::vector<float> zRotation;
+    std::vector<float> lbU, lbV, rtU, rtV;
+
+protected:
+    std::vector<PUParticle3D*> _particles;
+    std::vector<float> _scratch[2];
+    uint32_t _gathered = 0;
+    uint32_t _written  = 0;
+};
+
+}
@@ -199,6 +199,7 @@ PUParticleSystem3D::PUParticleSystem3D()
     , _defaultDepth(DEFAULT_DEPTH)
     , _maxVelocity(DEFAULT_MAX_VELOCITY)
     , _maxVelocitySet(false)
+    , _affectorBatchingEnabled(true)
     , _isMarkedForEmission(false)
     , _parentParticleSystem(nullptr)
 {
@@ -716,7 +717,10 @@ void PUParticleSystem3D::updator(float elapsedTime)
 {
     bool firstActiveParticle = true;
     bool firstParticle       = true;
-    processParticle(_particlePool, firstActiveParticle, firstParticle, elapsedTime);
+    if (canProcessBatched(_particlePool))
+        processParticleBatched(_particlePool, firstActiveParticle, firstParticle, elapsedTime);
+    else
+        processParticle(_particlePool, firstActiveParticle, firstParticle, elapsedTime);
 
     for (auto&& iter : _emittedEmitterParticlePool)
     {
@@ -1241,6 +1245,7 @@ void PUParticleSystem3D::copyAttributesTo(PUParticleSystem3D* system)
     system->_defaultDepth                = _defaultDepth;
     system->_maxVelocity                 = _maxVelocity;
     system->_maxVelocitySet              = _maxVelocitySet;
+    system->_affectorBatchingEnabled     = _affectorBatchingEnabled;
     system->_matName                     = _matName;
     system->_isMarkedForEmission         = _isMarkedForEmission;
     system->_parentParticleSystem        = _parentParticleSystem;
@@ -1434,6 +1439,127 @@ void PUParticleSystem3D::processParticle(ParticlePool& pool,
     }
 }
 
+bool PUParticleSystem3D::canProcessBatched(ParticlePool& pool) const
+{
+    // Below this the gather and scatter cost more than the virtual calls they save
+    static const size_t MIN_BATCHED_PARTICLES = 64;
+
+    // Only the visual particles: emitted emitters and systems emit while being processed
+    if (!_affectorBatchingEnabled || &pool != &_particlePool ||
+        pool.getActiveDataList().size() < MIN_BATCHED_PARTICLES)
+        return false;
+
+    bool hasAffector = false;
+    for (auto&& it : _affectors)
+    {
+        if (it->isEnabled())
+        {
+            if (!static_cast<PUAffector*>(it)->isBatchable())
+                return false;
+            hasAffector = true;
+        }
+    }
+    return hasAffector;
+}
+
+void PUParticleSystem3D::processParticleBatched(ParticlePool& pool,
+                                                bool& firstActiveParticle,
+                                                bool& firstParticle,
+                                                float elapsedTime)
+{
+    /** Same steps as processParticle for each particle, but every affector runs over all the live particles at once.
+        The order across particles changes: every emitter is updated for all the particles before the first affector
+        runs, and the render, motion and observers follow the last affector. A particle ends up in the same state,
+        but an observer whose event handler changes an affector or the system takes effect on the next frame here,
+        instead of on the following particles.
+    */
+    _particleBatch.clear();
+    _batchVisited.clear();
+
+    PUParticle3D* particle = static_cast<PUParticle3D*>(pool.getFirst());
+    while (particle)
+    {
+        bool alive = !isExpired(particle, elapsedTime);
+        if (alive)
+        {
+            particle->process(elapsedTime);
+
+            for (auto&& it : _emitters)
+            {
+                if (it->isEnabled() && !it->isMarkedForEmission())
+                {
+                    (static_cast<PUEmitter*>(it))->updateEmitter(particle, elapsedTime);
+                }
+            }
+            _particleBatch.add(particle);
+        }
+        else
+        {
+            initParticleForExpiration(particle, elapsedTime);
+            pool.lockLatestData();
+        }
+        _batchVisited.emplace_back(particle, alive);
+        particle = static_cast<PUParticle3D*>(pool.getNext());
+    }
+
+    if (!_particleBatch.empty())
+    {
+        uint32_t fields = 0;
+        for (auto&& it : _affectors)
+        {
+            if (it->isEnabled())
+                fields |= static_cast<PUAffector*>(it)->getBatchFields();
+        }
+
+        _particleBatch.gather(fields);
+        for (auto&& it : _affectors)
+        {
+            if (it->isEnabled())
+            {
+                (static_cast<PUAffector*>(it))->processBatch(_particleBatch, elapsedTime, firstActiveParticle);
+            }
+        }
+        _particleBatch.scatter();
+    }
+
+    Vec3 scale = getDerivedScale();
+    for (auto&& visited : _batchVisited)
+    {
+        particle = visited.first;
+        if (visited.second)
+        {
+            if (_render)
+                static_cast<PURender*>(_render)->updateRender(particle, elapsedTime, firstActiveParticle);
+
+            firstActiveParticle = false;
+            // Keep latest position
+            particle->latestPosition = particle->position;
+            processMotion(particle, elapsedTime, scale, firstActiveParticle);
+        }
+
+        for (auto&& it : _observers)
+        {
+            if (it->isEnabled())
+            {
+                it->updateObserver(particle, elapsedTime, firstParticle);
+            }
+        }
+
+        if (particle->hasEventFlags(PUParticle3D::PEF_EXPIRED))
+        {
+            particle->setEventFlags(0);
+            particle->addEventFlags(PUParticle3D::PEF_EXPIRED);
+        }
+        else
+        {
+            particle->setEventFlags(0);
+        }
+
+        particle->timeToLive -= elapsedTime;
+        firstParticle = false;
+    }
+}
+
 bool PUParticleSystem3D::makeParticleLocal(PUParticle3D* particle)
 {
     if (!particle)
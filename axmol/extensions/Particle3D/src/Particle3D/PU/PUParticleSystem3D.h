@@ -30,6 +30,7 @@
 #include "base/Protocols.h"
 #include "math/Math.h"
 #include "Particle3D/ParticleSystem3D.h"
+#include "Particle3D/PU/PUParticleBatch.h"
 #include <vector>
 #include <map>
 
@@ -296,6 +297,12 @@ public:
      */
     void setMaxVelocity(float maxVelocity);
 
+    /**
+     * Run the affectors over a structure-of-arrays copy of the visual particles when all of them support it (default).
+     */
+    void setAffectorBatchingEnabled(bool enabled) { _affectorBatchingEnabled = enabled; }
+    bool isAffectorBatchingEnabled() const { return _affectorBatchingEnabled; }
+
     void setMaterialName(std::string_view name) { _matName = name; };
     std::string_view getMaterialName() const { return _matName; };
 
@@ -364,6 +371,8 @@ protected:
     void executeEmitParticles(PUEmitter* emitter, unsigned requested, float elapsedTime);
     void emitParticles(ParticlePool& pool, PUEmitter* emitter, unsigned requested, float elapsedTime);
     void processParticle(ParticlePool& pool, bool& firstActiveParticle, bool& firstParticle, float elapsedTime);
+    bool canProcessBatched(ParticlePool& pool) const;
+    void processParticleBatched(ParticlePool& pool, bool& firstActiveParticle, bool& firstParticle, float elapsedTime);
     void processMotion(PUParticle3D* particle, float timeElapsed, const Vec3& scl, bool firstParticle);
     void notifyRescaled(const Vec3& scl);
     void initParticleForEmission(PUParticle3D* particle);
@@ -407,6 +416,11 @@ protected:
     float _maxVelocity;  // Attributes that limit the velocity of the particles in this technique.
     bool _maxVelocitySet;
 
+    bool _affectorBatchingEnabled;
+    PUParticleBatch _particleBatch;
+    // particles visited by processParticleBatched, with whether each one is still alive
+    std::vector<std::pair<PUParticle3D*, bool>> _batchVisited;
+
     std::string _matName;  // material name
 
     bool _isMarkedForEmission;
@@ -25,6 +25,7 @@
  ****************************************************************************/
 #include "Particle3D/ParticleSystem3D.h"
 #include <stddef.h>  // offsetof
+#include <algorithm>
 #include "base/Types.h"
 #include "Particle3D/PU/PURender.h"
 #include "Particle3D/PU/PUParticleSystem3D.h"
@@ -146,118 +147,130 @@ void PUParticle3DQuadRender::render(Renderer* renderer, const Mat4& transform, P
         right.normalize();
     }
 
-    for (auto&& iter : activeParticleList)
+    // Right and up are the same for every particle of these types, so the quads can be built lane by lane
+    const bool batched = _rotateType == TEXTURE_COORDS && (_type == POINT || _type == ORIENTED_COMMON ||
+                                                           _type == PERPENDICULAR_COMMON);
+    if (batched)
     {
-        auto particle = static_cast<PUParticle3D*>(iter);
-        determineUVCoords(particle);
-        if (_type == ORIENTED_SELF)
-        {
-            Vec3 direction = particle->direction;
-            // transform.transformVector(particle->direction, &direction);
-            up = direction;
-            up.normalize();
-            Vec3::cross(direction, backward, &right);
-            right.normalize();
-        }
-        else if (_type == PERPENDICULAR_SELF)
-        {
-            Vec3 direction = particle->direction;
-            // transform.transformVector(particle->direction, &direction);
-            direction.normalize();
-            // up = PUUtil::perpendicular(direction);
-            // up.normalize();
-            Vec3::cross(_commonUp, direction, &right);
-            right.normalize();
-            Vec3::cross(direction, right, &up);
-            up.normalize();
-            backward = direction;
-        }
-        else if (_type == ORIENTED_SHAPE)
+        int quads   = fillQuadsBatched(activeParticleList, right, up, offsetX, offsetY);
+        vertexindex = quads * 4;
+        index       = quads * 6;
+    }
+    else
+    {
+        for (auto&& iter : activeParticleList)
         {
-            up.set(particle->orientation.x, particle->orientation.y, particle->orientation.z);
-            up.normalize();
-            Vec3::cross(up, backward, &right);
-            right.normalize();
-        }
-        Vec3 halfwidth  = particle->width * 0.5f * right;
-        Vec3 halfheight = particle->height * 0.5f * up;
-        Vec3 offset     = halfwidth * offsetX + halfheight * offsetY;
-        // transform.transformPoint(particle->position, &position);
-        position = particle->position;
+            auto particle = static_cast<PUParticle3D*>(iter);
+            determineUVCoords(particle);
+            if (_type == ORIENTED_SELF)
+            {
+                Vec3 direction = particle->direction;
+                // transform.transformVector(particle->direction, &direction);
+                up = direction;
+                up.normalize();
+                Vec3::cross(direction, backward, &right);
+                right.normalize();
+            }
+            else if (_type == PERPENDICULAR_SELF)
+            {
+                Vec3 direction = particle->direction;
+                // transform.transformVector(particle->direction, &direction);
+                direction.normalize();
+                // up = PUUtil::perpendicular(direction);
+                // up.normalize();
+                Vec3::cross(_commonUp, direction, &right);
+                right.normalize();
+                Vec3::cross(direction, right, &up);
+                up.normalize();
+                backward = direction;
+            }
+            else if (_type == ORIENTED_SHAPE)
+            {
+                up.set(particle->orientation.x, particle->orientation.y, particle->orientation.z);
+                up.normalize();
+                Vec3::cross(up, backward, &right);
+                right.normalize();
+            }
+            Vec3 halfwidth  = particle->width * 0.5f * right;
+            Vec3 halfheight = particle->height * 0.5f * up;
+            Vec3 offset     = halfwidth * offsetX + halfheight * offsetY;
+            // transform.transformPoint(particle->position, &position);
+            position = particle->position;
 
-        if (_rotateType == TEXTURE_COORDS)
-        {
-            float costheta = cosf(-particle->zRotation);
-            float sintheta = sinf(-particle->zRotation);
-            Vec2 texOffset = 0.5f * (particle->lb_uv + particle->rt_uv);
-            Vec2 val;
-            val.set((particle->lb_uv.x - texOffset.x), (particle->lb_uv.y - texOffset.y));
-            val.set(val.x * costheta - val.y * sintheta, val.x * sintheta + val.y * costheta);
-            fillVertex(vertexindex, (position + (-halfwidth - halfheight + offset)), particle->color, val + texOffset);
-
-            val.set(particle->rt_uv.x - texOffset.x, particle->lb_uv.y - texOffset.y);
-            val.set(val.x * costheta - val.y * sintheta, val.x * sintheta + val.y * costheta);
-            fillVertex(vertexindex + 1, (position + (halfwidth - halfheight + offset)), particle->color,
-                       val + texOffset);
-
-            val.set(particle->lb_uv.x - texOffset.x, particle->rt_uv.y - texOffset.y);
-            val.set(val.x * costheta - val.y * sintheta, val.x * sintheta + val.y * costheta);
-            fillVertex(vertexindex + 2, (position + (-halfwidth + halfheight + offset)), particle->color,
-                       val + texOffset);
-
-            val.set(particle->rt_uv.x - texOffset.x, particle->rt_uv.y - texOffset.y);
-            val.set(val.x * costheta - val.y * sintheta, val.x * sintheta + val.y * costheta);
-            fillVertex(vertexindex + 3, (position + (halfwidth + halfheight + offset)), particle->color,
-                       val + texOffset);
-        }
-        else
-        {
-            Mat4::createRotation(backward, -particle->zRotation, &pRotMat);
-            fillVertex(vertexindex, (position + pRotMat * (-halfwidth - halfheight + offset)), particle->color,
-                       particle->lb_uv);
-            fillVertex(vertexindex + 1, (position + pRotMat * (halfwidth - halfheight + offset)), particle->color,
-                       Vec2(particle->rt_uv.x, particle->lb_uv.y));
-            fillVertex(vertexindex + 2, (position + pRotMat * (-halfwidth + halfheight + offset)), particle->color,
-                       Vec2(particle->lb_uv.x, particle->rt_uv.y));
-            fillVertex(vertexindex + 3, (position + pRotMat * (halfwidth + halfheight + offset)), particle->color,
-                       particle->rt_uv);
-        }
+            if (_rotateType == TEXTURE_COORDS)
+            {
+                float costheta = cosf(-particle->zRotation);
+                float sintheta = sinf(-particle->zRotation);
+                Vec2 texOffset = 0.5f * (particle->lb_uv + particle->rt_uv);
+                Vec2 val;
+                val.set((particle->lb_uv.x - texOffset.x), (particle->lb_uv.y - texOffset.y));
+                val.set(val.x * costheta - val.y * sintheta, val.x * sintheta + val.y * costheta);
+                fillVertex(vertexindex, (position + (-halfwidth - halfheight + offset)), particle->color, val + texOffset);
+
+                val.set(particle->rt_uv.x - texOffset.x, particle->lb_uv.y - texOffset.y);
+                val.set(val.x * costheta - val.y * sintheta, val.x * sintheta + val.y * costheta);
+                fillVertex(vertexindex + 1, (position + (halfwidth - halfheight + offset)), particle->color,
+                           val + texOffset);
+
+                val.set(particle->lb_uv.x - texOffset.x, particle->rt_uv.y - texOffset.y);
+                val.set(val.x * costheta - val.y * sintheta, val.x * sintheta + val.y * costheta);
+                fillVertex(vertexindex + 2, (position + (-halfwidth + halfheight + offset)), particle->color,
+                           val + texOffset);
+
+                val.set(particle->rt_uv.x - texOffset.x, particle->rt_uv.y - texOffset.y);
+                val.set(val.x * costheta - val.y * sintheta, val.x * sintheta + val.y * costheta);
+                fillVertex(vertexindex + 3, (position + (halfwidth + halfheight + offset)), particle->color,
+                           val + texOffset);
+            }
+            else
+            {
+                Mat4::createRotation(backward, -particle->zRotation, &pRotMat);
+                fillVertex(vertexindex, (position + pRotMat * (-halfwidth - halfheight + offset)), particle->color,
+                           particle->lb_uv);
+                fillVertex(vertexindex + 1, (position + pRotMat * (halfwidth - halfheight + offset)), particle->color,
+                           Vec2(particle->rt_uv.x, particle->lb_uv.y));
+                fillVertex(vertexindex + 2, (position + pRotMat * (-halfwidth + halfheight + offset)), particle->color,
+                           Vec2(particle->lb_uv.x, particle->rt_uv.y));
+                fillVertex(vertexindex + 3, (position + pRotMat * (halfwidth + halfheight + offset)), particle->color,
+                           particle->rt_uv);
+            }
 
-        fillTriangle(index, vertexindex, vertexindex + 1, vertexindex + 3);
-        fillTriangle(index + 3, vertexindex, vertexindex + 3, vertexindex + 2);
-
-        //_posuvcolors[vertexindex].position = (position + (- halfwidth - halfheight + halfwidth * offsetX + halfheight
-        //* offsetY)); _posuvcolors[vertexindex].color = particle->color; _posuvcolors[vertexindex].uv.set(val.x +
-        // texOffset.x, val.y + texOffset.y);
-
-        // val.set(particle->rt_uv.x - texOffset.x, particle->lb_uv.y - texOffset.y);
-        // val.set(val.x * costheta - val.y * sintheta, val.x * sintheta + val.y * costheta);
-        //_posuvcolors[vertexindex + 1].position = (position + (halfwidth - halfheight + halfwidth * offsetX +
-        // halfheight * offsetY)); _posuvcolors[vertexindex + 1].color = particle->color; _posuvcolors[vertexindex +
-        // 1].uv.set(val.x + texOffset.x, val.y + texOffset.y);
-        //
-        // val.set(particle->lb_uv.x - texOffset.x, particle->rt_uv.y - texOffset.y);
-        // val.set(val.x * costheta - val.y * sintheta, val.x * sintheta + val.y * costheta);
-        //_posuvcolors[vertexindex + 2].position = (position + (- halfwidth + halfheight + halfwidth * offsetX +
-        // halfheight * offsetY)); _posuvcolors[vertexindex + 2].color = particle->color; _posuvcolors[vertexindex +
-        // 2].uv.set(val.x + texOffset.x, val.y + texOffset.y);
-        //
-        // val.set(particle->rt_uv.x - texOffset.x, particle->rt_uv.y - texOffset.y);
-        // val.set(val.x * costheta - val.y * sintheta, val.x * sintheta + val.y * costheta);
-        //_posuvcolors[vertexindex + 3].position = (position + (halfwidth + halfheight + halfwidth * offsetX +
-        // halfheight * offsetY)); _posuvcolors[vertexindex + 3].color = particle->color; _posuvcolors[vertexindex +
-        // 3].uv.set(val.x + texOffset.x, val.y + texOffset.y);
-        //
-        //
-        //_indexData[index] = vertexindex;
-        //_indexData[index + 1] = vertexindex + 1;
-        //_indexData[index + 2] = vertexindex + 3;
-        //_indexData[index + 3] = vertexindex;
-        //_indexData[index + 4] = vertexindex + 3;
-        //_indexData[index + 5] = vertexindex + 2;
-
-        index += 6;
-        vertexindex += 4;
+            fillTriangle(index, vertexindex, vertexindex + 1, vertexindex + 3);
+            fillTriangle(index + 3, vertexindex, vertexindex + 3, vertexindex + 2);
+
+            //_posuvcolors[vertexindex].position = (position + (- halfwidth - halfheight + halfwidth * offsetX + halfheight
+            //* offsetY)); _posuvcolors[vertexindex].color = particle->color; _posuvcolors[vertexindex].uv.set(val.x +
+            // texOffset.x, val.y + texOffset.y);
+
+            // val.set(particle->rt_uv.x - texOffset.x, particle->lb_uv.y - texOffset.y);
+            // val.set(val.x * costheta - val.y * sintheta, val.x * sintheta + val.y * costheta);
+            //_posuvcolors[vertexindex + 1].position = (position + (halfwidth - halfheight + halfwidth * offsetX +
+            // halfheight * offsetY)); _posuvcolors[vertexindex + 1].color = particle->color; _posuvcolors[vertexindex +
+            // 1].uv.set(val.x + texOffset.x, val.y + texOffset.y);
+            //
+            // val.set(particle->lb_uv.x - texOffset.x, particle->rt_uv.y - texOffset.y);
+            // val.set(val.x * costheta - val.y * sintheta, val.x * sintheta + val.y * costheta);
+            //_posuvcolors[vertexindex + 2].position = (position + (- halfwidth + halfheight + halfwidth * offsetX +
+            // halfheight * offsetY)); _posuvcolors[vertexindex + 2].color = particle->color; _posuvcolors[vertexindex +
+            // 2].uv.set(val.x + texOffset.x, val.y + texOffset.y);
+            //
+            // val.set(particle->rt_uv.x - texOffset.x, particle->rt_uv.y - texOffset.y);
+            // val.set(val.x * costheta - val.y * sintheta, val.x * sintheta + val.y * costheta);
+            //_posuvcolors[vertexindex + 3].position = (position + (halfwidth + halfheight + halfwidth * offsetX +
+            // halfheight * offsetY)); _posuvcolors[vertexindex + 3].color = particle->color; _posuvcolors[vertexindex +
+            // 3].uv.set(val.x + texOffset.x, val.y + texOffset.y);
+            //
+            //
+            //_indexData[index] = vertexindex;
+            //_indexData[index + 1] = vertexindex + 1;
+            //_indexData[index + 2] = vertexindex + 3;
+            //_indexData[index + 3] = vertexindex;
+            //_indexData[index + 4] = vertexindex + 3;
+            //_indexData[index + 5] = vertexindex + 2;
+
+            index += 6;
+            vertexindex += 4;
+        }
     }
 
     _vertices.erase(_vertices.begin() + vertexindex, _vertices.end());
@@ -448,6 +461,85 @@ void PUParticle3DQuadRender::fillVertex(unsigned short index, const Vec3& pos, c
     _vertices[index].uv       = uv;
 }
 
+int PUParticle3DQuadRender::fillQuadsBatched(const ParticlePool::PoolList& particles,
+                                             const Vec3& right,
+                                             const Vec3& up,
+                                             int offsetX,
+                                             int offsetY)
+{
+    typedef PULane4 L;
+
+    _quadBatch.clear();
+    for (auto&& iter : particles)
+    {
+        auto particle = static_cast<PUParticle3D*>(iter);
+        determineUVCoords(particle);
+        _quadBatch.add(particle);
+    }
+    _quadBatch.gather(PUParticleBatch::POSITION | PUParticleBatch::COLOR | PUParticleBatch::DIMENSIONS |
+                      PUParticleBatch::ROTATION | PUParticleBatch::TEXTURE_COORDS);
+
+    const size_t count  = _quadBatch.size();
+    const size_t padded = _quadBatch.paddedSize();
+    float* cosines      = _quadBatch.getScratch(0);
+    float* sines        = _quadBatch.getScratch(1);
+    for (size_t i = 0; i < padded; ++i)
+    {
+        cosines[i] = cosf(-_quadBatch.zRotation[i]);
+        sines[i]   = sinf(-_quadBatch.zRotation[i]);
+    }
+
+    // Corner order matches the scalar path: bottom left, bottom right, top left, top right
+    static const float cornerX[4] = {-1.0f, 1.0f, -1.0f, 1.0f};
+    static const float cornerY[4] = {-1.0f, -1.0f, 1.0f, 1.0f};
+
+    const L::Type half = L::splat(0.5f);
+    const L::Type rx = L::splat(right.x), ry = L::splat(right.y), rz = L::splat(right.z);
+    const L::Type ux = L::splat(up.x), uy = L::splat(up.y), uz = L::splat(up.z);
+
+    float px[4][4], py[4][4], pz[4][4], tu[4][4], tv[4][4];
+    for (size_t i = 0; i < padded; i += 4)
+    {
+        L::Type halfWidth  = L::mul(L::load(&_quadBatch.width[i]), half);
+        L::Type halfHeight = L::mul(L::load(&_quadBatch.height[i]), half);
+        L::Type x = L::load(&_quadBatch.positionX[i]), y = L::load(&_quadBatch.positionY[i]),
+                z = L::load(&_quadBatch.positionZ[i]);
+
+        L::Type lbU = L::load(&_quadBatch.lbU[i]), lbV = L::load(&_quadBatch.lbV[i]);
+        L::Type rtU = L::load(&_quadBatch.rtU[i]), rtV = L::load(&_quadBatch.rtV[i]);
+        L::Type centerU = L::mul(L::add(lbU, rtU), half), centerV = L::mul(L::add(lbV, rtV), half);
+        L::Type cosine = L::load(&cosines[i]), sine = L::load(&sines[i]);
+
+        for (int c = 0; c < 4; ++c)
+        {
+            L::Type a = L::mul(halfWidth, L::splat(cornerX[c] + offsetX));
+            L::Type b = L::mul(halfHeight, L::splat(cornerY[c] + offsetY));
+            L::store(px[c], L::add(x, L::add(L::mul(a, rx), L::mul(b, ux))));
+            L::store(py[c], L::add(y, L::add(L::mul(a, ry), L::mul(b, uy))));
+            L::store(pz[c], L::add(z, L::add(L::mul(a, rz), L::mul(b, uz))));
+
+            L::Type du = L::sub(cornerX[c] < 0.0f ? lbU : rtU, centerU);
+            L::Type dv = L::sub(cornerY[c] < 0.0f ? lbV : rtV, centerV);
+            L::store(tu[c], L::add(L::sub(L::mul(du, cosine), L::mul(dv, sine)), centerU));
+            L::store(tv[c], L::add(L::add(L::mul(du, sine), L::mul(dv, cosine)), centerV));
+        }
+
+        const size_t lanes = std::min<size_t>(4, count - i);
+        for (size_t l = 0; l < lanes; ++l)
+        {
+            const size_t p = i + l;
+            const unsigned short vertexindex = static_cast<unsigned short>(p * 4);
+            Vec4 color(_quadBatch.colorR[p], _quadBatch.colorG[p], _quadBatch.colorB[p], _quadBatch.colorA[p]);
+            for (int c = 0; c < 4; ++c)
+                fillVertex(vertexindex + c, Vec3(px[c][l], py[c][l], pz[c][l]), color, Vec2(tu[c][l], tv[c][l]));
+
+            fillTriangle(static_cast<unsigned short>(p * 6), vertexindex, vertexindex + 1, vertexindex + 3);
+            fillTriangle(static_cast<unsigned short>(p * 6 + 3), vertexindex, vertexindex + 3, vertexindex + 2);
+        }
+    }
+    return static_cast<int>(count);
+}
+
 void PUParticle3DQuadRender::fillTriangle(unsigned short index, unsigned short v0, unsigned short v1, unsigned short v2)
 {
     _indices[index]     = v0;
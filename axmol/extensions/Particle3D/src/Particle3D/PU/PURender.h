@@ -31,6 +31,8 @@
 #include "base/Object.h"
 #include "math/Math.h"
 #include "Particle3D/Particle3DRender.h"
+#include "Particle3D/ParticleSystem3D.h"
+#include "Particle3D/PU/PUParticleBatch.h"
 #include "renderer/RenderState.h"
 #include "renderer/backend/Types.h"
 #include "renderer/backend/Buffer.h"
@@ -174,6 +176,12 @@ protected:
     void determineUVCoords(PUParticle3D* particle);
     void fillVertex(unsigned short index, const Vec3& pos, const Vec4& color, const Vec2& uv);
     void fillTriangle(unsigned short index, unsigned short v0, unsigned short v1, unsigned short v2);
+    // Fills the quads of camera facing or common oriented particles four at a time, returns the quad count
+    int fillQuadsBatched(const ParticlePool::PoolList& particles,
+                         const Vec3& right,
+                         const Vec3& up,
+                         int offsetX,
+                         int offsetY);
 
 protected:
     Type _type;
@@ -186,6 +194,8 @@ protected:
     unsigned short _textureCoordsColumns;
     float _textureCoordsRowStep;
     float _textureCoordsColStep;
+
+    PUParticleBatch _quadBatch;
 };
 
 // particle render for MeshRenderer
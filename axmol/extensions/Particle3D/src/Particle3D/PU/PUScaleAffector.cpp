@@ -26,6 +26,8 @@
 
 #include "PUScaleAffector.h"
 #include "Particle3D/PU/PUParticleSystem3D.h"
+#include "Particle3D/PU/PUParticleBatch.h"
+#include <algorithm>
 
 namespace ax
 {
@@ -262,6 +264,86 @@ void PUScaleAffector::updatePUAffector(PUParticle3D* particle, float deltaTime)
     }
 }
 
+uint32_t PUScaleAffector::getBatchFields() const
+{
+    return PUParticleBatch::DIMENSIONS | PUParticleBatch::TIME_FRACTION;
+}
+
+void PUScaleAffector::updatePUAffectorBatch(PUParticleBatch& batch, float deltaTime)
+{
+    typedef PULane4 L;
+
+    const size_t n     = batch.paddedSize();
+    const size_t count = batch.size();
+    float* scales      = batch.getScratch(1);
+
+    // Scale rate of every particle times deltaTime; the dynamic attributes are evaluated one by one
+    auto calculateScales = [&](PUDynamicAttribute* dynScale) {
+        if (_sinceStartSystem)
+        {
+            float ds = _dynamicAttributeHelper.calculate(
+                dynScale, (static_cast<PUParticleSystem3D*>(_particleSystem))->getTimeElapsedSinceStart());
+            std::fill(scales, scales + n, ds * deltaTime);
+        }
+        else
+        {
+            const float* timeFraction = batch.timeFraction.data();
+            for (size_t i = 0; i < count; ++i)
+                scales[i] = _dynamicAttributeHelper.calculate(dynScale, timeFraction[i]) * deltaTime;
+            std::fill(scales + count, scales + n, 0.0f);
+        }
+    };
+
+    // updatePUAffector passes dimension + ds * scale to setOwnDimensions, or 0 when that is not positive, and
+    // setOwnDimensions leaves a dimension given as 0 unchanged. The batch holds the resulting dimension, since later
+    // affectors read it, and scatter hands it to setOwnDimensions.
+    const L::Type zero = L::splat(0.0f);
+    auto scaleDimension = [&](float* dimension, float affectorScale) {
+        const L::Type s = L::splat(affectorScale);
+        for (size_t i = 0; i < n; i += 4)
+        {
+            L::Type d      = L::load(dimension + i);
+            L::Type scaled = L::add(d, L::mul(L::load(scales + i), s));
+            L::Type given  = L::selectGreater(scaled, zero, scaled, zero);
+            L::store(dimension + i, L::selectGreater(given, zero, given, d));
+        }
+    };
+
+    if (_dynScaleXYZSet)
+    {
+        calculateScales(_dynScaleXYZ);
+        if (const float* factors = calculateAffectSpecialisationFactors(batch))
+        {
+            for (size_t i = 0; i < n; i += 4)
+                L::store(scales + i, L::mul(L::load(scales + i), L::load(factors + i)));
+        }
+        scaleDimension(batch.width.data(), _affectorScale.x);
+        scaleDimension(batch.height.data(), _affectorScale.y);
+        scaleDimension(batch.depth.data(), _affectorScale.z);
+    }
+    else
+    {
+        // An axis whose scale is not set is given as 0 too, so its dimension stays as it is
+        if (_dynScaleXSet)
+        {
+            calculateScales(_dynScaleX);
+            scaleDimension(batch.width.data(), _affectorScale.x);
+        }
+        if (_dynScaleYSet)
+        {
+            calculateScales(_dynScaleY);
+            scaleDimension(batch.height.data(), _affectorScale.y);
+        }
+        if (_dynScaleZSet)
+        {
+            calculateScales(_dynScaleZ);
+            scaleDimension(batch.depth.data(), _affectorScale.z);
+        }
+    }
+    // Like setOwnDimensions, also when no scale is set: the dimensions become the particle's own
+    batch.markWritten(PUParticleBatch::DIMENSIONS);
+}
+
 PUScaleAffector* PUScaleAffector::create()
 {
     auto psa = new PUScaleAffector();
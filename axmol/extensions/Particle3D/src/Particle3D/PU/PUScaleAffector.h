@@ -45,6 +45,8 @@ public:
     static PUScaleAffector* create();
 
     virtual void updatePUAffector(PUParticle3D* particle, float deltaTime) override;
+    virtual uint32_t getBatchFields() const override;
+    virtual void updatePUAffectorBatch(PUParticleBatch& batch, float deltaTime) override;
 
     /**
      */
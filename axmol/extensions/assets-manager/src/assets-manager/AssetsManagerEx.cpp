@@ -24,10 +24,16 @@
  ****************************************************************************/
 #include "AssetsManagerEx.h"
 #include "EventListenerAssetsManagerEx.h"
+#include "DeltaPatch.h"
 #include "base/UTF8.h"
 #include "base/Director.h"
+#include "base/EventType.h"
+#include "base/JobSystem.h"
+#include "xxhash/xxhash.h"
 
 #include <stdio.h>
+#include <atomic>
+#include <mutex>
 
 #ifdef MINIZIP_FROM_SYSTEM
 #    include <minizip/unzip.h>
@@ -46,6 +52,10 @@ NS_AX_EXT_BEGIN
 #define BUFFER_SIZE                8192
 #define MAX_FILENAME               512
 
+#define ZIP_JOURNAL_SUFFIX         ".journal"
+#define PATCH_SUFFIX               ".patch"
+#define ZIP_RANGES_PER_THREAD      4
+
 #define DEFAULT_CONNECTION_TIMEOUT 45
 
 #define SAVE_POINT_INTERVAL        0.1
@@ -59,6 +69,23 @@ public:
     std::string zipFileName{};
 };
 
+struct AssetManagerExZipEntry
+{
+    std::string name;
+    std::string fullPath;
+    unz64_file_pos pos;
+    uint32_t crc;
+    uint64_t size;
+};
+
+// One journal line per entry completely written to disk: "crc size xxh3 name"
+struct AssetManagerExJournalRecord
+{
+    uint32_t crc;
+    uint64_t size;
+    XXH64_hash_t hash;
+};
+
 // unzip overrides to support FileStream
 long AssetManagerEx_tell_file_func(voidpf opaque, voidpf stream)
 {
@@ -386,6 +413,20 @@ void AssetsManagerEx::adjustPath(std::string& path)
     }
 }
 
+static bool AssetManagerEx_hashFile(std::string_view path, XXH3_state_t* state, char* buffer, XXH64_hash_t& hash)
+{
+    auto fsIn = FileUtils::getInstance()->openFileStream(path, IFileStream::Mode::READ);
+    if (!fsIn)
+        return false;
+
+    XXH3_64bits_reset(state);
+    int bytes;
+    while ((bytes = fsIn->read(buffer, BUFFER_SIZE)) > 0)
+        XXH3_64bits_update(state, buffer, bytes);
+    hash = XXH3_64bits_digest(state);
+    return bytes == 0;
+}
+
 bool AssetsManagerEx::decompress(std::string_view zip)
 {
     // Find root path for zip file
@@ -422,16 +463,17 @@ bool AssetsManagerEx::decompress(std::string_view zip)
         return false;
     }
 
-    // Buffer to hold data read from the zip file
-    char readBuffer[BUFFER_SIZE];
-    // Loop to extract all files.
+    // Walk the central directory once: create every directory up front and remember where each file entry
+    // lives, so the entries can be inflated independently.
+    std::vector<AssetManagerExZipEntry> entries;
+    entries.reserve(global_info.number_entry);
     uLong i;
     for (i = 0; i < global_info.number_entry; ++i)
     {
         // Get info about current file.
-        unz_file_info fileInfo;
+        unz_file_info64 fileInfo;
         char fileName[MAX_FILENAME];
-        if (unzGetCurrentFileInfo(zipfile, &fileInfo, fileName, MAX_FILENAME, NULL, 0, NULL, 0) != UNZ_OK)
+        if (unzGetCurrentFileInfo64(zipfile, &fileInfo, fileName, MAX_FILENAME, NULL, 0, NULL, 0) != UNZ_OK)
         {
             AXLOGD("AssetsManagerEx : can not read compressed file info\n");
             unzClose(zipfile);
@@ -468,64 +510,160 @@ bool AssetsManagerEx::decompress(std::string_view zip)
                     return false;
                 }
             }
-            // Entry is a file, so extract it.
-            // Open current file.
-            if (unzOpenCurrentFile(zipfile) != UNZ_OK)
+
+            AssetManagerExZipEntry entry;
+            entry.name     = fileName;
+            entry.fullPath = std::move(fullPath);
+            entry.crc      = fileInfo.crc;
+            entry.size     = fileInfo.uncompressed_size;
+            unzGetFilePos64(zipfile, &entry.pos);
+            entries.emplace_back(std::move(entry));
+        }
+
+        // Goto next entry listed in the zip file.
+        if ((i + 1) < global_info.number_entry)
+        {
+            if (unzGoToNextFile(zipfile) != UNZ_OK)
             {
-                AXLOGD("AssetsManagerEx : can not extract file {}\n", fileName);
+                AXLOGD("AssetsManagerEx : can not read next file for decompressing\n");
                 unzClose(zipfile);
                 return false;
             }
+        }
+    }
+
+    unzClose(zipfile);
+
+    // Entries written by an earlier, interrupted run of the same zip are kept when the file on disk still
+    // hashes to what the journal recorded.
+    std::string journalPath{zip};
+    journalPath += ZIP_JOURNAL_SUFFIX;
+    std::unordered_map<std::string, AssetManagerExJournalRecord> journal;
+    if (_fileUtils->isFileExist(journalPath))
+    {
+        auto content = _fileUtils->getStringFromFile(journalPath);
+        size_t lineStart = 0;
+        while (lineStart < content.size())
+        {
+            size_t lineEnd = content.find('\n', lineStart);
+            if (lineEnd == std::string::npos)
+                break;  // an incomplete last line was cut by the interruption
+
+            std::string line = content.substr(lineStart, lineEnd - lineStart);
+            lineStart        = lineEnd + 1;
+
+            unsigned int crc;
+            unsigned long long size, hash;
+            int nameStart = 0;
+            if (sscanf(line.c_str(), "%08x %llu %016llx %n", &crc, &size, &hash, &nameStart) == 3 && nameStart > 0)
+                journal[line.substr(nameStart)] = AssetManagerExJournalRecord{crc, size, hash};
+        }
+    }
+
+    auto journalOut = _fileUtils->openFileStream(journalPath, IFileStream::Mode::APPEND);
+    std::mutex journalMutex;
+    std::atomic<bool> failed{false};
+
+    // Inflate on the job system, every range through its own zip handle
+    auto jobSystem = Director::getInstance()->getJobSystem();
+    size_t grain   = entries.size() / ((jobSystem->getThreadCount() + 1) * ZIP_RANGES_PER_THREAD);
+    jobSystem->parallelFor(entries.size(), grain, [&](size_t begin, size_t end) {
+        zlib_filefunc_def_s rangeFunctionOverrides;
+        fillZipFunctionOverrides(rangeFunctionOverrides);
+
+        AssetManagerExZipFileInfo rangeFileInfo;
+        rangeFileInfo.zipFileName     = zip;
+        rangeFunctionOverrides.opaque = &rangeFileInfo;
+
+        unzFile rangeZipfile = unzOpen2(zip.data(), &rangeFunctionOverrides);
+        if (!rangeZipfile)
+        {
+            AXLOGD("AssetsManagerEx : can not open downloaded zip file {}\n", zip);
+            failed = true;
+            return;
+        }
+
+        XXH3_state_t* state = XXH3_createState();
+        // Buffer to hold data read from the zip file
+        std::unique_ptr<char[]> readBuffer(new char[BUFFER_SIZE]);
+
+        for (size_t index = begin; index < end && !failed.load(std::memory_order_relaxed); ++index)
+        {
+            auto& entry = entries[index];
+
+            auto record = journal.find(entry.name);
+            if (record != journal.end() && record->second.crc == entry.crc && record->second.size == entry.size)
+            {
+                XXH64_hash_t hash;
+                if (AssetManagerEx_hashFile(entry.fullPath, state, readBuffer.get(), hash) &&
+                    hash == record->second.hash)
+                    continue;
+            }
+
+            // Entry is a file, so extract it.
+            // Open current file.
+            if (unzGoToFilePos64(rangeZipfile, &entry.pos) != UNZ_OK || unzOpenCurrentFile(rangeZipfile) != UNZ_OK)
+            {
+                AXLOGD("AssetsManagerEx : can not extract file {}\n", entry.name);
+                failed = true;
+                break;
+            }
 
             // Create a file to store current file.
-            auto fsOut = FileUtils::getInstance()->openFileStream(fullPath, IFileStream::Mode::WRITE);
+            auto fsOut = FileUtils::getInstance()->openFileStream(entry.fullPath, IFileStream::Mode::WRITE);
             if (!fsOut)
             {
-                AXLOGD("AssetsManagerEx : can not create decompress destination file {} (errno: {})\n", fullPath,
-                      errno);
-                unzCloseCurrentFile(zipfile);
-                unzClose(zipfile);
-                return false;
+                AXLOGD("AssetsManagerEx : can not create decompress destination file {} (errno: {})\n",
+                       entry.fullPath, errno);
+                unzCloseCurrentFile(rangeZipfile);
+                failed = true;
+                break;
             }
 
-            // Write current file content to destinate file.
+            // Write current file content to destinate file, hashing it on the way for the journal.
+            XXH3_64bits_reset(state);
             int error = UNZ_OK;
             do
             {
-                error = unzReadCurrentFile(zipfile, readBuffer, BUFFER_SIZE);
-                if (error < 0)
-                {
-                    AXLOGD("AssetsManagerEx : can not read zip file {}, error code is {}\n", fileName, error);
-                    fsOut.reset();
-                    unzCloseCurrentFile(zipfile);
-                    unzClose(zipfile);
-                    return false;
-                }
-
+                error = unzReadCurrentFile(rangeZipfile, readBuffer.get(), BUFFER_SIZE);
                 if (error > 0)
                 {
-                    fsOut->write(readBuffer, error);
+                    XXH3_64bits_update(state, readBuffer.get(), error);
+                    if (fsOut->write(readBuffer.get(), (unsigned int)error) != error)
+                        error = UNZ_ERRNO;
                 }
             } while (error > 0);
 
             fsOut.reset();
-        }
 
-        unzCloseCurrentFile(zipfile);
+            // unzCloseCurrentFile checks the crc-32 of everything read against the central directory
+            if (error < 0 || unzCloseCurrentFile(rangeZipfile) != UNZ_OK)
+            {
+                AXLOGD("AssetsManagerEx : can not read zip file {}, error code is {}\n", entry.name, error);
+                if (error < 0)
+                    unzCloseCurrentFile(rangeZipfile);
+                failed = true;
+                break;
+            }
 
-        // Goto next entry listed in the zip file.
-        if ((i + 1) < global_info.number_entry)
-        {
-            if (unzGoToNextFile(zipfile) != UNZ_OK)
+            if (journalOut)
             {
-                AXLOGD("AssetsManagerEx : can not read next file for decompressing\n");
-                unzClose(zipfile);
-                return false;
+                auto line = fmt::format("{:08x} {} {:016x} {}\n", entry.crc, entry.size, XXH3_64bits_digest(state),
+                                        entry.name);
+                std::lock_guard<std::mutex> lock(journalMutex);
+                journalOut->write(line.data(), (unsigned int)line.size());
             }
         }
-    }
 
-    unzClose(zipfile);
+        XXH3_freeState(state);
+        unzClose(rangeZipfile);
+    });
+
+    journalOut.reset();
+    if (failed)
+        return false;
+
+    _fileUtils->removeFile(journalPath);
     return true;
 }
 
@@ -810,6 +948,8 @@ void AssetsManagerEx::startUpdate()
                     unit.srcUrl += path;
                     unit.storagePath = _tempStoragePath + path;
                     unit.size        = diff.asset.size;
+                    if (diff.type == Manifest::DiffType::MODIFIED)
+                        preparePatch(unit, diff.asset);
                     _downloadUnits.emplace(unit.customId, unit);
                     _tempManifest->setAssetDownloadState(it->first, Manifest::DownloadState::UNSTARTED);
                 }
@@ -859,6 +999,8 @@ void AssetsManagerEx::updateSucceed()
         }
         // Remove temp storage path
         _fileUtils->removeDirectory(_tempStoragePath);
+        // lookups keyed on paths may still point at the files that were replaced
+        _fileUtils->purgeCachedEntries();
     }
     // 3. swap the localManifest
     AX_SAFE_RELEASE(_localManifest);
@@ -867,6 +1009,8 @@ void AssetsManagerEx::updateSucceed()
     _remoteManifest = nullptr;
     // 4. make local manifest take effect
     prepareLocalManifest();
+    // files and search paths changed, caches of file contents are stale
+    _eventDispatcher->dispatchCustomEvent(EVENT_FILE_CACHE_PURGED);
     // 5. Set update state
     _updateState = State::UP_TO_DATE;
     // 6. Notify finished event
@@ -1142,8 +1286,11 @@ void AssetsManagerEx::onProgress(double total, double downloaded, std::string_vi
             // Register the download size information
             _downloadedSize.emplace(customId, downloaded);
             // Check download unit size existance, if not exist collect size in total size
-            if (_downloadUnits[customId].size == 0)
+            auto unitIt = _downloadUnits.find(customId);
+            if (unitIt != _downloadUnits.end() && unitIt->second.size == 0)
             {
+                // Remember what was collected so a patch falling back to a whole download can take it back
+                unitIt->second.size = (float)total;
                 _totalSize += total;
                 _sizeCollected++;
                 // All collected, enable total size
@@ -1182,35 +1329,171 @@ void AssetsManagerEx::onSuccess(std::string_view /*srcUrl*/, std::string_view st
     }
     else
     {
-        bool ok      = true;
-        auto& assets = _remoteManifest->getAssets();
-        auto assetIt = assets.find(customId);
-        if (assetIt != assets.end())
+        auto unitIt = _downloadUnits.find(customId);
+        if (unitIt != _downloadUnits.end() && !unitIt->second.patchBase.empty())
+            applyDownloadedPatch(customId, storagePath);
+        else
+            assetDownloaded(customId, storagePath);
+    }
+}
+
+void AssetsManagerEx::assetDownloaded(std::string_view customId, std::string_view storagePath)
+{
+    bool ok      = true;
+    auto& assets = _remoteManifest->getAssets();
+    auto assetIt = assets.find(customId);
+    if (assetIt != assets.end())
+    {
+        Manifest::Asset asset = assetIt->second;
+        if (_verifyCallback != nullptr)
         {
-            Manifest::Asset asset = assetIt->second;
-            if (_verifyCallback != nullptr)
-            {
-                ok = _verifyCallback(storagePath, asset);
-            }
+            ok = _verifyCallback(storagePath, asset);
+        }
+    }
+
+    if (ok)
+    {
+        bool compressed = assetIt != assets.end() ? assetIt->second.compressed : false;
+        if (compressed)
+        {
+            decompressDownloadedZip(customId, storagePath);
+        }
+        else
+        {
+            fileSuccess(customId, storagePath);
+        }
+    }
+    else
+    {
+        fileError(customId, "Asset file verification failed after downloaded");
+    }
+}
+
+void AssetsManagerEx::preparePatch(DownloadUnit& unit, const Manifest::Asset& asset)
+{
+    // Archives are not kept once extracted, so there is nothing to patch
+    if (asset.patchPath.empty() || asset.compressed)
+        return;
+
+    auto& localAssets = _localManifest->getAssets();
+    auto localIt      = localAssets.find(unit.customId);
+    if (localIt == localAssets.end() || localIt->second.md5 != asset.patchFrom)
+        return;
+
+    // The installed copy comes from a previous update, or else ships with the app
+    std::string basePath = _localManifest->_manifestRoot + localIt->second.path;
+    if (!_fileUtils->isFileExist(basePath))
+        basePath = _fileUtils->fullPathForFilename(localIt->second.path);
+    if (basePath.empty())
+        return;
+
+    unit.patchBase = std::move(basePath);
+    unit.srcUrl    = _remoteManifest->getPackageUrl();
+    unit.srcUrl += asset.patchPath;
+    unit.storagePath += PATCH_SUFFIX;
+    // Progress counts the bytes actually transferred, so the delta stands in for the asset in the total size,
+    // when the manifest does not give it it is collected from the first progress notification
+    unit.size = asset.patchSize;
+}
+
+void AssetsManagerEx::applyDownloadedPatch(std::string_view customId, std::string_view deltaPath)
+{
+    struct AsyncData
+    {
+        std::string customId;
+        std::string basePath;
+        std::string deltaPath;
+        std::string targetPath;
+        DeltaPatch::Result result;
+    };
+
+    auto unitIt = _downloadUnits.find(customId);
+    if (unitIt == _downloadUnits.end())
+    {
+        _fileUtils->removeFile(deltaPath);
+        fileError(customId, "Asset patch downloaded for an unknown download unit");
+        return;
+    }
+
+    AsyncData* asyncData  = new AsyncData;
+    asyncData->customId   = customId;
+    asyncData->basePath   = unitIt->second.patchBase;
+    asyncData->deltaPath  = deltaPath;
+    asyncData->targetPath = deltaPath.substr(0, deltaPath.size() - (sizeof(PATCH_SUFFIX) - 1));
+    asyncData->result     = DeltaPatch::Result::IO_ERROR;
+
+    Director::getInstance()->getJobSystem()->enqueue(
+        [this, asyncData]() {
+        auto fsBase  = _fileUtils->openFileStream(asyncData->basePath, IFileStream::Mode::READ);
+        auto fsDelta = _fileUtils->openFileStream(asyncData->deltaPath, IFileStream::Mode::READ);
+        auto fsOut   = _fileUtils->openFileStream(asyncData->targetPath, IFileStream::Mode::WRITE);
+        if (fsBase && fsDelta && fsOut)
+        {
+            asyncData->result = DeltaPatch::apply(
+                [&fsBase](uint64_t offset, void* buf, uint32_t size) -> int64_t {
+                return fsBase->seek((int64_t)offset, SEEK_SET) < 0 ? -1 : fsBase->read(buf, size);
+            },
+                (uint64_t)fsBase->size(),
+                [&fsDelta](void* buf, uint32_t size) -> int64_t { return fsDelta->read(buf, size); },
+                [&fsOut](const void* buf, uint32_t size) { return fsOut->write(buf, size) == (int)size; });
         }
+        fsBase.reset();
+        fsDelta.reset();
+        fsOut.reset();
 
-        if (ok)
+        _fileUtils->removeFile(asyncData->deltaPath);
+        if (asyncData->result != DeltaPatch::Result::OK)
+            _fileUtils->removeFile(asyncData->targetPath);
+    },
+        [this, asyncData]() {
+        if (asyncData->result == DeltaPatch::Result::OK)
         {
-            bool compressed = assetIt != assets.end() ? assetIt->second.compressed : false;
-            if (compressed)
+            assetDownloaded(asyncData->customId, asyncData->targetPath);
+        }
+        else
+        {
+            AXLOGD("AssetsManagerEx : can not patch {} (error {}), downloading the whole file\n", asyncData->customId,
+                   (int)asyncData->result);
+
+            // Requeue the asset as a whole file download in place of the delta
+            auto& assets = _remoteManifest->getAssets();
+            auto assetIt = assets.find(asyncData->customId);
+            auto unitIt  = _downloadUnits.find(asyncData->customId);
+            if (assetIt != assets.end() && unitIt != _downloadUnits.end())
             {
-                decompressDownloadedZip(customId, storagePath);
+                DownloadUnit& unit = unitIt->second;
+                unit.patchBase.clear();
+                unit.srcUrl = _remoteManifest->getPackageUrl();
+                unit.srcUrl += assetIt->second.path;
+                unit.storagePath = asyncData->targetPath;
+
+                // Swap the delta for the whole asset in the total size, and forget the delta bytes so progress
+                // restarts from zero for this asset
+                if (unit.size > 0)
+                {
+                    _totalSize -= unit.size;
+                    _sizeCollected--;
+                }
+                unit.size = assetIt->second.size;
+                if (unit.size > 0)
+                {
+                    _totalSize += unit.size;
+                    _sizeCollected++;
+                }
+                _totalEnabled = _sizeCollected == _totalToDownload;
+                _downloadedSize.erase(unit.customId);
+
+                _queue.emplace_back(unit.customId);
+                _currConcurrentTask = MAX(0, _currConcurrentTask - 1);
+                queueDowload();
             }
             else
             {
-                fileSuccess(customId, storagePath);
+                fileError(asyncData->customId, "Asset patch failed to apply");
             }
         }
-        else
-        {
-            fileError(customId, "Asset file verification failed after downloaded");
-        }
-    }
+        delete asyncData;
+    });
 }
 
 void AssetsManagerEx::destroyDownloadedVersion()
@@ -169,6 +169,16 @@ protected:
     bool decompress(std::string_view filename);
     void decompressDownloadedZip(std::string_view customId, std::string_view storagePath);
 
+    /** @brief Turns the download of a modified asset into a delta download when the remote manifest carries a
+     * patch from the installed version.
+     */
+    void preparePatch(DownloadUnit& unit, const Manifest::Asset& asset);
+    /** @brief Rebuilds the asset from its installed version and the downloaded delta, falling back to a whole
+     * download when the installed file is not the one the delta was made against.
+     */
+    void applyDownloadedPatch(std::string_view customId, std::string_view deltaPath);
+    void assetDownloaded(std::string_view customId, std::string_view storagePath);
+
     /** @brief Update a list of assets under the current AssetsManagerEx context
      */
     void updateAssets(const DownloadUnits& assets);
@@ -0,0 +1,318 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "DeltaPatch.h"
+#include "xxhash/xxhash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+
+NS_AX_EXT_BEGIN
+
+namespace
+{
+enum : uint8_t
+{
+    OP_END  = 0,
+    OP_COPY = 1,
+    OP_ADD  = 2,
+};
+
+constexpr uint32_t CHUNK_SIZE = 64 * 1024;
+// Granularity of base matches: smaller finds more of them, larger keeps the index and the delta smaller
+constexpr size_t BLOCK_SIZE = 32;
+
+using XXH3StatePtr = std::unique_ptr<XXH3_state_t, decltype(&XXH3_freeState)>;
+
+void putLE(std::vector<uint8_t>& out, uint64_t value, int bytes)
+{
+    for (int i = 0; i < bytes; ++i)
+        out.push_back(uint8_t(value >> (i * 8)));
+}
+
+uint64_t getLE(const uint8_t* p, int bytes)
+{
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; ++i)
+        value |= uint64_t(p[i]) << (i * 8);
+    return value;
+}
+
+void putVarint(std::vector<uint8_t>& out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back(uint8_t(value) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(uint8_t(value));
+}
+
+// rsync style weak checksum, cheap to slide one byte at a time
+struct RollingChecksum
+{
+    uint32_t a = 0;
+    uint32_t b = 0;
+
+    void reset(const uint8_t* p)
+    {
+        a = b = 0;
+        for (size_t i = 0; i < BLOCK_SIZE; ++i)
+        {
+            a += p[i];
+            b += uint32_t(BLOCK_SIZE - i) * p[i];
+        }
+    }
+
+    void roll(uint8_t out, uint8_t in)
+    {
+        a = a - out + in;
+        b = b - uint32_t(BLOCK_SIZE) * out + a;
+    }
+
+    uint32_t key() const { return (a & 0xffff) | (b << 16); }
+};
+
+// Buffered sequential reads over the delta
+class DeltaStream
+{
+public:
+    explicit DeltaStream(const DeltaPatch::DeltaReader& reader) : _reader(reader), _buffer(CHUNK_SIZE) {}
+
+    bool read(void* dst, size_t size)
+    {
+        auto out = static_cast<uint8_t*>(dst);
+        while (size > 0)
+        {
+            if (_pos == _end && !fill())
+                return false;
+            size_t n = (std::min)(size, _end - _pos);
+            memcpy(out, _buffer.data() + _pos, n);
+            _pos += n;
+            out += n;
+            size -= n;
+        }
+        return true;
+    }
+
+    bool readVarint(uint64_t& value)
+    {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            uint8_t byte;
+            if (!read(&byte, 1))
+                return false;
+            value |= uint64_t(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+                return true;
+        }
+        return false;
+    }
+
+private:
+    bool fill()
+    {
+        int64_t got = _reader(_buffer.data(), CHUNK_SIZE);
+        if (got <= 0)
+            return false;
+        _pos = 0;
+        _end = size_t(got);
+        return true;
+    }
+
+    const DeltaPatch::DeltaReader& _reader;
+    std::vector<uint8_t> _buffer;
+    size_t _pos = 0;
+    size_t _end = 0;
+};
+}  // namespace
+
+DeltaPatch::Result DeltaPatch::apply(const BaseReader& base,
+                                     uint64_t baseSize,
+                                     const DeltaReader& delta,
+                                     const TargetWriter& target)
+{
+    DeltaStream stream(delta);
+
+    uint8_t header[HEADER_SIZE];
+    if (!stream.read(header, HEADER_SIZE) || getLE(header, 4) != MAGIC || getLE(header + 4, 4) != VERSION)
+        return Result::BAD_DELTA;
+
+    const uint64_t expectedBaseSize = getLE(header + 8, 8);
+    const uint64_t baseHash         = getLE(header + 16, 8);
+    const uint64_t targetSize       = getLE(header + 24, 8);
+    const uint64_t targetHash       = getLE(header + 32, 8);
+    if (expectedBaseSize != baseSize)
+        return Result::BASE_MISMATCH;
+
+    std::vector<uint8_t> buffer(CHUNK_SIZE);
+    XXH3StatePtr state(XXH3_createState(), &XXH3_freeState);
+
+    // The base is checked as a whole before anything is written
+    XXH3_64bits_reset(state.get());
+    for (uint64_t offset = 0; offset < baseSize;)
+    {
+        uint32_t n = uint32_t((std::min)(baseSize - offset, uint64_t(CHUNK_SIZE)));
+        if (base(offset, buffer.data(), n) != n)
+            return Result::IO_ERROR;
+        XXH3_64bits_update(state.get(), buffer.data(), n);
+        offset += n;
+    }
+    if (XXH3_64bits_digest(state.get()) != baseHash)
+        return Result::BASE_MISMATCH;
+
+    XXH3_64bits_reset(state.get());
+    uint64_t written = 0;
+    for (;;)
+    {
+        uint8_t op;
+        if (!stream.read(&op, 1))
+            return Result::BAD_DELTA;
+        if (op == OP_END)
+            break;
+
+        uint64_t offset = 0, length;
+        if (op != OP_COPY && op != OP_ADD)
+            return Result::BAD_DELTA;
+        if ((op == OP_COPY && !stream.readVarint(offset)) || !stream.readVarint(length))
+            return Result::BAD_DELTA;
+        if (op == OP_COPY && (offset > baseSize || length > baseSize - offset))
+            return Result::BAD_DELTA;
+        if (length > targetSize - written)
+            return Result::TARGET_MISMATCH;
+
+        while (length > 0)
+        {
+            uint32_t n = uint32_t((std::min)(length, uint64_t(CHUNK_SIZE)));
+            if (op == OP_COPY)
+            {
+                if (base(offset, buffer.data(), n) != n)
+                    return Result::IO_ERROR;
+                offset += n;
+            }
+            else if (!stream.read(buffer.data(), n))
+                return Result::BAD_DELTA;
+
+            XXH3_64bits_update(state.get(), buffer.data(), n);
+            if (!target(buffer.data(), n))
+                return Result::IO_ERROR;
+            written += n;
+            length -= n;
+        }
+    }
+
+    if (written != targetSize || XXH3_64bits_digest(state.get()) != targetHash)
+        return Result::TARGET_MISMATCH;
+    return Result::OK;
+}
+
+std::vector<uint8_t> DeltaPatch::create(const uint8_t* base, size_t baseSize, const uint8_t* target, size_t targetSize)
+{
+    std::vector<uint8_t> out;
+    putLE(out, MAGIC, 4);
+    putLE(out, VERSION, 4);
+    putLE(out, baseSize, 8);
+    putLE(out, XXH3_64bits(base, baseSize), 8);
+    putLE(out, targetSize, 8);
+    putLE(out, XXH3_64bits(target, targetSize), 8);
+
+    auto emitLiteral = [&](size_t begin, size_t end) {
+        if (begin == end)
+            return;
+        out.push_back(OP_ADD);
+        putVarint(out, end - begin);
+        out.insert(out.end(), target + begin, target + end);
+    };
+
+    // Index the aligned blocks of the base, the first occurrence of a checksum wins
+    std::unordered_map<uint32_t, size_t> blocks;
+    RollingChecksum checksum;
+    for (size_t offset = 0; offset + BLOCK_SIZE <= baseSize; offset += BLOCK_SIZE)
+    {
+        checksum.reset(base + offset);
+        blocks.emplace(checksum.key(), offset);
+    }
+
+    size_t literalStart = 0;
+    size_t copyEnd      = 0;  // base offset following the last copy
+    size_t i            = 0;
+    bool rolling        = false;
+    while (i + BLOCK_SIZE <= targetSize)
+    {
+        size_t match = SIZE_MAX;
+
+        // Bytes patched in place keep the target aligned with the base, so try the continuation of the last copy
+        size_t guess = copyEnd + (i - literalStart);
+        if (guess + BLOCK_SIZE <= baseSize && memcmp(base + guess, target + i, BLOCK_SIZE) == 0)
+            match = guess;
+        else
+        {
+            if (!rolling)
+            {
+                checksum.reset(target + i);
+                rolling = true;
+            }
+            auto it = blocks.find(checksum.key());
+            if (it != blocks.end() && memcmp(base + it->second, target + i, BLOCK_SIZE) == 0)
+                match = it->second;
+        }
+
+        if (match == SIZE_MAX)
+        {
+            if (i + BLOCK_SIZE < targetSize)
+                checksum.roll(target[i], target[i + BLOCK_SIZE]);
+            ++i;
+            continue;
+        }
+
+        // Grow the match backwards into the pending literal and forwards as far as the bytes agree
+        while (i > literalStart && match > 0 && base[match - 1] == target[i - 1])
+        {
+            --i;
+            --match;
+        }
+        size_t length = BLOCK_SIZE;
+        while (i + length < targetSize && match + length < baseSize && base[match + length] == target[i + length])
+            ++length;
+
+        emitLiteral(literalStart, i);
+        out.push_back(OP_COPY);
+        putVarint(out, match);
+        putVarint(out, length);
+
+        i += length;
+        literalStart = i;
+        copyEnd      = match + length;
+        rolling      = false;
+    }
+
+    emitLiteral(literalStart, targetSize);
+    out.push_back(OP_END);
+    return out;
+}
+
+NS_AX_EXT_END
@@ -0,0 +1,75 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "extensions/ExtensionMacros.h"
+
+NS_AX_EXT_BEGIN
+
+/**
+ * @brief Binary delta between two versions of a file, applied while streaming.
+ *
+ * A delta is a header holding the size and XXH3 hash of both the base and the target, followed by
+ * instructions with varint operands: COPY a range of the base, ADD literal bytes, END.
+ * Applying checks the base against the header before writing anything and the target while it is written,
+ * so a delta built against another version of the file is rejected instead of producing garbage.
+ */
+class DeltaPatch
+{
+public:
+    static constexpr uint32_t MAGIC       = 0x50445841;  // "AXDP"
+    static constexpr uint32_t VERSION     = 1;
+    static constexpr uint32_t HEADER_SIZE = 40;
+
+    enum class Result
+    {
+        OK,
+        BAD_DELTA,
+        BASE_MISMATCH,
+        TARGET_MISMATCH,
+        IO_ERROR
+    };
+
+    //! Reads size bytes of the base at offset into buf, returns the number of bytes read
+    using BaseReader = std::function<int64_t(uint64_t offset, void* buf, uint32_t size)>;
+    //! Reads up to size bytes of the delta into buf, returns the number of bytes read, 0 at the end
+    using DeltaReader = std::function<int64_t(void* buf, uint32_t size)>;
+    //! Appends size bytes to the target, returns false on failure
+    using TargetWriter = std::function<bool(const void* buf, uint32_t size)>;
+
+    /** @brief Rebuilds the target from the base and the delta, streaming in fixed-size chunks.
+     */
+    static Result apply(const BaseReader& base, uint64_t baseSize, const DeltaReader& delta, const TargetWriter& target);
+
+    /** @brief Builds the delta turning base into target, matching blocks of the base with a rolling checksum.
+     */
+    static std::vector<uint8_t> create(const uint8_t* base, size_t baseSize, const uint8_t* target, size_t targetSize);
+};
+
+NS_AX_EXT_END
@@ -47,6 +47,8 @@
 #define KEY_SIZE "size"
 #define KEY_COMPRESSED_FILE "compressedFile"
 #define KEY_DOWNLOAD_STATE "downloadState"
+#define KEY_PATCH "patch"
+#define KEY_PATCH_FROM "from"
 
 NS_AX_EXT_BEGIN
 
@@ -451,6 +453,20 @@ Manifest::Asset Manifest::parseAsset(std::string_view path, const rapidjson::Val
     else
         asset.downloadState = DownloadState::UNMARKED;
 
+    asset.patchSize = 0;
+    if (json.HasMember(KEY_PATCH) && json[KEY_PATCH].IsObject())
+    {
+        const rapidjson::Value& patch = json[KEY_PATCH];
+        if (patch.HasMember(KEY_PATCH_FROM) && patch[KEY_PATCH_FROM].IsString() && patch.HasMember(KEY_PATH) &&
+            patch[KEY_PATH].IsString())
+        {
+            asset.patchFrom = patch[KEY_PATCH_FROM].GetString();
+            asset.patchPath = patch[KEY_PATH].GetString();
+            if (patch.HasMember(KEY_SIZE) && patch[KEY_SIZE].IsInt())
+                asset.patchSize = patch[KEY_SIZE].GetInt();
+        }
+    }
+
     return asset;
 }
 
@@ -46,6 +46,8 @@ struct DownloadUnit
     std::string storagePath;
     std::string customId;
     float size;
+    //! Installed file the download is a delta against, empty for whole files
+    std::string patchBase;
 };
 
 struct ManifestAsset
@@ -55,6 +57,10 @@ struct ManifestAsset
     bool compressed;
     float size;
     int downloadState;
+    //! Optional binary delta (see DeltaPatch) from the version whose md5 is patchFrom
+    std::string patchFrom;
+    std::string patchPath;
+    float patchSize;
 };
 
 typedef hlookup::string_map<DownloadUnit> DownloadUnits;
@@ -30,6 +30,10 @@
 #include "base/ObjectFactory.h"
 #include "base/Director.h"
 #include "base/UTF8.h"
+#include "base/JobSystem.h"
+#include "base/EventDispatcher.h"
+#include "base/EventListenerCustom.h"
+#include "base/EventType.h"
 #include "ui/CocosGUI.h"
 #include "2d/SpriteFrameCache.h"
 #include "2d/ParticleSystemQuad.h"
@@ -95,6 +99,7 @@
 #include "cocostudio/WidgetCallBackHandlerProtocol.h"
 
 #include <fstream>
+#include <chrono>
 
 using namespace ax::ui;
 using namespace cocostudio;
@@ -198,6 +203,11 @@ CSLoader* CSLoader::getInstance()
 
 void CSLoader::destroyInstance()
 {
+    if (_sharedCSLoader)
+    {
+        Director::getInstance()->getScheduler()->unscheduleAllForTarget(_sharedCSLoader);
+        Director::getInstance()->getEventDispatcher()->removeEventListener(_sharedCSLoader->_purgeListener);
+    }
     AX_SAFE_DELETE(_sharedCSLoader);
     ActionTimelineCache::destroyInstance();
 }
@@ -256,6 +266,10 @@ void CSLoader::init()
 {
     using namespace std::placeholders;
 
+    // cached .csb bytes go stale when the files behind their paths change, e.g. after a hot update
+    _purgeListener = Director::getInstance()->getEventDispatcher()->addCustomEventListener(
+        EVENT_FILE_CACHE_PURGED, [this](EventCustom*) { removeAllPrefabs(); });
+
     _funcs.insert(Pair(ClassName_Node, std::bind(&CSLoader::loadSimpleNode, this, _1)));
     _funcs.insert(Pair(ClassName_SubGraph, std::bind(&CSLoader::loadSubGraph, this, _1)));
     _funcs.insert(Pair(ClassName_Sprite, std::bind(&CSLoader::loadSprite, this, _1)));
@@ -984,6 +998,208 @@ Node* CSLoader::createNodeWithFlatBuffersFile(std::string_view filename, const c
     return node;
 }
 
+struct CSLoader::AsyncBuild
+{
+    struct Frame
+    {
+        const flatbuffers::NodeTree* nodetree;
+        Node* node;
+        int next;
+    };
+
+    ~AsyncBuild()
+    {
+        for (auto& frame : stack)
+            frame.node->release();
+    }
+
+    std::string fullPath;
+    std::shared_ptr<Data> prefab;
+    std::function<void(Node*)> callback;
+    float budget;
+
+    std::vector<std::string> plists;
+    std::vector<std::string> texturePaths;
+    int pendingTextures = 0;
+
+    // nodes under construction, retained until attached to their parent
+    std::vector<Frame> stack;
+    bool started = false;
+
+    // callback handler state of this build, swapped with the loader's around every slice
+    Node* rootNode = nullptr;
+    ax::Vector<ax::Node*> callbackHandlers;
+};
+
+void CSLoader::createNodeAsync(std::string_view filename, const std::function<void(Node*)>& callback, float budget)
+{
+    auto build      = std::make_shared<AsyncBuild>();
+    build->fullPath = FileUtils::getInstance()->fullPathForFilename(filename);
+    build->callback = callback;
+    build->budget   = budget;
+
+    if (build->fullPath.empty())
+    {
+        AXLOGD("CSLoader::createNodeAsync - file not found: {}", filename);
+        if (callback)
+            callback(nullptr);
+        return;
+    }
+
+    build->prefab = CSLoader::getInstance()->getPrefab(build->fullPath);
+    if (build->prefab)
+    {
+        CSLoader::getInstance()->prefetchAsyncBuild(build);
+        return;
+    }
+
+    auto data = std::make_shared<Data>();
+    Director::getInstance()->getJobSystem()->enqueue(
+        [build, data] { *data = FileUtils::getInstance()->getDataFromFile(build->fullPath); }, [build, data] {
+            if (data->isNull())
+            {
+                AXLOGD("CSLoader::createNodeAsync - failed read file: {}", build->fullPath);
+                if (build->callback)
+                    build->callback(nullptr);
+                return;
+            }
+
+            auto loader = CSLoader::getInstance();
+
+            // a synchronous load may have cached the file meanwhile
+            build->prefab = loader->getPrefab(build->fullPath);
+            if (!build->prefab)
+            {
+                loader->checkBuildId(GetCSParseBinary(data->getBytes()));
+                build->prefab = loader->addPrefab(build->fullPath, std::move(*data));
+            }
+            loader->prefetchAsyncBuild(build);
+        });
+}
+
+void CSLoader::prefetchAsyncBuild(std::shared_ptr<AsyncBuild> build)
+{
+    // FileUtils only resolves paths on the main thread, the workers get absolute ones
+    auto textures   = GetCSParseBinary(build->prefab->getBytes())->textures();
+    int textureSize = textures->size();
+    for (int i = 0; i < textureSize; ++i)
+    {
+        std::string_view plist = textures->Get(i)->c_str();
+        if (!SpriteFrameCache::getInstance()->isSpriteFramesWithFileLoaded(plist))
+            build->plists.emplace_back(FileUtils::getInstance()->fullPathForFilename(plist));
+    }
+
+    // resolve the sheet textures like PlistSpriteSheetLoader, then decode them on the texture cache's thread so
+    // loadPrefabTextures only finds cached textures
+    Director::getInstance()->getJobSystem()->enqueue(
+        [build] {
+            for (auto& plist : build->plists)
+            {
+                if (plist.empty())
+                    continue;
+
+                auto dict = FileUtils::getInstance()->getValueMapFromFile(plist);
+                std::string texturePath;
+                auto metadata = dict.find("metadata");
+                if (metadata != dict.end())
+                    texturePath = metadata->second.asValueMap()["textureFileName"].asString();
+
+                if (!texturePath.empty())
+                    texturePath = FileUtils::getInstance()->fullPathFromRelativeFile(texturePath, plist);
+                else
+                    texturePath = plist.substr(0, plist.find_last_of('.')).append(".png");
+                build->texturePaths.emplace_back(std::move(texturePath));
+            }
+        },
+        [build] {
+            // one extra count so callbacks fired synchronously for cached textures cannot start early
+            build->pendingTextures = (int)build->texturePaths.size() + 1;
+            auto onTexture         = [build](Texture2D*) {
+                if (--build->pendingTextures > 0)
+                    return;
+
+                auto loader = CSLoader::getInstance();
+                loader->loadPrefabTextures(GetCSParseBinary(build->prefab->getBytes()));
+                Director::getInstance()->getScheduler()->schedule(
+                    [build](float) { CSLoader::getInstance()->stepAsyncBuild(build); }, loader, 0, false,
+                    fmt::format("CSLoader::createNodeAsync#{}", fmt::ptr(build.get())));
+            };
+            for (auto& texturePath : build->texturePaths)
+                Director::getInstance()->getTextureCache()->addImageAsync(texturePath, onTexture);
+            onTexture(nullptr);
+        });
+}
+
+void CSLoader::stepAsyncBuild(std::shared_ptr<AsyncBuild> build)
+{
+    std::swap(_rootNode, build->rootNode);
+    std::swap(_callbackHandlers, build->callbackHandlers);
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<float>(build->budget);
+
+    Node* root = nullptr;
+    bool done  = false;
+    do
+    {
+        if (!build->started)
+        {
+            build->started = true;
+            auto nodetree  = GetCSParseBinary(build->prefab->getBytes())->nodeTree();
+            Node* node     = nodeWithFlatBuffersNoChildren(nodetree, nullptr);
+            if (!node)
+            {
+                done = true;
+                break;
+            }
+            node->retain();
+            build->stack.push_back({nodetree, node, 0});
+            continue;
+        }
+
+        auto& frame   = build->stack.back();
+        auto children = frame.nodetree->children();
+        if (frame.next < (int)children->size())
+        {
+            auto subNodeTree = children->Get(frame.next++);
+            Node* child      = nodeWithFlatBuffersNoChildren(subNodeTree, nullptr);
+            if (child)
+            {
+                child->retain();
+                build->stack.push_back({subNodeTree, child, 0});
+            }
+            continue;
+        }
+
+        // every child of the top node is built, attach it to its parent
+        Node* node = frame.node;
+        build->stack.pop_back();
+        if (build->stack.empty())
+        {
+            root = node;
+            done = true;
+            break;
+        }
+        addChildWithFlatBuffers(build->stack.back().node, node, nullptr);
+        node->release();
+    } while (std::chrono::steady_clock::now() < deadline);
+
+    if (done)
+        reconstructNestNode(root);
+
+    std::swap(_rootNode, build->rootNode);
+    std::swap(_callbackHandlers, build->callbackHandlers);
+
+    if (done)
+    {
+        Director::getInstance()->getScheduler()->unschedule(
+            fmt::format("CSLoader::createNodeAsync#{}", fmt::ptr(build.get())), this);
+        if (root)
+            root->autorelease();
+        if (build->callback)
+            build->callback(root);
+    }
+}
+
 inline void CSLoader::reconstructNestNode(ax::Node* node)
 {
     /* To reconstruct nest node as WidgetCallBackHandlerProtocol. */
@@ -1013,19 +1229,61 @@ Node* CSLoader::nodeWithFlatBuffersFile(std::string_view fileName, const ccNodeL
 {
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(fileName);
 
-    AX_ASSERT(FileUtils::getInstance()->isFileExist(fullPath));
+    auto buf = getPrefab(fullPath);
+    if (!buf)
+    {
+        AX_ASSERT(FileUtils::getInstance()->isFileExist(fullPath));
 
-    Data buf = FileUtils::getInstance()->getDataFromFile(fullPath);
+        Data data = FileUtils::getInstance()->getDataFromFile(fullPath);
 
-    if (buf.isNull())
-    {
-        AXLOGD("CSLoader::nodeWithFlatBuffersFile - failed read file: {}", fileName);
-        AX_ASSERT(false);
-        return nullptr;
+        if (data.isNull())
+        {
+            AXLOGD("CSLoader::nodeWithFlatBuffersFile - failed read file: {}", fileName);
+            AX_ASSERT(false);
+            return nullptr;
+        }
+
+        checkBuildId(GetCSParseBinary(data.getBytes()));
+        buf = addPrefab(fullPath, std::move(data));
     }
 
-    auto csparsebinary = GetCSParseBinary(buf.getBytes());
+    auto csparsebinary = GetCSParseBinary(buf->getBytes());
+
+    loadPrefabTextures(csparsebinary);
+
+    Node* node = nodeWithFlatBuffers(csparsebinary->nodeTree(), callback);
+
+    return node;
+}
+
+std::shared_ptr<Data> CSLoader::getPrefab(std::string_view fullPath)
+{
+    auto it = _prefabs.find(std::string{fullPath});
+    if (it != _prefabs.end())
+        return it->second;
+    return nullptr;
+}
+
+std::shared_ptr<Data> CSLoader::addPrefab(std::string_view fullPath, Data&& data)
+{
+    auto prefab = std::make_shared<Data>(std::move(data));
+    if (!prefab->isNull())
+        _prefabs[std::string{fullPath}] = prefab;
+    return prefab;
+}
 
+void CSLoader::removePrefab(std::string_view filename)
+{
+    _prefabs.erase(FileUtils::getInstance()->fullPathForFilename(filename));
+}
+
+void CSLoader::removeAllPrefabs()
+{
+    _prefabs.clear();
+}
+
+void CSLoader::checkBuildId(const flatbuffers::CSParseBinary* csparsebinary)
+{
     auto csBuildId = csparsebinary->version();
     if (csBuildId)
     {
@@ -1073,10 +1331,12 @@ Node* CSLoader::nodeWithFlatBuffersFile(std::string_view fileName, const ccNodeL
                 fmt::format("error: The csloader version not match, require version is:{}, but {} provided!",
                                     csBuildId->c_str(), _csBuildID);
             throw std::logic_error(exceptionMsg.c_str());
-            return nullptr;
         }
     }
+}
 
+void CSLoader::loadPrefabTextures(const flatbuffers::CSParseBinary* csparsebinary)
+{
     // decode plist
     auto textures   = csparsebinary->textures();
     int textureSize = textures->size();
@@ -1088,10 +1348,6 @@ Node* CSLoader::nodeWithFlatBuffersFile(std::string_view fileName, const ccNodeL
             SpriteFrameCache::getInstance()->addSpriteFramesWithFile(plist);
         }
     }
-
-    Node* node = nodeWithFlatBuffers(csparsebinary->nodeTree(), callback);
-
-    return node;
 }
 
 Node* CSLoader::nodeWithFlatBuffers(const flatbuffers::NodeTree* nodetree)
@@ -1100,6 +1356,51 @@ Node* CSLoader::nodeWithFlatBuffers(const flatbuffers::NodeTree* nodetree)
 }
 
 Node* CSLoader::nodeWithFlatBuffers(const flatbuffers::NodeTree* nodetree, const ccNodeLoadCallback& callback)
+{
+    Node* node = nodeWithFlatBuffersNoChildren(nodetree, callback);
+
+    // If node is invalid, there is no necessity to process children of node.
+    if (!node)
+    {
+        return nullptr;
+    }
+
+    auto children = nodetree->children();
+    int size      = children->size();
+    for (int i = 0; i < size; ++i)
+    {
+        auto subNodeTree = children->Get(i);
+        Node* child      = nodeWithFlatBuffers(subNodeTree, callback);
+        if (child)
+        {
+            addChildWithFlatBuffers(node, child, callback);
+        }
+    }
+
+    return node;
+}
+
+NodeReaderProtocol* CSLoader::getNodeReader(const std::string& classname)
+{
+    auto it = _nodeReaders.find(classname);
+    if (it != _nodeReaders.end())
+        return it->second;
+
+    std::string readername{getGUIClassName(classname)};
+    readername.append("Reader");
+
+    NodeReaderProtocol* reader =
+        dynamic_cast<NodeReaderProtocol*>(ObjectFactory::getInstance()->createObject(readername));
+    if (reader == nullptr)
+        reader = dynamic_cast<NodeReaderProtocol*>(
+            ObjectFactory::getInstance()->createObject("CustomRootNodeReader"));
+    if (reader != nullptr)
+        _nodeReaders.emplace(classname, reader);
+
+    return reader;
+}
+
+Node* CSLoader::nodeWithFlatBuffersNoChildren(const flatbuffers::NodeTree* nodetree, const ccNodeLoadCallback& callback)
 {
     if (nodetree == nullptr)
         return nullptr;
@@ -1120,9 +1421,12 @@ Node* CSLoader::nodeWithFlatBuffers(const flatbuffers::NodeTree* nodetree, const
             cocostudio::timeline::ActionTimeline* action = nullptr;
             if (!filePath.empty() && FileUtils::getInstance()->isFileExist(filePath))
             {
-                Data buf = FileUtils::getInstance()->getDataFromFile(filePath);
-                node     = createNode(buf, callback);
-                action   = createTimeline(buf, filePath);
+                std::string fullPath = FileUtils::getInstance()->fullPathForFilename(filePath);
+                auto buf             = getPrefab(fullPath);
+                if (!buf)
+                    buf = addPrefab(fullPath, FileUtils::getInstance()->getDataFromFile(fullPath));
+                node   = createNode(*buf, callback);
+                action = createTimeline(*buf, filePath);
             }
             else
             {
@@ -1155,14 +1459,7 @@ Node* CSLoader::nodeWithFlatBuffers(const flatbuffers::NodeTree* nodetree, const
             {
                 classname = customClassName;
             }
-            std::string readername{getGUIClassName(classname)};
-            readername.append("Reader");
-
-            NodeReaderProtocol* reader =
-                dynamic_cast<NodeReaderProtocol*>(ObjectFactory::getInstance()->createObject(readername));
-            if (reader == nullptr)
-                reader = dynamic_cast<NodeReaderProtocol*>(
-                    ObjectFactory::getInstance()->createObject("CustomRootNodeReader"));
+            NodeReaderProtocol* reader = getNodeReader(classname);
             if (reader != nullptr)
             {
                 if (!customClassName.empty())
@@ -1172,6 +1469,8 @@ Node* CSLoader::nodeWithFlatBuffers(const flatbuffers::NodeTree* nodetree, const
             }
             else
             {
+                std::string readername{getGUIClassName(classname)};
+                readername.append("Reader");
                 auto exceptionMsg = fmt::format(
                     R"(error: Missing custom reader class name:{}, please config at your project fiile xxx.xsxproj like follow:
     <Project>
@@ -1206,56 +1505,41 @@ Node* CSLoader::nodeWithFlatBuffers(const flatbuffers::NodeTree* nodetree, const
             //        _loadingNodeParentHierarchy.emplace_back(node);
         }
 
-        // If node is invalid, there is no necessity to process children of node.
-        if (!node)
+        return node;
+    }
+}
+
+void CSLoader::addChildWithFlatBuffers(Node* node, Node* child, const ccNodeLoadCallback& callback)
+{
+    if (auto pageView = dynamic_cast<PageView*>(node))
+    {
+        Layout* layout = dynamic_cast<Layout*>(child);
+        if (layout)
         {
-            return nullptr;
+            pageView->addPage(layout);
         }
-
-        auto children = nodetree->children();
-        int size      = children->size();
-        for (int i = 0; i < size; ++i)
+    }
+    else if (auto listView = dynamic_cast<ListView*>(node))
+    {
+        Widget* widget = dynamic_cast<Widget*>(child);
+        if (widget)
         {
-            auto subNodeTree = children->Get(i);
-            Node* child      = nodeWithFlatBuffers(subNodeTree, callback);
-            if (child)
-            {
-                if (auto pageView = dynamic_cast<PageView*>(node))
-                {
-                    Layout* layout = dynamic_cast<Layout*>(child);
-                    if (layout)
-                    {
-                        pageView->addPage(layout);
-                    }
-                }
-                else if (auto listView = dynamic_cast<ListView*>(node))
-                {
-                    Widget* widget = dynamic_cast<Widget*>(child);
-                    if (widget)
-                    {
-                        listView->pushBackCustomItem(widget);
-                    }
-                }
-                else if (auto radioButtonGroup = dynamic_cast<RadioButtonGroup*>(node))
-                {
-                    radioButtonGroup->addRadioButton(dynamic_cast<RadioButton*>(child));
-                    radioButtonGroup->addChild(child);
-                }
-                else
-                {
-                    node->addChild(child);
-                }
-
-                if (callback)
-                {
-                    callback(child);
-                }
-            }
+            listView->pushBackCustomItem(widget);
         }
+    }
+    else if (auto radioButtonGroup = dynamic_cast<RadioButtonGroup*>(node))
+    {
+        radioButtonGroup->addRadioButton(dynamic_cast<RadioButton*>(child));
+        radioButtonGroup->addChild(child);
+    }
+    else
+    {
+        node->addChild(child);
+    }
 
-        //    _loadingNodeParentHierarchy.pop_back();
-
-        return node;
+    if (callback)
+    {
+        callback(child);
     }
 }
 
@@ -1434,6 +1718,7 @@ void CSLoader::registReaderObject(std::string_view className, ObjectFactory::Ins
     t._fun   = ins;
 
     ObjectFactory::getInstance()->registerType(t);
+    _nodeReaders.clear();
 }
 
 Node* CSLoader::createNodeWithFlatBuffersForSimulator(std::string_view filename)
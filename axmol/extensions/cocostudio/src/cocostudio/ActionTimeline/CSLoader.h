@@ -46,11 +46,14 @@ struct ProjectNodeOptions;
 
 struct ComponentOptions;
 struct ComAudioOptions;
+
+struct CSParseBinary;
 }  // namespace flatbuffers
 
 namespace cocostudio
 {
 class ComAudio;
+class NodeReaderProtocol;
 }
 
 namespace cocostudio
@@ -65,6 +68,8 @@ class ActionTimelineNode;
 namespace ax
 {
 
+class EventListenerCustom;
+
 typedef std::function<void(Object*)> ccNodeLoadCallback;
 
 class CCS_DLL CSLoader
@@ -84,6 +89,15 @@ public:
     static ax::Node* createNodeWithVisibleSize(std::string_view filename);
     static ax::Node* createNodeWithVisibleSize(std::string_view filename, const ccNodeLoadCallback& callback);
 
+    /**
+     * Reads the .csb file and decodes its textures off the main thread, then instantiates the node tree on the
+     * main thread a slice per frame, spending at most budget seconds each frame. callback receives the
+     * autoreleased root node, or nullptr when the file cannot be loaded.
+     */
+    static void createNodeAsync(std::string_view filename,
+                                const std::function<void(ax::Node*)>& callback,
+                                float budget = 0.004f);
+
     static cocostudio::timeline::ActionTimeline* createTimeline(std::string_view filename);
     static cocostudio::timeline::ActionTimeline* createTimeline(const Data& data, std::string_view filename);
 
@@ -114,6 +128,11 @@ public:
 
     void registReaderObject(std::string_view className, ObjectFactory::Instance ins);
 
+    /** .csb files are kept parsed per full path once read, so instantiating a layout again skips the file read.
+        The cache is dropped whenever FileUtils::purgeCachedEntries runs (memory warnings, AssetsManagerEx updates). */
+    void removePrefab(std::string_view filename);
+    void removeAllPrefabs();
+
     ax::Node* createNodeWithFlatBuffersForSimulator(std::string_view filename);
     ax::Node* nodeWithFlatBuffersForSimulator(const flatbuffers::NodeTree* nodetree);
 
@@ -121,6 +140,18 @@ protected:
     ax::Node* createNodeWithFlatBuffersFile(std::string_view filename, const ccNodeLoadCallback& callback);
     ax::Node* nodeWithFlatBuffersFile(std::string_view fileName, const ccNodeLoadCallback& callback);
     ax::Node* nodeWithFlatBuffers(const flatbuffers::NodeTree* nodetree, const ccNodeLoadCallback& callback);
+    ax::Node* nodeWithFlatBuffersNoChildren(const flatbuffers::NodeTree* nodetree, const ccNodeLoadCallback& callback);
+    void addChildWithFlatBuffers(ax::Node* node, ax::Node* child, const ccNodeLoadCallback& callback);
+    cocostudio::NodeReaderProtocol* getNodeReader(const std::string& classname);
+
+    std::shared_ptr<Data> getPrefab(std::string_view fullPath);
+    std::shared_ptr<Data> addPrefab(std::string_view fullPath, Data&& data);
+    void checkBuildId(const flatbuffers::CSParseBinary* csparsebinary);
+    void loadPrefabTextures(const flatbuffers::CSParseBinary* csparsebinary);
+
+    struct AsyncBuild;
+    void prefetchAsyncBuild(std::shared_ptr<AsyncBuild> build);
+    void stepAsyncBuild(std::shared_ptr<AsyncBuild> build);
 
     ax::Node* loadNode(const rapidjson::Value& json);
 
@@ -171,6 +202,10 @@ protected:
     ax::Vector<ax::Node*> _callbackHandlers;
 
     std::string _csBuildID;
+
+    std::unordered_map<std::string, std::shared_ptr<Data>> _prefabs;
+    ax::EventListenerCustom* _purgeListener = nullptr;
+    std::unordered_map<std::string, cocostudio::NodeReaderProtocol*> _nodeReaders;
 };
 
 }
@@ -39,6 +39,12 @@ UIPackage::UIPackage()
 
 UIPackage::~UIPackage()
 {
+    if (!_pendingAtlases.empty())
+    {
+        auto textureCache = Director::getInstance()->getTextureCache();
+        for (auto& it : _pendingAtlases)
+            textureCache->unbindImageAsync(it->file);
+    }
     for (auto& it : _items)
         it->release();
     for (auto& it : _sprites)
@@ -104,21 +110,43 @@ UIPackage* UIPackage::addPackage(const string& assetPath)
         delete emptyImage;
     }
 
-    Data data;
+    UIPackage* pkg = new UIPackage();
+    pkg->_assetPath = assetPath;
+
+    //Map the package when it lives on the real file system so items read their data in place;
+    //archives such as the apk fall back to a full read.
+    std::error_code error;
+    auto mapping = std::make_shared<mio::mmap_source>();
+    std::string fullPath = FileUtils::getInstance()->fullPathForFilename(assetPath + ".fui");
+    if (!fullPath.empty())
+        mapping->map(fullPath, error);
 
-    if (FileUtils::getInstance()->getContents(assetPath + ".fui", &data) != FileUtils::Status::OK)
+    bool loaded;
+    if (mapping->is_mapped() && !error)
     {
-        AXLOGE("FairyGUI: cannot load package from '{}'", assetPath);
-        return nullptr;
+        ByteBuffer buffer(const_cast<char*>(mapping->data()), 0, (int)mapping->size(), false);
+        buffer.setMapped(true);
+        pkg->_mapping = mapping;
+        loaded = pkg->loadPackage(&buffer);
     }
+    else
+    {
+        Data data;
 
-    ssize_t size;
-    char* p = (char*)data.takeBuffer(&size);
-    ByteBuffer buffer(p, 0, (int)size, true);
+        if (FileUtils::getInstance()->getContents(assetPath + ".fui", &data) != FileUtils::Status::OK)
+        {
+            AXLOGE("FairyGUI: cannot load package from '{}'", assetPath);
+            delete pkg;
+            return nullptr;
+        }
 
-    UIPackage* pkg = new UIPackage();
-    pkg->_assetPath = assetPath;
-    if (!pkg->loadPackage(&buffer))
+        ssize_t size;
+        char* p = (char*)data.takeBuffer(&size);
+        ByteBuffer buffer(p, 0, (int)size, true);
+        loaded = pkg->loadPackage(&buffer);
+    }
+
+    if (!loaded)
     {
         delete pkg;
         return nullptr;
@@ -132,6 +160,14 @@ UIPackage* UIPackage::addPackage(const string& assetPath)
     return pkg;
 }
 
+UIPackage* UIPackage::addPackage(const string& assetPath, const std::function<void(PackageItem*)>& onItemReady)
+{
+    UIPackage* pkg = addPackage(assetPath);
+    if (pkg)
+        pkg->loadAtlasesAsync(onItemReady);
+    return pkg;
+}
+
 void UIPackage::removePackage(const string& packageIdOrName)
 {
     UIPackage* pkg = UIPackage::getByName(packageIdOrName);
@@ -626,6 +662,11 @@ void UIPackage::loadAtlas(PackageItem* item)
     item->texture = tex;
     delete image;
 
+    loadAlphaTexture(item);
+}
+
+void UIPackage::loadAlphaTexture(PackageItem* item)
+{
     string alphaFilePath;
     string ext = FileUtils::getPathExtension(item->file);
     size_t pos = item->file.find_last_of('.');
@@ -637,7 +678,8 @@ void UIPackage::loadAtlas(PackageItem* item)
     bool hasAlphaTexture = ToolSet::isFileExist(alphaFilePath);
     if (hasAlphaTexture)
     {
-        image = new Image();
+        Texture2D* tex = item->texture;
+        Image* image = new Image();
         if (!image->initWithImageFile(alphaFilePath))
         {
             delete image;
@@ -657,6 +699,57 @@ void UIPackage::loadAtlas(PackageItem* item)
     }
 }
 
+void UIPackage::loadAtlasesAsync(const std::function<void(PackageItem*)>& onItemReady)
+{
+    auto textureCache = Director::getInstance()->getTextureCache();
+    for (auto& item : _items)
+    {
+        if (item->type != PackageItemType::ATLAS || item->texture != nullptr || _pendingAtlases.count(item))
+            continue;
+
+        //already shared through the cache, nothing to decode
+        Texture2D* cached = textureCache->getTextureForKey(item->file);
+        if (cached != nullptr)
+        {
+            item->texture = cached;
+            cached->retain();
+            loadAlphaTexture(item);
+            if (onItemReady)
+                onItemReady(item);
+            continue;
+        }
+
+        _pendingAtlases.insert(item);
+        textureCache->addImageAsync(item->file, [this, item, onItemReady](Texture2D* tex) {
+            _pendingAtlases.erase(item);
+
+            //the item may have been needed before the decode finished and loaded synchronously
+            if (item->texture == nullptr)
+            {
+                if (tex != nullptr)
+                {
+                    item->texture = tex;
+                    tex->retain();
+                    loadAlphaTexture(item);
+                }
+                else
+                {
+                    item->texture = _emptyTexture;
+                    _emptyTexture->retain();
+                    AXLOGW("FairyGUI: texture '{}' not found in {}", item->file, _name);
+                }
+            }
+
+            //the package owns its atlases, as with loadAtlas
+            if (tex != nullptr)
+                Director::getInstance()->getTextureCache()->removeTexture(tex);
+
+            if (onItemReady)
+                onItemReady(item);
+        }, item->file);
+    }
+}
+
 AtlasSprite* UIPackage::getSprite(const std::string& spriteId)
 {
     auto it = _sprites.find(spriteId);
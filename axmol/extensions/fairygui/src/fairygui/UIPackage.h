@@ -5,6 +5,8 @@
 #include "GObject.h"
 #include "PackageItem.h"
 #include "cocos2d.h"
+#include "mio/mio.hpp"
+#include <unordered_set>
 
 NS_FGUI_BEGIN
 
@@ -20,6 +22,8 @@ public:
     static UIPackage* getById(const std::string& id);
     static UIPackage* getByName(const std::string& name);
     static UIPackage* addPackage(const std::string& descFilePath);
+    //Adds the package and starts decoding its atlases in the background, see loadAtlasesAsync.
+    static UIPackage* addPackage(const std::string& descFilePath, const std::function<void(PackageItem*)>& onItemReady);
     static void removePackage(const std::string& packageIdOrName);
     static void removeAllPackages();
     static GObject* createObject(const std::string& pkgName, const std::string& resName);
@@ -37,6 +41,11 @@ public:
     PackageItem* getItem(const std::string& itemId);
     PackageItem* getItemByName(const std::string& itemName);
     void* getItemAsset(PackageItem* item);
+    //Decodes every atlas not loaded yet on the texture cache's loader thread. onItemReady runs on the
+    //main thread once per atlas as its texture is assigned; getItemAsset still loads synchronously when
+    //an atlas is needed before it is ready.
+    void loadAtlasesAsync(const std::function<void(PackageItem*)>& onItemReady = nullptr);
+    bool isLoadingAtlases() const { return !_pendingAtlases.empty(); }
 
     static const std::string& getBranch() { return _branch; }
     static void setBranch(const std::string& value);
@@ -49,6 +58,7 @@ public:
 private:
     bool loadPackage(ByteBuffer* buffer);
     void loadAtlas(PackageItem* item);
+    void loadAlphaTexture(PackageItem* item);
     AtlasSprite* getSprite(const std::string& spriteId);
     ax::SpriteFrame* createSpriteTexture(AtlasSprite* sprite);
     void loadImage(PackageItem* item);
@@ -72,6 +82,8 @@ private:
     std::vector<std::unordered_map<std::string, std::string>> _dependencies;
     std::vector<std::string> _branches;
     int _branchIndex;
+    std::shared_ptr<mio::mmap_source> _mapping;
+    std::unordered_set<PackageItem*> _pendingAtlases;
 
     static std::unordered_map<std::string, UIPackage*> _packageInstById;
     static std::unordered_map<std::string, UIPackage*> _packageInstByName;
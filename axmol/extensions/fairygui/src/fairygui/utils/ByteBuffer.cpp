@@ -10,6 +10,7 @@ ByteBuffer::ByteBuffer(char* buffer, int offset, int len, bool transferOwnerShip
       _length(len),
       _littleEndian(false),
       _ownsBuffer(transferOwnerShip),
+      _mapped(false),
       _stringTable(nullptr),
       version(0)
 {
@@ -96,7 +97,7 @@ std::string ByteBuffer::readString(int len)
     char* value = new char[len + 1];
 
     value[len] = '\0';
-    memcpy(value, _buffer + _position, len);
+    memcpy(value, _buffer + _offset + _position, len);
     _position += len;
 
     string str(value);
@@ -178,9 +179,18 @@ ax::Color4B ByteBuffer::readColor()
 ByteBuffer* ByteBuffer::readBuffer()
 {
     int count = readInt();
-    char* p = (char*)malloc(count);
-    memcpy(p, _buffer + _position, count);
-    ByteBuffer* ba = new ByteBuffer(p, 0, count, true);
+    ByteBuffer* ba;
+    if (_mapped)
+    {
+        ba = new ByteBuffer(_buffer, _offset + _position, count, false);
+        ba->_mapped = true;
+    }
+    else
+    {
+        char* p = (char*)malloc(count);
+        memcpy(p, _buffer + _offset + _position, count);
+        ba = new ByteBuffer(p, 0, count, true);
+    }
     ba->_stringTable = _stringTable;
     ba->version = version;
     _position += count;
@@ -20,6 +20,11 @@ public:
     int getBytesAvailable() const;
     int getLength() const { return _length; }
 
+    //A mapped buffer borrows memory that outlives every reader (e.g. a memory-mapped package),
+    //so readBuffer hands out views into it instead of copies.
+    bool isMapped() const { return _mapped; }
+    void setMapped(bool value) { _mapped = value; }
+
     int getPos() const { return _position; }
     void setPos(int value) { _position = value; }
     void skip(int count) { _position += count; }
@@ -54,6 +59,7 @@ private:
     int _length;
     bool _littleEndian;
     bool _ownsBuffer;
+    bool _mapped;
     int _position;
     std::vector<std::string>* _stringTable;
 };
@@ -137,16 +137,57 @@ namespace spine {
 		deltaTime *= _timeScale;
 		if (_preUpdateListener) _preUpdateListener(this);
 		_state->update(deltaTime);
+		if (isStaged()) {
+			// applied and posed on a worker by SkeletonUpdateStage before the scene is drawn
+			_stagedDelta += deltaTime;
+			_stagedApply = true;
+			return;
+		}
+		applyState(deltaTime);
+		if (_postUpdateListener) _postUpdateListener(this);
+	}
+
+	void SkeletonAnimation::applyState(float deltaTime) {
 		_state->apply(*_skeleton);
         _skeleton->update(deltaTime);
 		_skeleton->updateWorldTransform(Physics_Update);
+		_worldCoordsStaged = false;
+	}
+
+	void SkeletonAnimation::applyStagedState() {
+		// events queued by apply() are raised by the next AnimationState::update on the main thread
+		_state->disableQueue();
+		applyState(_stagedDelta);
+		_state->enableQueue();
+		_stagedDelta = 0;
+	}
+
+	bool SkeletonAnimation::hasStagedWork(unsigned int frame) const {
+		return _stagedApply || super::hasStagedWork(frame);
+	}
+
+	void SkeletonAnimation::runStagedWork(unsigned int frame) {
+		if (_stagedApply) applyStagedState();
+		// the post update listener may still move bones, leave the vertices to draw()
+		if (!_postUpdateListener) super::runStagedWork(frame);
+	}
+
+	bool SkeletonAnimation::finishStagedWork() {
+		if (!_stagedApply) return false;
+		_stagedApply = false;
 		if (_postUpdateListener) _postUpdateListener(this);
+		return true;
 	}
 
 	void SkeletonAnimation::draw(axmol::Renderer *renderer, const axmol::Mat4 &transform, uint32_t transformFlags) {
 		if (_firstDraw) {
 			_firstDraw = false;
 			update(0);
+			// the stage already ran for this frame
+			if (_stagedApply) {
+				applyStagedState();
+				finishStagedWork();
+			}
 		}
 		super::draw(renderer, transform, transformFlags);
 	}
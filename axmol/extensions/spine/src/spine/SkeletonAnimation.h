@@ -108,11 +108,21 @@ namespace spine {
 		virtual void initialize() override;
 
 	protected:
+		void applyState(float deltaTime);
+		void applyStagedState();
+
+		// --- SkeletonUpdateStage
+		bool hasStagedWork(unsigned int frame) const override;
+		void runStagedWork(unsigned int frame) override;
+		bool finishStagedWork() override;
+
 		AnimationState *_state;
 
 		bool _ownsAnimationStateData;
 		bool _updateOnlyIfVisible;
 		bool _firstDraw;
+		bool _stagedApply = false;// updated since the last SkeletonUpdateStage pass, waiting for its pose
+		float _stagedDelta = 0;
 
 		StartListener _startListener;
 		InterruptListener _interruptListener;
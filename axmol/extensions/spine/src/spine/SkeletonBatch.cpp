@@ -36,6 +36,9 @@ USING_NS_AX;
 #define EVENT_AFTER_DRAW_RESET_POSITION "director_after_draw"
 using std::max;
 #define INITIAL_SIZE (10000)
+// smallest page of the vertex and index pools
+#define VERTEX_PAGE_SIZE (8192)
+#define INDEX_PAGE_SIZE (12288)
 
 #include "renderer/backend/DriverBase.h"
 #include "renderer/Shaders.h"
@@ -57,7 +60,7 @@ namespace spine {
 		}
 	}
 
-	SkeletonBatch::SkeletonBatch() {
+	SkeletonBatch::SkeletonBatch() : _vertices(VERTEX_PAGE_SIZE), _indices(INDEX_PAGE_SIZE) {
 
 		auto program = backend::Program::getBuiltinProgram(backend::ProgramType::POSITION_TEXTURE_COLOR);
 		_programState = new backend::ProgramState(program);// new default program state
@@ -108,49 +111,24 @@ namespace spine {
 	}
 
 	axmol::V3F_C4B_T2F *SkeletonBatch::allocateVertices(uint32_t numVertices) {
-		if (_vertices.size() - _numVertices < numVertices) {
-			axmol::V3F_C4B_T2F *oldData = _vertices.data();
-			_vertices.resize((_vertices.size() + numVertices) * 2 + 1);
-			axmol::V3F_C4B_T2F *newData = _vertices.data();
-			for (uint32_t i = 0; i < this->_nextFreeCommand; i++) {
-				SkeletonCommand *command = _commandsPool[i];
-				SkeletonCommand::Triangles &triangles = (SkeletonCommand::Triangles &) command->getTriangles();
-				triangles.verts = newData + (triangles.verts - oldData);
-			}
-		}
-
-		axmol::V3F_C4B_T2F *vertices = _vertices.data() + _numVertices;
-		_numVertices += numVertices;
-		return vertices;
+		return _vertices.allocate(numVertices);
 	}
 
 	void SkeletonBatch::deallocateVertices(uint32_t numVertices) {
-		_numVertices -= numVertices;
+		_vertices.deallocate(numVertices);
 	}
 
-
 	unsigned short *SkeletonBatch::allocateIndices(uint32_t numIndices) {
-		if (_indices.getCapacity() - _indices.size() < numIndices) {
-			unsigned short *oldData = _indices.buffer();
-			int oldSize = (int)_indices.size();
-			_indices.ensureCapacity(_indices.size() + numIndices);
-			unsigned short *newData = _indices.buffer();
-			for (uint32_t i = 0; i < this->_nextFreeCommand; i++) {
-				auto command = _commandsPool[i];
-				auto &triangles = (SkeletonCommand::Triangles &) command->getTriangles();
-				if (triangles.indices >= oldData && triangles.indices < oldData + oldSize) {
-					triangles.indices = newData + (triangles.indices - oldData);
-				}
-			}
-		}
-
-		unsigned short *indices = _indices.buffer() + _indices.size();
-		_indices.setSize(_indices.size() + numIndices, 0);
-		return indices;
+		return _indices.allocate(numIndices);
 	}
 
 	void SkeletonBatch::deallocateIndices(uint32_t numIndices) {
-		_indices.setSize(_indices.size() - numIndices, 0);
+		_indices.deallocate(numIndices);
+	}
+
+	void SkeletonBatch::reserve(uint32_t numVertices, uint32_t numIndices) {
+		_vertices.reserve(numVertices);
+		_indices.reserve(numIndices);
 	}
 
 
@@ -175,8 +153,8 @@ namespace spine {
 
 	void SkeletonBatch::reset() {
 		_nextFreeCommand = 0;
-		_numVertices = 0;
-		_indices.setSize(0, 0);
+		_vertices.reset();
+		_indices.reset();
 	}
 
 	SkeletonCommand *SkeletonBatch::nextFreeCommand() {
@@ -34,6 +34,7 @@
 
 #include "renderer/backend/ProgramState.h"
 #include <spine/spine.h>
+#include <spine/SkeletonBatchArena.h>
 #include <vector>
 
 namespace spine {
@@ -53,6 +54,12 @@ namespace spine {
 		void deallocateVertices(uint32_t numVertices);
 		unsigned short *allocateIndices(uint32_t numIndices);
 		void deallocateIndices(uint32_t numVertices);
+
+		/* presizes the vertex and index pools, e.g. with the peaks of an earlier run */
+		void reserve(uint32_t numVertices, uint32_t numIndices);
+		/* most vertices and indices used by a single frame so far */
+		uint32_t getPeakVertices() const { return (uint32_t)_vertices.getPeak(); }
+		uint32_t getPeakIndices() const { return (uint32_t)_indices.getPeak(); }
 		axmol::TrianglesCommand *addCommand(axmol::Renderer *renderer, float globalOrder, axmol::Texture2D *texture, axmol::backend::ProgramState *programState, axmol::BlendFunc blendType, const axmol::TrianglesCommand::Triangles &triangles, const axmol::Mat4 &mv, uint32_t flags);
 
 		axmol::backend::ProgramState* updateCommandPipelinePS(SkeletonCommand* command, axmol::backend::ProgramState* programState);
@@ -74,11 +81,10 @@ namespace spine {
 		uint32_t _nextFreeCommand;
 
 		// pool of vertices
-		std::vector<axmol::V3F_C4B_T2F> _vertices;
-		uint32_t _numVertices;
+		SkeletonBatchArena<axmol::V3F_C4B_T2F> _vertices;
 
 		// pool of indices
-		Vector<unsigned short> _indices;
+		SkeletonBatchArena<unsigned short> _indices;
 	};
 
 }// namespace spine
@@ -0,0 +1,128 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef SPINE_SKELETONBATCHARENA_H_
+#define SPINE_SKELETONBATCHARENA_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace spine {
+
+	/* Per-frame pool of vertices or indices for the skeleton batches.
+	 *
+	 * Storage is a list of pages that are never resized, so pointers handed to queued commands stay valid for the whole
+	 * frame. An allocation that doesn't fit in the current page starts the next one. reset() recycles everything and, if
+	 * the frame spilled over the first page, merges the pages into one big enough for the whole frame, so the steady
+	 * state is a single page and only the frame that first needs more memory pays for it. */
+	template<typename T>
+	class SkeletonBatchArena {
+	public:
+		explicit SkeletonBatchArena(size_t pageSize) : _pageSize(pageSize) {
+		}
+
+		T *allocate(size_t count) {
+			if (_pages.empty() || _pages[_current].data.size() - _pages[_current].used < count) {
+				// the pages in use keep their addresses, see reset()
+				nextPage(count);
+			}
+			Page &page = _pages[_current];
+			T *items = page.data.data() + page.used;
+			page.used += count;
+			_size += count;
+			return items;
+		}
+
+		/* gives back the tail of the last allocation */
+		void deallocate(size_t count) {
+			_pages[_current].used -= count;
+			_size -= count;
+		}
+
+		void reset() {
+			_peak = std::max(_peak, _size);
+			if (_pages.size() > 1) {
+				size_t capacity = 0;
+				for (auto &page: _pages) capacity += page.data.size();
+				_pages.clear();
+				addPage(capacity);
+			}
+			if (!_pages.empty()) _pages[0].used = 0;
+			_current = 0;
+			_size = 0;
+		}
+
+		/* makes sure the first page holds at least count items, only call between frames */
+		void reserve(size_t count) {
+			if (!_pages.empty() && _pages[0].data.size() >= count) return;
+			_pages.clear();
+			addPage(count);
+			_current = 0;
+			_size = 0;
+		}
+
+		/* items allocated in the current frame */
+		size_t size() const { return _size; }
+
+		/* most items allocated in a single frame so far */
+		size_t getPeak() const { return std::max(_peak, _size); }
+
+		size_t getCapacity() const {
+			size_t capacity = 0;
+			for (auto &page: _pages) capacity += page.data.size();
+			return capacity;
+		}
+
+	private:
+		struct Page {
+			std::vector<T> data;
+			size_t used = 0;
+		};
+
+		void addPage(size_t capacity) {
+			_pages.emplace_back();
+			_pages.back().data.resize(std::max(capacity, _pageSize));
+		}
+
+		void nextPage(size_t count) {
+			addPage(count);
+			_current = _pages.size() - 1;
+		}
+
+		std::vector<Page> _pages;
+		size_t _pageSize;
+		size_t _current = 0;
+		size_t _size = 0;
+		size_t _peak = 0;
+	};
+
+}// namespace spine
+
+#endif// SPINE_SKELETONBATCHARENA_H_
@@ -227,25 +227,26 @@ namespace spine {
 			return;
 		}
 
-		const int coordCount = computeTotalCoordCount(*_skeleton, _startSlotIndex, _endSlotIndex);
+		// generated by SkeletonUpdateStage this frame if we were on screen in the last one
+		const unsigned int frame = Director::getInstance()->getTotalFrames();
+		_stageFrame = frame + 1;
+		if (!hasStagedWorldCoords(frame)) {
+			computeWorldCoords();
+		}
+
+		const int coordCount = (int)_worldCoords.size();
 		if (coordCount == 0) {
 			return;
 		}
 		assert(coordCount % 2 == 0);
 
-		VLA(float, worldCoords, coordCount);
-		transformWorldVertices(worldCoords, coordCount, *_skeleton, _startSlotIndex, _endSlotIndex);
-
 #if AX_USE_CULLING
-		const axmol::Rect bb = computeBoundingRect(worldCoords, coordCount / 2);
-
-		if (cullRectangle(renderer, transform, bb)) {
-			VLA_FREE(worldCoords);
+		if (cullRectangle(renderer, transform, _worldBounds)) {
 			return;
 		}
 #endif
 
-		const float *worldCoordPtr = worldCoords;
+		const float *worldCoordPtr = _worldCoords.data();
 		SkeletonBatch *batch = SkeletonBatch::getInstance();
 		SkeletonTwoColorBatch *twoColorBatch = SkeletonTwoColorBatch::getInstance();
 		const bool hasSingleTint = (isTwoColorTint() == false);
@@ -510,8 +511,43 @@ namespace spine {
 		if (_debugBoundingRect || _debugSlots || _debugBones || _debugMeshes) {
 			drawDebug(renderer, transform, transformFlags);
 		}
+	}
 
-		VLA_FREE(worldCoords);
+	void SkeletonRenderer::computeWorldCoords() {
+		const int coordCount = computeTotalCoordCount(*_skeleton, _startSlotIndex, _endSlotIndex);
+		_worldCoords.resize(coordCount);
+		if (coordCount == 0) {
+			return;
+		}
+		transformWorldVertices(_worldCoords.data(), coordCount, *_skeleton, _startSlotIndex, _endSlotIndex);
+#if AX_USE_CULLING
+		_worldBounds = computeBoundingRect(_worldCoords.data(), coordCount / 2);
+#endif
+	}
+
+	bool SkeletonRenderer::isStaged() const {
+		return _running && SkeletonUpdateStage::getInstance()->isEnabled();
+	}
+
+	bool SkeletonRenderer::hasStagedWorldCoords(unsigned int frame) const {
+		return _worldCoordsStaged && _worldCoordsFrame == frame;
+	}
+
+	bool SkeletonRenderer::hasStagedWork(unsigned int frame) const {
+		return _stageFrame == frame && getDisplayedOpacity() != 0;
+	}
+
+	void SkeletonRenderer::runStagedWork(unsigned int frame) {
+		if (_stageFrame != frame) {
+			return;
+		}
+		computeWorldCoords();
+		_worldCoordsFrame = frame;
+		_worldCoordsStaged = true;
+	}
+
+	bool SkeletonRenderer::finishStagedWork() {
+		return false;
 	}
 
 
@@ -629,16 +665,20 @@ namespace spine {
 
 	void SkeletonRenderer::updateWorldTransform(Physics physics) {
 		_skeleton->updateWorldTransform(physics);
+		_worldCoordsStaged = false;
 	}
 
 	void SkeletonRenderer::setToSetupPose() {
 		_skeleton->setToSetupPose();
+		_worldCoordsStaged = false;
 	}
 	void SkeletonRenderer::setBonesToSetupPose() {
 		_skeleton->setBonesToSetupPose();
+		_worldCoordsStaged = false;
 	}
 	void SkeletonRenderer::setSlotsToSetupPose() {
 		_skeleton->setSlotsToSetupPose();
+		_worldCoordsStaged = false;
 	}
 
 	Bone *SkeletonRenderer::findBone(const std::string &boneName) const {
@@ -651,9 +691,11 @@ namespace spine {
 
 	void SkeletonRenderer::setSkin(const std::string &skinName) {
 		_skeleton->setSkin(skinName.empty() ? 0 : skinName.c_str());
+		_worldCoordsStaged = false;
 	}
 	void SkeletonRenderer::setSkin(const char *skinName) {
 		_skeleton->setSkin(skinName);
+		_worldCoordsStaged = false;
 	}
 
 	Attachment *SkeletonRenderer::getAttachment(const std::string &slotName, const std::string &attachmentName) const {
@@ -662,11 +704,13 @@ namespace spine {
 	bool SkeletonRenderer::setAttachment(const std::string &slotName, const std::string &attachmentName) {
 		bool result = _skeleton->getAttachment(slotName.c_str(), attachmentName.empty() ? 0 : attachmentName.c_str()) ? true : false;
 		_skeleton->setAttachment(slotName.c_str(), attachmentName.empty() ? 0 : attachmentName.c_str());
+		_worldCoordsStaged = false;
 		return result;
 	}
 	bool SkeletonRenderer::setAttachment(const std::string &slotName, const char *attachmentName) {
 		bool result = _skeleton->getAttachment(slotName.c_str(), attachmentName) ? true : false;
 		_skeleton->setAttachment(slotName.c_str(), attachmentName);
+		_worldCoordsStaged = false;
 		return result;
 	}
 
@@ -682,6 +726,7 @@ namespace spine {
 	void SkeletonRenderer::setSlotsRange(int startSlotIndex, int endSlotIndex) {
 		_startSlotIndex = startSlotIndex == -1 ? 0 : startSlotIndex;
 		_endSlotIndex = endSlotIndex == -1 ? std::numeric_limits<int>::max() : endSlotIndex;
+		_worldCoordsStaged = false;
 	}
 
 	Skeleton *SkeletonRenderer::getSkeleton() const {
@@ -727,9 +772,12 @@ namespace spine {
 	void SkeletonRenderer::onEnter() {
 		Node::onEnter();
 		scheduleUpdate();
+		SkeletonUpdateStage::getInstance()->addRenderer(this);
 	}
 
 	void SkeletonRenderer::onExit() {
+		SkeletonUpdateStage::getInstance()->removeRenderer(this);
+		_worldCoordsStaged = false;
 		Node::onExit();
 		unscheduleUpdate();
 	}
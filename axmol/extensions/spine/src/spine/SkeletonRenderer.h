@@ -32,13 +32,17 @@
 
 #include "axmol.h"
 #include <spine/spine.h>
+#include <vector>
 
 namespace spine {
 
 	class AttachmentVertices;
+	class SkeletonUpdateStage;
 
 	/* Draws a skeleton. */
 	class SP_API SkeletonRenderer : public axmol::Node, public axmol::BlendProtocol {
+		friend class SkeletonUpdateStage;
+
 	public:
 		CREATE_FUNC(SkeletonRenderer);
 		static SkeletonRenderer *createWithSkeleton(Skeleton *skeleton, bool ownsSkeleton = false, bool ownsSkeletonData = false);
@@ -133,6 +137,16 @@ namespace spine {
 		void setupGLProgramState(bool twoColorTintEnabled);
 		virtual void drawDebug(axmol::Renderer *renderer, const axmol::Mat4 &transform, uint32_t transformFlags);
 
+		// --- SkeletonUpdateStage, runStagedWork() is called on a job system worker and the others on the main thread.
+		virtual bool hasStagedWork(unsigned int frame) const;
+		virtual void runStagedWork(unsigned int frame);
+		/* returns true if the animation state was applied by the worker */
+		virtual bool finishStagedWork();
+		bool isStaged() const;
+		bool hasStagedWorldCoords(unsigned int frame) const;
+		/* fills _worldCoords (and _worldBounds when culling) from the current pose */
+		void computeWorldCoords();
+
 		bool _ownsSkeletonData;
 		bool _ownsSkeleton;
 		bool _ownsAtlas = false;
@@ -155,6 +169,13 @@ namespace spine {
 		bool _twoColorTint;
 
         Pool<AttachmentVertices*> _verticesPool;
+
+		// world coordinates of the drawn attachments in draw order, reused across frames
+		std::vector<float> _worldCoords;
+		axmol::Rect _worldBounds;
+		unsigned int _stageFrame = 0;      // frame in which SkeletonUpdateStage should fill _worldCoords, set when drawn
+		unsigned int _worldCoordsFrame = 0;// frame SkeletonUpdateStage last filled _worldCoords for
+		bool _worldCoordsStaged = false;   // cleared whenever the pose changes after the stage ran
 	};
 
 }// namespace spine
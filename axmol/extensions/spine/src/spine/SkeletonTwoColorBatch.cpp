@@ -43,6 +43,9 @@ USING_NS_AX;
 #define EVENT_AFTER_DRAW_RESET_POSITION "director_after_draw"
 using std::max;
 #define INITIAL_SIZE (10000)
+// smallest page of the vertex and index pools
+#define VERTEX_PAGE_SIZE (8192)
+#define INDEX_PAGE_SIZE (12288)
 #define MAX_VERTICES 64000
 #define MAX_INDICES 64000
 
@@ -221,7 +224,7 @@ namespace spine {
 		}
 	}
 
-	SkeletonTwoColorBatch::SkeletonTwoColorBatch() : _vertexBuffer(0), _indexBuffer(0) {
+	SkeletonTwoColorBatch::SkeletonTwoColorBatch() : _vertices(VERTEX_PAGE_SIZE), _indices(INDEX_PAGE_SIZE), _vertexBuffer(0), _indexBuffer(0) {
 		_commandsPool.reserve(INITIAL_SIZE);
 		for (unsigned int i = 0; i < INITIAL_SIZE; i++) {
 			_commandsPool.push_back(new TwoColorTrianglesCommand());
@@ -253,50 +256,24 @@ namespace spine {
 	}
 
 	V3F_C4B_C4B_T2F *SkeletonTwoColorBatch::allocateVertices(uint32_t numVertices) {
-		if (_vertices.size() - _numVertices < numVertices) {
-			V3F_C4B_C4B_T2F *oldData = _vertices.data();
-			_vertices.resize((_vertices.size() + numVertices) * 2 + 1);
-			V3F_C4B_C4B_T2F *newData = _vertices.data();
-			for (uint32_t i = 0; i < this->_nextFreeCommand; i++) {
-				TwoColorTrianglesCommand *command = _commandsPool[i];
-				TwoColorTriangles &triangles = (TwoColorTriangles &) command->getTriangles();
-				triangles.verts = newData + (triangles.verts - oldData);
-			}
-		}
-
-		V3F_C4B_C4B_T2F *vertices = _vertices.data() + _numVertices;
-		_numVertices += numVertices;
-		return vertices;
+		return _vertices.allocate(numVertices);
 	}
 
-
 	void SkeletonTwoColorBatch::deallocateVertices(uint32_t numVertices) {
-		_numVertices -= numVertices;
+		_vertices.deallocate(numVertices);
 	}
 
-
 	unsigned short *SkeletonTwoColorBatch::allocateIndices(uint32_t numIndices) {
-		if (_indices.getCapacity() - _indices.size() < numIndices) {
-			unsigned short *oldData = _indices.buffer();
-			int oldSize = (int)_indices.size();
-			_indices.ensureCapacity(_indices.size() + numIndices);
-			unsigned short *newData = _indices.buffer();
-			for (uint32_t i = 0; i < this->_nextFreeCommand; i++) {
-				TwoColorTrianglesCommand *command = _commandsPool[i];
-				TwoColorTriangles &triangles = (TwoColorTriangles &) command->getTriangles();
-				if (triangles.indices >= oldData && triangles.indices < oldData + oldSize) {
-					triangles.indices = newData + (triangles.indices - oldData);
-				}
-			}
-		}
-
-		unsigned short *indices = _indices.buffer() + _indices.size();
-		_indices.setSize(_indices.size() + numIndices, 0);
-		return indices;
+		return _indices.allocate(numIndices);
 	}
 
 	void SkeletonTwoColorBatch::deallocateIndices(uint32_t numIndices) {
-		_indices.setSize(_indices.size() - numIndices, 0);
+		_indices.deallocate(numIndices);
+	}
+
+	void SkeletonTwoColorBatch::reserve(uint32_t numVertices, uint32_t numIndices) {
+		_vertices.reserve(numVertices);
+		_indices.reserve(numIndices);
 	}
 
 	TwoColorTrianglesCommand *SkeletonTwoColorBatch::addCommand(axmol::Renderer *renderer, float globalOrder, axmol::Texture2D *texture, backend::ProgramState *programState, axmol::BlendFunc blendType, const TwoColorTriangles &triangles, const axmol::Mat4 &mv, uint32_t flags) {
@@ -353,8 +330,8 @@ namespace spine {
 
 	void SkeletonTwoColorBatch::reset() {
 		_nextFreeCommand = 0;
-		_numVertices = 0;
-		_indices.setSize(0, 0);
+		_vertices.reset();
+		_indices.reset();
 		_numVerticesBuffer = 0;
 		_numIndicesBuffer = 0;
 		_lastCommand = nullptr;
@@ -33,6 +33,7 @@
 #include "axmol.h"
 #include "renderer/backend/ProgramState.h"
 #include <spine/spine.h>
+#include <spine/SkeletonBatchArena.h>
 #include <vector>
 
 namespace spine {
@@ -117,6 +118,12 @@ namespace spine {
 		unsigned short *allocateIndices(uint32_t numIndices);
 		void deallocateIndices(uint32_t numIndices);
 
+		/* presizes the vertex and index pools, e.g. with the peaks of an earlier run */
+		void reserve(uint32_t numVertices, uint32_t numIndices);
+		/* most vertices and indices used by a single frame so far */
+		uint32_t getPeakVertices() const { return (uint32_t)_vertices.getPeak(); }
+		uint32_t getPeakIndices() const { return (uint32_t)_indices.getPeak(); }
+
 		TwoColorTrianglesCommand *addCommand(axmol::Renderer *renderer, float globalOrder, axmol::Texture2D *texture, axmol::backend::ProgramState *programState, axmol::BlendFunc blendType, const TwoColorTriangles &triangles, const axmol::Mat4 &mv, uint32_t flags);
 
 		void batch(axmol::Renderer *renderer, TwoColorTrianglesCommand *command);
@@ -138,11 +145,10 @@ namespace spine {
 		uint32_t _nextFreeCommand;
 
 		// pool of vertices
-		std::vector<V3F_C4B_C4B_T2F> _vertices;
-		uint32_t _numVertices;
+		SkeletonBatchArena<V3F_C4B_C4B_T2F> _vertices;
 
 		// pool of indices
-		Vector<unsigned short> _indices;
+		SkeletonBatchArena<unsigned short> _indices;
 
 
 		// VBO handles & attribute locations
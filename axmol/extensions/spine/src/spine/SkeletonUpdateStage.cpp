@@ -0,0 +1,132 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/SkeletonUpdateStage.h>
+#include <spine/spine-axmol.h>
+
+#include "base/JobSystem.h"
+
+#include <algorithm>
+
+using namespace ax;
+
+namespace spine {
+
+	// Enough skeletons per range to amortize handing it to another thread
+	static constexpr size_t SKELETONS_PER_RANGE = 4;
+
+	static SkeletonUpdateStage *instance = nullptr;
+
+	SkeletonUpdateStage *SkeletonUpdateStage::getInstance() {
+		if (!instance) instance = new SkeletonUpdateStage();
+		return instance;
+	}
+
+	void SkeletonUpdateStage::destroyInstance() {
+		if (instance) {
+			delete instance;
+			instance = nullptr;
+		}
+	}
+
+	SkeletonUpdateStage::SkeletonUpdateStage() {
+	}
+
+	SkeletonUpdateStage::~SkeletonUpdateStage() {
+		setEnabled(false);
+	}
+
+	void SkeletonUpdateStage::setEnabled(bool enabled) {
+		if (enabled == isEnabled()) return;
+
+		auto dispatcher = Director::getInstance()->getEventDispatcher();
+		if (enabled) {
+			_listener = dispatcher->addCustomEventListener(Director::EVENT_BEFORE_DRAW, [this](EventCustom *) { update(); });
+			_listener->retain();
+		} else {
+			// animations updated since the last pass are still waiting for their pose
+			update();
+			dispatcher->removeEventListener(_listener);
+			AX_SAFE_RELEASE_NULL(_listener);
+		}
+	}
+
+	void SkeletonUpdateStage::addRenderer(SkeletonRenderer *renderer) {
+		if (std::find(_renderers.begin(), _renderers.end(), renderer) == _renderers.end())
+			_renderers.emplace_back(renderer);
+	}
+
+	void SkeletonUpdateStage::removeRenderer(SkeletonRenderer *renderer) {
+		auto it = std::find(_renderers.begin(), _renderers.end(), renderer);
+		if (it != _renderers.end()) {
+			*it = _renderers.back();
+			_renderers.pop_back();
+		}
+	}
+
+	void SkeletonUpdateStage::update() {
+		const auto frame = Director::getInstance()->getTotalFrames();
+
+		_jobs.clear();
+		_stats = Stats{};
+
+		for (auto renderer : _renderers) {
+			if (renderer->hasStagedWork(frame)) {
+				// post update listeners may remove the node once the workers are done
+				renderer->retain();
+				_jobs.emplace_back(renderer);
+			}
+		}
+		if (_jobs.empty()) return;
+
+		// Ranges nobody picked up run on the main thread, so a busy job system never stalls the frame
+		auto jobSystem = Director::getInstance()->getJobSystem();
+		auto body = [this, frame](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+				_jobs[i]->runStagedWork(frame);
+		};
+		if (jobSystem)
+			jobSystem->parallelFor(_jobs.size(), SKELETONS_PER_RANGE, body);
+		else
+			body(0, _jobs.size());
+
+		_stats.skeletons = static_cast<unsigned int>(_jobs.size());
+		for (auto renderer : _jobs) {
+			if (renderer->finishStagedWork()) ++_stats.posed;
+			if (renderer->hasStagedWorldCoords(frame)) {
+				++_stats.tessellated;
+				_stats.vertices += static_cast<unsigned int>(renderer->_worldCoords.size() / 2);
+			}
+		}
+		for (auto renderer : _jobs)
+			renderer->release();
+		_jobs.clear();
+	}
+
+}// namespace spine
@@ -0,0 +1,92 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef SPINE_SKELETONUPDATESTAGE_H_
+#define SPINE_SKELETONUPDATESTAGE_H_
+
+#include "axmol.h"
+#include <spine/spine.h>
+#include <vector>
+
+namespace spine {
+
+	class SkeletonRenderer;
+
+	/* Poses and tessellates every running skeleton in one pass before the scene is drawn.
+	 *
+	 * Without the stage each SkeletonAnimation applies its AnimationState and updates its world transforms in update(), and
+	 * each SkeletonRenderer computes the world vertices of its attachments in draw(), one skeleton at a time on the main
+	 * thread. Once enabled, the stage runs on Director::EVENT_BEFORE_DRAW, after all updates and actions, and spreads the
+	 * skeletons across the job system. Workers apply the animation state, step physics, update world transforms and write
+	 * the world vertices of skeletons drawn in the previous frame into per-skeleton buffers; draw() then only copies them
+	 * into SkeletonBatch commands. Skeletons that were off screen last frame compute their vertices in draw() as before.
+	 *
+	 * AnimationState::update still runs in SkeletonAnimation::update on the main thread, and so do the pre and post update
+	 * listeners. Events raised while a worker applies the state are held back and delivered by the next
+	 * AnimationState::update, one frame later than without the stage. */
+	class SP_API SkeletonUpdateStage {
+	public:
+		struct Stats {
+			unsigned int skeletons = 0;// skeletons handled by the last update
+			unsigned int posed = 0;    // of which had their animation state applied
+			unsigned int tessellated = 0;// of which had their world vertices generated
+			unsigned int vertices = 0;
+		};
+
+		static SkeletonUpdateStage *getInstance();
+
+		static void destroyInstance();
+
+		/* enable or disable the stage, disabled by default. Disabling it finishes any pending work first. */
+		void setEnabled(bool enabled);
+		bool isEnabled() const { return _listener != nullptr; }
+
+		/* SkeletonRenderers register themselves while they are running */
+		void addRenderer(SkeletonRenderer *renderer);
+		void removeRenderer(SkeletonRenderer *renderer);
+
+		/* run the stage for the current frame, called automatically while enabled */
+		void update();
+
+		/* counters of the last update() */
+		const Stats &getStats() const { return _stats; }
+
+	protected:
+		SkeletonUpdateStage();
+		virtual ~SkeletonUpdateStage();
+
+		std::vector<SkeletonRenderer *> _renderers;// weak refs
+		std::vector<SkeletonRenderer *> _jobs;
+		axmol::EventListenerCustom *_listener = nullptr;
+		Stats _stats;
+	};
+
+}// namespace spine
+
+#endif// SPINE_SKELETONUPDATESTAGE_H_
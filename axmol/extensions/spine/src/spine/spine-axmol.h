@@ -38,6 +38,7 @@
 #include <spine/SkeletonTwoColorBatch.h>
 
 #include <spine/SkeletonAnimation.h>
+#include <spine/SkeletonUpdateStage.h>
 
 #define AX_SPINE_VERSION 0x040200
 